@@ -0,0 +1,112 @@
+/**
+ * @file bench_adam.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-21
+ *
+ * Times one Adam step over the parameters of an MLP (784-256-128-10, about 235k floats), for
+ * each instruction set the cpu supports. The step is taken three ways: as the separate elementwise
+ * passes it takes with scalar loops, with one fused call per parameter tensor, and with a single
+ * fused call over every tensor.
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "magmadnn.h"
+
+using namespace magmadnn;
+
+/* median of a few repetitions of f, in microseconds */
+template <typename F>
+double time_it(F f, unsigned int reps) {
+    std::vector<double> times (reps);
+
+    for (unsigned int r = 0; r < reps; r++) {
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        f();
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::high_resolution_clock::now() - start;
+        times[r] = elapsed.count();
+    }
+    std::sort(times.begin(), times.end());
+    return times[reps / 2];
+}
+
+int main(int argc, char **argv) {
+    magmadnn_init();
+
+    const float step = 0.001f, beta1 = 0.9f, beta2 = 0.999f, epsilon = 1E-8f;
+    unsigned int reps = 200;
+    internal::vmath_isa_t isa = internal::vmath_get_isa();
+
+    std::vector<std::vector<unsigned int> > shapes = {{784, 256}, {256}, {256, 128}, {128}, {128, 10}, {10}};
+    std::vector<Tensor<float> *> vars, grads;
+    size_t total = 0;
+
+    for (unsigned int i = 0; i < shapes.size(); i++) {
+        vars.push_back(new Tensor<float> (shapes[i], {UNIFORM, {-1.0f, 1.0f}}, HOST));
+        grads.push_back(new Tensor<float> (shapes[i], {UNIFORM, {-1.0f, 1.0f}}, HOST));
+        total += vars.back()->get_size();
+    }
+
+    Tensor<float> moments ({2, (unsigned int) total}, {ZERO, {}}, HOST);
+
+    /* the moments of each tensor on its own, for the per tensor calls */
+    std::vector<Tensor<float> *> tensor_moments;
+    for (unsigned int i = 0; i < vars.size(); i++) {
+        tensor_moments.push_back(new Tensor<float> ({2, (unsigned int) vars[i]->get_size()}, {ZERO, {}}, HOST));
+    }
+
+    printf("%zu parameters in %zu tensors, %u threads\n", total, vars.size(), parallel::get_num_threads());
+
+    /* the step as elementwise operations: each pass reads and writes a whole array */
+    double unfused = time_it([&]() {
+        float *m = moments.get_ptr(), *v = m + total;
+        for (unsigned int k = 0; k < vars.size(); k++) {
+            float *x = vars[k]->get_ptr(), *g = grads[k]->get_ptr();
+            size_t n = vars[k]->get_size();
+
+            for (size_t i = 0; i < n; i++) m[i] *= beta1;
+            for (size_t i = 0; i < n; i++) m[i] += (1 - beta1) * g[i];
+            for (size_t i = 0; i < n; i++) v[i] *= beta2;
+            for (size_t i = 0; i < n; i++) v[i] += (1 - beta2) * g[i] * g[i];
+            for (size_t i = 0; i < n; i++) x[i] -= step * m[i] / (std::sqrt(v[i]) + epsilon);
+
+            m += n;
+            v += n;
+        }
+    }, reps);
+    printf("%-8s %-22s %10.1f us\n", "scalar", "elementwise passes", unfused);
+
+    for (int i = internal::VMATH_GENERIC; i <= internal::VMATH_AVX512; i++) {
+        if (!internal::vmath_set_isa((internal::vmath_isa_t) i)) continue;
+
+        double per_tensor = time_it([&]() {
+            for (unsigned int k = 0; k < vars.size(); k++) {
+                internal::adam_update_internal(std::vector<Tensor<float> *> (1, vars[k]), std::vector<Tensor<float> *> (1, grads[k]),
+                    tensor_moments[k], step, beta1, beta2, epsilon);
+            }
+        }, reps);
+
+        double fused = time_it([&]() {
+            internal::adam_update_internal(vars, grads, &moments, step, beta1, beta2, epsilon);
+        }, reps);
+
+        const char *name = internal::vmath_isa_name((internal::vmath_isa_t) i);
+        printf("%-8s %-22s %10.1f us (%.1fx)\n", name, "fused, per tensor", per_tensor, unfused / per_tensor);
+        printf("%-8s %-22s %10.1f us (%.1fx)\n", name, "fused, all tensors", fused, unfused / fused);
+    }
+    internal::vmath_set_isa(isa);
+
+    for (unsigned int i = 0; i < vars.size(); i++) {
+        delete vars[i];
+        delete grads[i];
+        delete tensor_moments[i];
+    }
+
+    magmadnn_finalize();
+    return 0;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file bench_allocator.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-13
+ *
+ * Times creating and deleting HOST tensors with the caching allocator, and with caching turned off
+ * so every tensor goes to malloc and free.
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include <cstdio>
+#include <chrono>
+#include <vector>
+#include "magmadnn.h"
+
+using namespace magmadnn;
+
+/* ns per tensor, for n_live tensors of the given shape created and deleted reps times */
+double time_tensors(std::vector<unsigned int> shape, unsigned int n_live, unsigned int reps) {
+    std::vector<Tensor<float> *> live (n_live);
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    for (unsigned int r = 0; r < reps; r++) {
+        for (unsigned int i = 0; i < n_live; i++) live[i] = new Tensor<float> (shape, {NONE, {}}, HOST);
+        for (unsigned int i = 0; i < n_live; i++) delete live[i];
+    }
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+    return elapsed.count() / (reps * n_live) * 1E9;
+}
+
+int main(int argc, char **argv) {
+    HostAllocator *alloc = get_default_host_allocator();
+    std::vector<std::vector<unsigned int> > shapes = {{1}, {32, 10}, {64, 128}, {256, 784}, {1024, 1024}, {4096, 1024}};
+
+    printf("%14s %14s %14s   (ns per tensor)\n", "elements", "malloc", "cached");
+
+    for (unsigned int s = 0; s < shapes.size(); s++) {
+        unsigned int size = 1;
+        for (unsigned int i = 0; i < shapes[s].size(); i++) size *= shapes[s][i];
+        unsigned int reps = std::max(10u, (1u << 26) / (size * 64));
+
+        alloc->release();
+        alloc->set_max_cached_bytes(0);
+        double uncached = time_tensors(shapes[s], 16, reps);
+
+        alloc->set_max_cached_bytes(HOST_ALLOCATOR_DEFAULT_MAX_CACHED);
+        time_tensors(shapes[s], 16, 1);
+        alloc->reset_stats();
+        double cached = time_tensors(shapes[s], 16, reps);
+
+        printf("%14u %14.1f %14.1f   hit rate %.3f\n", size, uncached, cached, alloc->get_stats().hit_rate);
+    }
+
+    return 0;
+}
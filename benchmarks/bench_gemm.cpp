@@ -0,0 +1,95 @@
+/**
+ * @file bench_gemm.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-08
+ *
+ * Times the int gemm against the element by element loop it replaced, and against the float
+ * gemm for reference, for square matrices.
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include <cstdio>
+#include <chrono>
+#include "magmadnn.h"
+
+using namespace magmadnn;
+
+/* the int gemm before the blocked kernel */
+void gemm_get_set(int alpha, Tensor<int> *A, Tensor<int> *B, int beta, Tensor<int> *C) {
+    int M = A->get_shape(0), K = A->get_shape(1), N = B->get_shape(1);
+
+    for (int i = 0; i < M; i++) {
+        for (int j = 0; j < N; j++) {
+            int sum = 0;
+            for (int k = 0; k < K; k++) {
+                sum = sum + alpha*(A->get({i,k}) * B->get({k,j}));
+            }
+            C->set({i,j}, sum + beta*C->get({i,j}));
+        }
+    }
+}
+
+/* best of reps runs, in GOP/s */
+template <typename F>
+double time_it(F f, unsigned int n, unsigned int reps) {
+    double best = 1E30;
+
+    for (unsigned int r = 0; r < reps; r++) {
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+        if (elapsed.count() < best) best = elapsed.count();
+    }
+    return 2.0 * n * n * n / best / 1E9;
+}
+
+int main(int argc, char **argv) {
+    unsigned int sizes[] = {64, 128, 256, 512, 1024};
+    internal::vmath_isa_t isa = internal::vmath_get_isa();
+
+    printf("%6s %10s %10s %10s %10s %10s   (GOP/s)\n", "n", "get/set", "generic", "avx2", "avx512", "float");
+
+    for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        unsigned int n = sizes[s];
+        unsigned int reps = (n <= 256) ? 5 : 2;
+        Tensor<int> A ({n,n}, {UNIFORM, {-100, 100}}, HOST);
+        Tensor<int> B ({n,n}, {UNIFORM, {-100, 100}}, HOST);
+        Tensor<int> C ({n,n}, {ZERO, {}}, HOST);
+        Tensor<int> C_ref ({n,n}, {ZERO, {}}, HOST);
+        Tensor<float> Af ({n,n}, {UNIFORM, {-1.0f, 1.0f}}, HOST);
+        Tensor<float> Bf ({n,n}, {UNIFORM, {-1.0f, 1.0f}}, HOST);
+        Tensor<float> Cf ({n,n}, {ZERO, {}}, HOST);
+
+        printf("%6u", n);
+
+        /* the old loop takes minutes past this size */
+        if (n <= 256) {
+            printf(" %10.3f", time_it([&]() { gemm_get_set(1, &A, &B, 0, &C_ref); }, n, 1));
+        } else {
+            printf(" %10s", "-");
+        }
+
+        for (int v = internal::VMATH_GENERIC; v <= internal::VMATH_AVX512; v++) {
+            if (!internal::vmath_set_isa((internal::vmath_isa_t) v)) {
+                printf(" %10s", "-");
+                continue;
+            }
+
+            printf(" %10.3f", time_it([&]() { internal::gemm_full(1, &A, &B, 0, &C); }, n, reps));
+
+            if (n <= 256) {
+                for (unsigned int i = 0; i < n*n; i++) {
+                    if (C.get(i) != C_ref.get(i)) { printf("\nresults differ at %u\n", i); return 1; }
+                }
+            }
+        }
+
+        printf(" %10.3f\n", time_it([&]() { internal::gemm_full(1.0f, &Af, &Bf, 0.0f, &Cf); }, n, reps));
+    }
+
+    internal::vmath_set_isa(isa);
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file bench_graph.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-17
+ *
+ * Times building and tearing down operation graphs, with each node on the heap (deleted through the
+ * root) and in a GraphArena (cleared all at once, reusing its chunks). The adds don't copy, so only
+ * the cost of the nodes themselves is measured.
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include <cstdio>
+#include <chrono>
+#include <vector>
+#include "magmadnn.h"
+
+using namespace magmadnn;
+
+/* builds n_chains chains of chain_len adds on x, returning their roots */
+void build(op::Operation<float> *x, unsigned int n_chains, unsigned int chain_len, std::vector<op::Operation<float> *>& roots) {
+    roots.clear();
+    for (unsigned int c = 0; c < n_chains; c++) {
+        op::Operation<float> *fin = op::var<float>("c", {1, 1}, {ZERO, {}}, HOST);
+        for (unsigned int i = 0; i < chain_len; i++) fin = op::add(x, fin, false, false);
+        roots.push_back(fin);
+    }
+}
+
+/* ns per node */
+double time_heap(op::Operation<float> *x, unsigned int n_chains, unsigned int chain_len, unsigned int reps) {
+    std::vector<op::Operation<float> *> roots;
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    for (unsigned int r = 0; r < reps; r++) {
+        build(x, n_chains, chain_len, roots);
+        for (unsigned int c = 0; c < roots.size(); c++) delete roots[c];
+    }
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+    return elapsed.count() / ((double) reps * n_chains * (chain_len + 1)) * 1E9;
+}
+
+/* ns per node */
+double time_arena(op::Operation<float> *x, unsigned int n_chains, unsigned int chain_len, unsigned int reps) {
+    std::vector<op::Operation<float> *> roots;
+    op::GraphArena arena;
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    for (unsigned int r = 0; r < reps; r++) {
+        {
+            op::GraphArenaScope scope (arena);
+            build(x, n_chains, chain_len, roots);
+        }
+        arena.clear();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+    return elapsed.count() / ((double) reps * n_chains * (chain_len + 1)) * 1E9;
+}
+
+int main(int argc, char **argv) {
+    Tensor<float> *x_tensor = new Tensor<float> ({1, 1}, {ONE, {}}, HOST);
+    std::vector<unsigned int> sizes = {100, 1000, 10000, 100000};
+
+    printf("%10s %12s %12s   (ns per node)\n", "nodes", "heap", "arena");
+
+    for (unsigned int s = 0; s < sizes.size(); s++) {
+        unsigned int chain_len = 100, n_chains = sizes[s] / chain_len;
+        unsigned int reps = std::max(3u, 2000000u / sizes[s]);
+        op::Operation<float> *x = op::var<float>("x", x_tensor);
+
+        /* x is used by every chain, so keep an owner of it around while they come and go */
+        op::Operation<float> *keep = op::add(x, x, false, false);
+
+        double heap = time_heap(x, n_chains, chain_len, reps);
+        double arena = time_arena(x, n_chains, chain_len, reps);
+
+        printf("%10u %12.1f %12.1f\n", sizes[s], heap, arena);
+        delete keep;
+    }
+
+    delete x_tensor;
+    return 0;
+}
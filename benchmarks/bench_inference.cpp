@@ -0,0 +1,87 @@
+/**
+ * @file bench_inference.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-20
+ *
+ * Times NeuralNetwork::predict and FrozenNetwork::predict on an MLP (784-256-128-10) for batch sizes
+ * 1 through 1024. The first call at each batch size builds its forward graph and is not timed.
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include <cstdio>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include "magmadnn.h"
+
+using namespace magmadnn;
+
+/* median and minimum seconds of reps calls to predict */
+template <typename N>
+static void time_predict(N *network, Tensor<float> *rows, unsigned int reps, double& median, double& min) {
+    std::vector<double> times (reps);
+
+    /* builds the graph for this batch size */
+    network->predict(rows);
+
+    for (unsigned int r = 0; r < reps; r++) {
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        network->predict(rows);
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+        times[r] = elapsed.count();
+    }
+    std::sort(times.begin(), times.end());
+
+    median = times[reps / 2];
+    min = times[0];
+}
+
+int main(int argc, char **argv) {
+    magmadnn_init();
+
+    unsigned int n_features = 784, n_classes = 10;
+    unsigned int max_batch = 1024;
+
+    /* the training graph is built for batches of 32; inference may use any batch size */
+    op::Variable<float> *x = op::var<float>("x", {32, n_features}, {ZERO, {}}, HOST);
+
+    auto input = layer::input<float>(x);
+    auto fc1 = layer::fullyconnected<float>(input->out(), 256, layer::SIGMOID);
+    auto fc2 = layer::fullyconnected<float>(fc1->out(), 128, layer::SIGMOID);
+    auto fc3 = layer::fullyconnected<float>(fc2->out(), n_classes, layer::SIGMOID);
+    auto output = layer::output<float>(fc3->out());
+
+    std::vector<layer::Layer<float> *> layers = {input, fc1, fc2, fc3, output};
+
+    model::nn_params_t p;
+    p.n_epochs = 1;
+    p.batch_size = 32;
+    model::NeuralNetwork<float> model (layers, optimizer::CROSS_ENTROPY, optimizer::SGD, p);
+
+    model::FrozenNetwork<float> *frozen = model.freeze();
+
+    Tensor<float> samples ({max_batch, n_features}, {UNIFORM, {0.0f, 1.0f}}, HOST);
+
+    printf("%8s %14s %14s %16s %14s %14s %16s\n", "batch", "median (us)", "min (us)", "samples/s",
+        "frozen median", "frozen min", "frozen samples/s");
+
+    for (unsigned int batch = 1; batch <= max_batch; batch *= 2) {
+        Tensor<float> *rows = samples.slice(0, batch);
+        unsigned int reps = std::max(10u, 20000u / batch);
+        double median, min, frozen_median, frozen_min;
+
+        time_predict(&model, rows, reps, median, min);
+        time_predict(frozen, rows, reps, frozen_median, frozen_min);
+
+        printf("%8u %14.1f %14.1f %16.0f %14.1f %14.1f %16.0f\n", batch, median * 1E6, min * 1E6, batch / median,
+            frozen_median * 1E6, frozen_min * 1E6, batch / frozen_median);
+
+        delete rows;
+    }
+
+    delete frozen;
+
+    magmadnn_finalize();
+    return 0;
+}
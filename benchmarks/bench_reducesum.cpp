@@ -0,0 +1,79 @@
+/**
+ * @file bench_reducesum.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-12
+ *
+ * Times the int row and column sums against the element by element loops they replaced, for
+ * tall, wide and square matrices.
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include <cstdio>
+#include <chrono>
+#include "magmadnn.h"
+
+using namespace magmadnn;
+
+/* the column sum before the raw pointer kernel */
+void col_get_set(Tensor<int> *x, Tensor<int> *out) {
+    unsigned int n_cols = x->get_shape(1);
+    unsigned int size = x->get_size();
+
+    for (unsigned int i = 0; i < n_cols; i++) out->set(i, 0);
+    for (unsigned int i = 0; i < size; i++) out->set(i % n_cols, out->get(i % n_cols) + x->get(i));
+}
+
+/* the row sum before the raw pointer kernel, with its index fixed */
+void row_get_set(Tensor<int> *x, Tensor<int> *out) {
+    unsigned int n_rows = x->get_shape(0);
+    unsigned int n_cols = x->get_shape(1);
+    unsigned int size = x->get_size();
+
+    for (unsigned int i = 0; i < n_rows; i++) out->set(i, 0);
+    for (unsigned int i = 0; i < size; i++) out->set(i / n_cols, out->get(i / n_cols) + x->get(i));
+}
+
+/* best of reps runs, in GB/s of input read */
+template <typename F>
+double time_it(F f, unsigned int size, unsigned int reps) {
+    double best = 1E30;
+
+    for (unsigned int r = 0; r < reps; r++) {
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+        if (elapsed.count() < best) best = elapsed.count();
+    }
+    return size * sizeof(int) / best / 1E9;
+}
+
+int main(int argc, char **argv) {
+    unsigned int shapes[][2] = {{4000, 4000}, {1000000, 16}, {16, 1000000}, {250000, 64}, {64, 250000}};
+
+    printf("%9s x %-8s %12s %12s %12s %12s   (GB/s)\n", "rows", "cols", "col get/set", "col", "row get/set", "row");
+
+    for (unsigned int s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+        unsigned int n_rows = shapes[s][0], n_cols = shapes[s][1];
+        Tensor<int> x ({n_rows, n_cols}, {UNIFORM, {-100, 100}}, HOST);
+        Tensor<int> ones_rows ({n_rows}, {ONE, {}}, HOST), ones_cols ({n_cols}, {ONE, {}}, HOST);
+        Tensor<int> col ({n_cols}, {ZERO, {}}, HOST), col_ref ({n_cols}, {ZERO, {}}, HOST);
+        Tensor<int> row ({n_rows}, {ZERO, {}}, HOST), row_ref ({n_rows}, {ZERO, {}}, HOST);
+
+        printf("%9u x %-8u", n_rows, n_cols);
+        printf(" %12.3f", time_it([&]() { col_get_set(&x, &col_ref); }, x.get_size(), 1));
+        printf(" %12.3f", time_it([&]() { internal::col_reducesum_full(&x, &ones_rows, &col); }, x.get_size(), 10));
+        printf(" %12.3f", time_it([&]() { row_get_set(&x, &row_ref); }, x.get_size(), 1));
+        printf(" %12.3f\n", time_it([&]() { internal::row_reducesum_full(&x, &ones_cols, &row); }, x.get_size(), 10));
+
+        for (unsigned int i = 0; i < n_cols; i++) {
+            if (col.get(i) != col_ref.get(i)) { printf("column sums differ at %u\n", i); return 1; }
+        }
+        for (unsigned int i = 0; i < n_rows; i++) {
+            if (row.get(i) != row_ref.get(i)) { printf("row sums differ at %u\n", i); return 1; }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file bench_vmath.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-06
+ *
+ * Times the vectorized exp, log, tanh and sigmoid against a scalar loop over the standard
+ * library functions, for each instruction set the cpu supports.
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include "magmadnn.h"
+
+using namespace magmadnn;
+
+template <typename T>
+T scalar_exp(T x) { return std::exp(x); }
+
+template <typename T>
+T scalar_log(T x) { return std::log(x); }
+
+template <typename T>
+T scalar_tanh(T x) { return std::tanh(x); }
+
+template <typename T>
+T scalar_sigmoid(T x) { return 1 / (1 + std::exp(-x)); }
+
+/* best of a few repetitions, in nanoseconds per element */
+template <typename T, typename F>
+double time_it(F f, std::vector<T>& x, std::vector<T>& out, unsigned int reps) {
+    double best = 1E30;
+
+    for (unsigned int r = 0; r < reps; r++) {
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        f(x.size(), x.data(), out.data());
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+        if (elapsed.count() < best) best = elapsed.count();
+    }
+    return best / x.size();
+}
+
+template <typename T>
+void bench(const char *type_name, const char *fn_name, T (*scalar)(T), void (*vec)(size_t, const T *, T *), T lo, T hi, unsigned int n) {
+    std::vector<T> x (n), out (n);
+    double scalar_ns, vec_ns;
+
+    for (unsigned int i = 0; i < n; i++) x[i] = lo + (hi - lo) * ((T) i / (T) n);
+
+    scalar_ns = time_it<T>([scalar](unsigned int size, const T *in, T *o) {
+        for (unsigned int i = 0; i < size; i++) o[i] = scalar(in[i]);
+    }, x, out, 10);
+
+    printf("%-7s %-8s scalar %7.3f ns", type_name, fn_name, scalar_ns);
+
+    for (int i = internal::VMATH_GENERIC; i <= internal::VMATH_AVX512; i++) {
+        if (!internal::vmath_set_isa((internal::vmath_isa_t) i)) continue;
+
+        vec_ns = time_it<T>(vec, x, out, 10);
+        printf("  %s %.3f ns (%.1fx)", internal::vmath_isa_name((internal::vmath_isa_t) i), vec_ns, scalar_ns / vec_ns);
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv) {
+    unsigned int n = 1 << 20;
+    internal::vmath_isa_t isa = internal::vmath_get_isa();
+
+    printf("%u elements, time per element\n", n);
+
+    bench<float>("float", "exp", scalar_exp<float>, internal::vexp, -80.0f, 80.0f, n);
+    bench<float>("float", "log", scalar_log<float>, internal::vlog, 1E-6f, 1E6f, n);
+    bench<float>("float", "tanh", scalar_tanh<float>, internal::vtanh, -10.0f, 10.0f, n);
+    bench<float>("float", "sigmoid", scalar_sigmoid<float>, internal::vsigmoid, -20.0f, 20.0f, n);
+
+    bench<double>("double", "exp", scalar_exp<double>, internal::vexp, -700.0, 700.0, n);
+    bench<double>("double", "log", scalar_log<double>, internal::vlog, 1E-6, 1E6, n);
+    bench<double>("double", "tanh", scalar_tanh<double>, internal::vtanh, -20.0, 20.0, n);
+    bench<double>("double", "sigmoid", scalar_sigmoid<double>, internal::vsigmoid, -40.0, 40.0, n);
+
+    internal::vmath_set_isa(isa);
+
+    return 0;
+}
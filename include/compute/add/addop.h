@@ -11,11 +11,14 @@
 #include "compute/operation.h"
 #include "tensor/tensor.h"
 #include "geadd_internal.h"
+#include "compute/broadcast/broadcast_internal.h"
+#include "compute/reducesum/reducesumop.h"
 
 namespace magmadnn {
 namespace op {
 
-/**	An addition operation on two tensors.
+/**	An addition operation on two tensors. Their shapes are broadcast against each other (see
+ *  internal::broadcast_shape), so either may be a scalar or have axes of size 1.
  * @tparam T 
  */
 template <typename T>
@@ -23,11 +26,12 @@ class AddOp : public Operation<T> {
 public:
 	AddOp(Operation<T>* a, Operation<T>* b, bool copy=true, bool needs_grad=true);
 
-	Tensor<T> *eval(bool recompute=true);
 	Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad);
 	
 	std::string to_string() { return "(" + a->to_string() + " + " + b->to_string() + ")"; }
 protected:
+	Tensor<T> *_eval(bool recompute=true);
+
 	Operation<T>* a;
 	Operation<T>* b;
 
@@ -41,7 +45,8 @@ protected:
  * @tparam T 
  * @param a 
  * @param b 
- * @param copy If copy is true then it returns a new tensor, if false then b=a+b.
+ * @param copy If copy is true then it returns a new tensor, if false then b=a+b. b must then have the
+ * 		  shape of the result.
  * @return AddOp<T>* 
  */
 template <typename T>
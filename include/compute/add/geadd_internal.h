@@ -9,6 +9,7 @@
 #pragma once
 #include "cblas.h"
 #include "tensor/tensor.h"
+#include "parallel/parallel_for.h"
 
 namespace magmadnn {
 namespace internal {
@@ -0,0 +1,90 @@
+/**
+ * @file broadcast_internal.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-18
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include "tensor/tensor.h"
+#include "parallel/parallel_for.h"
+
+namespace magmadnn {
+namespace internal {
+
+/* the most axes a broadcast can have on the device */
+#define BROADCAST_MAX_AXES 8
+
+enum broadcast_op_t {
+    BROADCAST_ADD,      /* alpha*a + beta*b */
+    BROADCAST_MUL,      /* alpha*a*b */
+    BROADCAST_DIV       /* alpha*a/b */
+};
+
+/** How a broadcast walks its operands. Axes of size 1 are dropped and neighbouring axes that both
+ *  operands walk the same way are merged, so a plain elementwise op has a single axis. An operand
+ *  has a stride of 0 along the axes it is repeated on.
+ */
+struct broadcast_plan_t {
+    size_t size;                    /* number of elements in the result */
+    std::vector<size_t> shape;      /* at least one axis */
+    std::vector<size_t> a_strides;
+    std::vector<size_t> b_strides;
+};
+
+/** The shape a and b broadcast to, as in NumPy. The shapes are lined up by their last axis and
+ *  the missing leading axes of the shorter one count as 1. Each pair of axes must be equal or have
+ *  one of size 1, which is repeated to match the other.
+ * @param a
+ * @param b
+ * @param out set to the broadcast shape
+ * @return true
+ * @return false if a and b can not be broadcast together
+ */
+bool broadcast_shape(const std::vector<unsigned int>& a, const std::vector<unsigned int>& b, std::vector<unsigned int>& out);
+
+/** The strides x is read with when it is broadcast to out_shape: 0 along the axes of out_shape x
+ *  is repeated on and x's own strides along the rest.
+ * @tparam T
+ * @param x
+ * @param out_shape must be a broadcast of x's shape
+ * @return std::vector<size_t> one stride per axis of out_shape
+ */
+template <typename T>
+std::vector<size_t> get_broadcast_strides(Tensor<T> *x, const std::vector<unsigned int>& out_shape);
+
+/** The plan for reading a and b as out_shape.
+ * @tparam T
+ * @param a
+ * @param b
+ * @param out_shape
+ * @return broadcast_plan_t
+ */
+template <typename T>
+broadcast_plan_t get_broadcast_plan(Tensor<T> *a, Tensor<T> *b, const std::vector<unsigned int>& out_shape);
+
+/** Computes out = a op b, repeating a and b along their axes of size 1 to the shape of out. Nothing
+ *  is copied to make the shapes match; the repeated operand is read with a stride of 0. a and b may
+ *  be views. out must be contiguous and may be a or b, but only if that operand is not repeated.
+ * @tparam T int, float, or double
+ * @param op
+ * @param alpha scales the result
+ * @param a
+ * @param beta scales b for BROADCAST_ADD, unused otherwise
+ * @param b
+ * @param out its shape must be the broadcast of a's and b's
+ */
+template <typename T>
+void broadcast_full(broadcast_op_t op, T alpha, Tensor<T> *a, T beta, Tensor<T> *b, Tensor<T> *out);
+
+#if defined(_HAS_CUDA_)
+template <typename T>
+void broadcast_full_device(broadcast_op_t op, T alpha, Tensor<T> *a, T beta, Tensor<T> *b, Tensor<T> *out);
+#endif
+
+}   // namespace internal
+}   // namespace magmadnn
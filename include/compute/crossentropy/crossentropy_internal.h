@@ -8,7 +8,12 @@
  */
 #pragma once
 
+#include <cmath>
+#include <vector>
+#include <algorithm>
 #include "tensor/tensor.h"
+#include "compute/vmath/vmath_internal.h"
+#include "parallel/parallel_for.h"
 
 #if defined(_HAS_CUDA_)
 #include <cuda.h>
@@ -17,15 +22,39 @@
 namespace magmadnn {
 namespace internal {
 
+/** Computes the mean cross entropy of softmax(x) and y, where the softmax is taken over each row.
+ *  Each row is done in one pass over x and y: with m the row max and s the sum of exp(x - m),
+ *  log(softmax(x)) = x - m - log(s), so the loss needs no logs of the softmax. The softmax is
+ *  stored for the backward pass. Rows are split across threads.
+ * @tparam T 
+ * @param x n_samples x n_classes logits
+ * @param y n_samples x n_classes ground truth
+ * @param softmax n_samples x n_classes, set to the row-wise softmax of x
+ * @param out scalar output
+ */
 template <typename T>
 void crossentropy_full(Tensor<T> *x, Tensor<T> *y, Tensor<T> *softmax, Tensor<T> *out);
 
+/** Computes the grad of the cross entropy wrt its logits, out = grad * (softmax - y) / n_samples,
+ *  in one pass.
+ * @tparam T 
+ * @param softmax softmax stored by crossentropy_full
+ * @param y n_samples x n_classes ground truth
+ * @param grad scalar grad wrt the loss
+ * @param out n_samples x n_classes output
+ */
+template <typename T>
+void crossentropy_grad_full(Tensor<T> *softmax, Tensor<T> *y, Tensor<T> *grad, Tensor<T> *out);
+
 
 #if defined(_HAS_CUDA_)
 template <typename T>
 void crossentropy_full_device(Tensor<T> *x, Tensor<T> *y, Tensor<T> *softmax, Tensor<T> *out);
+
+template <typename T>
+void crossentropy_grad_full_device(Tensor<T> *softmax, Tensor<T> *y, Tensor<T> *grad, Tensor<T> *out);
 #endif
 
 
 }   // namespace internal
-}   // namespace magmadnn
\ No newline at end of file
+}   // namespace magmadnn
@@ -9,21 +9,55 @@
 namespace magmadnn {
 namespace op {
 
+template <typename T>
+class CrossEntropyGradOp;
+
 template <typename T>
 class CrossEntropyOp : public Operation<T> {
 public:
 	CrossEntropyOp(Operation<T> *x, Operation<T> *y, bool copy=true, bool needs_grad=true);
 	~CrossEntropyOp();
 
-	Tensor<T> *eval(bool recompute=true);
 	Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad);
+
+	/** The row-wise softmax of x from the last evaluation, which the backward pass reads.
+	 * @return Tensor<T>* 
+	 */
+	Tensor<T> *get_softmax() { return softmax; }
 	
 	std::string to_string() { return "CrossEntropy(Softmax(" + x->to_string() + "), " + y->to_string() + ")"; }
 protected:
+	Tensor<T> *_eval(bool recompute=true);
+
 	Operation<T> *x, *y;
 	Tensor<T> *x_tensor, *y_tensor, *softmax;	/* scratch is used in the interal calc */
 
 	bool copy;
+
+	friend class CrossEntropyGradOp<T>;
+
+	Operation<T> *x_grad;		/* the gradient wrt x for x_grad_of, built once */
+	Operation<T> *x_grad_of;
+};
+
+/** Computes the grad of a CrossEntropyOp wrt its logits, grad * (softmax - y) / n_samples, from the
+ *  softmax the forward pass stored.
+ * @tparam T numeric
+ */
+template <typename T>
+class CrossEntropyGradOp : public Operation<T> {
+public:
+	CrossEntropyGradOp(CrossEntropyOp<T> *loss, Operation<T> *y, Operation<T> *grad);
+	~CrossEntropyGradOp();
+
+	Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad) { return NULL; }
+
+	std::string to_string() { return "CROSSENTROPY_GRAD( " + loss->to_string() + " )"; }
+protected:
+	Tensor<T> *_eval(bool recompute=true);
+
+	CrossEntropyOp<T> *loss;
+	Operation<T> *y, *grad_op;
 };
 
 template <typename T>
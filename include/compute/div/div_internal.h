@@ -2,6 +2,7 @@
 #pragma once
 
 #include "tensor/tensor.h"
+#include "parallel/parallel_for.h"
 
 namespace magmadnn {
 namespace internal {
@@ -11,37 +11,32 @@
 #include "compute/operation.h"
 #include "tensor/tensor.h"
 #include "compute/div/div_internal.h"
+#include "compute/product/productop.h"
+#include "compute/negative/negativeop.h"
+#include "compute/broadcast/broadcast_internal.h"
+#include "compute/reducesum/reducesumop.h"
 
 namespace magmadnn {
-
-namespace internal {
-enum div_op_t {
-	TENSOR_DIV_TENSOR,
-	SCALAR_DIV_TENSOR,
-	TENSOR_DIV_SCALAR,
-	VEC_DIV_SCALAR,
-	SCALAR_DIV_VEC
-};
-}	// namespace internal
-
 namespace op {
 
-
+/** Divides a by b elementwise. Their shapes are broadcast against each other (see
+ *  internal::broadcast_shape).
+ * @tparam T 
+ */
 template <typename T>
 class DivOp : public Operation<T> {
 public:
 	DivOp(Operation<T> *a, Operation<T> *b, bool copy, bool needs_grad);
 
-	Tensor<T> *eval(bool recompute=true);
 	Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad);
 	
 	std::string to_string() { return "( " + a->to_string() + " / " + b->to_string() + " )"; }
 protected:
+	Tensor<T> *_eval(bool recompute=true);
+
 	Operation<T> *a, *b;
 	Tensor<T> *a_tensor, *b_tensor;
 
-	internal::div_op_t op_type;
-
 	bool copy;
 };
 
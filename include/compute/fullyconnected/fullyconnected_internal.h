@@ -0,0 +1,63 @@
+/**
+ * @file fullyconnected_internal.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-10
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <algorithm>
+#include "tensor/tensor.h"
+#include "compute/matmul/gemm_internal.h"
+#include "compute/vmath/vmath_internal.h"
+#include "parallel/parallel_for.h"
+
+namespace magmadnn {
+namespace internal {
+
+/* activation applied by a fused fully connected operation */
+enum fc_activation_t {
+    FC_NONE,
+    FC_SIGMOID,
+    FC_TANH,
+    FC_RELU
+};
+
+/** Computes out = act(xW + b) in one pass. On the HOST the output is computed a block of rows at a time:
+ *  each block is set to the bias, gemm adds xW to it (beta = 1), and the activation is applied while
+ *  the block is still in cache.
+ * @tparam T 
+ * @param x n_batch x n_in input
+ * @param w n_in x n_out weights
+ * @param b 1 x n_out bias. May be NULL.
+ * @param out n_batch x n_out output
+ * @param act activation function
+ * @return magmadnn_error_t non-zero on error
+ */
+template <typename T>
+magmadnn_error_t fullyconnected_full(Tensor<T> *x, Tensor<T> *w, Tensor<T> *b, Tensor<T> *out, fc_activation_t act);
+
+/** Computes the grad of the activation, dz = grad * act'(z), from the output y = act(z) of a fused
+ *  fully connected operation. If grad has a single element it is used for every element.
+ * @tparam T 
+ * @param y output of the forward pass
+ * @param grad grad wrt y
+ * @param dz grad wrt z
+ * @param act activation function
+ * @return magmadnn_error_t non-zero on error
+ */
+template <typename T>
+magmadnn_error_t fullyconnected_grad_full(Tensor<T> *y, Tensor<T> *grad, Tensor<T> *dz, fc_activation_t act);
+
+#if defined(_HAS_CUDA_)
+template <typename T>
+void fullyconnected_full_device(Tensor<T> *x, Tensor<T> *w, Tensor<T> *b, Tensor<T> *out, fc_activation_t act);
+
+template <typename T>
+void fullyconnected_grad_full_device(Tensor<T> *y, Tensor<T> *grad, Tensor<T> *dz, fc_activation_t act);
+#endif
+
+}   // namespace internal
+}   // namespace magmadnn
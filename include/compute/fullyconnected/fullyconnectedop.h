@@ -0,0 +1,99 @@
+/**
+ * @file fullyconnectedop.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-10
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <string>
+#include "compute/operation.h"
+#include "compute/variable.h"
+#include "compute/matmul/matmulop.h"
+#include "compute/fullyconnected/fullyconnected_internal.h"
+#include "tensor/tensor.h"
+
+namespace magmadnn {
+namespace op {
+
+template <typename T>
+class FullyConnectedGradOp;
+
+/** Fused fully connected operation. Computes act(xW + b) with a single kernel, rather than a matmul,
+ *  an add and an activation that each make a pass over the output.
+ * @tparam T numeric
+ */
+template <typename T>
+class FullyConnectedOp : public Operation<T> {
+public:
+    FullyConnectedOp(Operation<T> *x, Operation<T> *w, Operation<T> *b, internal::fc_activation_t act=internal::FC_NONE, bool needs_grad=true);
+    ~FullyConnectedOp();
+
+    Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad);
+
+    std::string to_string();
+
+protected:
+    Tensor<T> *_eval(bool recompute=true);
+
+    Operation<T> *x;
+    Operation<T> *w;
+    Operation<T> *b;
+
+    Tensor<T> *x_tensor;
+    Tensor<T> *w_tensor;
+    Tensor<T> *b_tensor;
+
+    internal::fc_activation_t act;
+
+    /* grad wrt xW + b, shared by the grads of x, w and b. it lives in the gradient graph and forgets
+       itself here when that graph is destroyed. */
+    FullyConnectedGradOp<T> *act_grad;
+    Operation<T> *act_grad_of;
+
+    /* 1 x n_batch ones for the grad of b. the op owns the tensor, so each gradient graph gets a
+       variable of its own around it. */
+    Tensor<T> *ones;
+
+    friend class FullyConnectedGradOp<T>;
+};
+
+/** Computes grad * act'(z) from the output y = act(z) of a FullyConnectedOp, in one pass.
+ * @tparam T numeric
+ */
+template <typename T>
+class FullyConnectedGradOp : public Operation<T> {
+public:
+    FullyConnectedGradOp(FullyConnectedOp<T> *y, Operation<T> *grad, internal::fc_activation_t act);
+    ~FullyConnectedGradOp();
+
+    Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad) { return NULL; }
+
+    std::string to_string() { return "FC_GRAD( " + y->to_string() + ", " + grad_op->to_string() + " )"; }
+
+protected:
+    Tensor<T> *_eval(bool recompute=true);
+
+    FullyConnectedOp<T> *y;
+    Operation<T> *grad_op;
+    internal::fc_activation_t act;
+
+    friend class FullyConnectedOp<T>;
+};
+
+/** Returns a new fused fully connected operation, act(xW + b).
+ * @tparam T 
+ * @param x n_batch x n_in input
+ * @param w n_in x n_out weights
+ * @param b 1 x n_out bias, or NULL for no bias
+ * @param act activation function
+ * @param needs_grad 
+ * @return FullyConnectedOp<T>* 
+ */
+template <typename T>
+FullyConnectedOp<T> *fullyconnected(Operation<T> *x, Operation<T> *w, Operation<T> *b, internal::fc_activation_t act=internal::FC_NONE, bool needs_grad=true);
+
+}   // namespace op
+}   // namespace magmadnn
@@ -21,7 +21,8 @@
 namespace magmadnn {
 namespace op {
 
-/** Given a list of vars and compute graph, fills in a GradTable.
+/** Given a list of vars and compute graph, fills in a GradTable. If table has already been filled in
+ *  for graph, then the existing gradient operations are reused and nothing new is allocated.
  * @tparam T numeric
  * @param vars A list of variables whose gradients will be computed
  * @param graph Head node of compute graph that contains 'vars'
@@ -44,6 +44,10 @@ public:
      */
     void set(Operation<T>* var, Operation<T>* grad);
 
+    /** Removes every entry from the table. The gradient operations themselves are not freed.
+     */
+    void clear();
+
 protected:
     std::map<uintptr_t, Operation<T>* > _table;   // the underlying table to store data
     typename std::map<uintptr_t, Operation<T>* >::iterator tmp_map_iterator;
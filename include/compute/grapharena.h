@@ -0,0 +1,132 @@
+/**
+ * @file grapharena.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-17
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace magmadnn {
+namespace op {
+
+/* the size of the chunks a GraphArena takes from the system */
+const size_t GRAPH_ARENA_DEFAULT_CHUNK_SIZE = 64 << 10;
+
+/* every node is aligned to this many bytes */
+const size_t GRAPH_ARENA_ALIGNMENT = 16;
+
+/** Owns the operations created while it is current (see GraphArenaScope). Nodes are placed one after
+ *  another in large chunks, so building a graph costs a pointer bump per node and its nodes sit close
+ *  together in memory. They are all destroyed at once, newest first, by clear() or the destructor.
+ *
+ *  Nodes in an arena do not own their inputs and must never be deleted on their own; the arena is the
+ *  only owner. Operations created outside of any arena still own their inputs as before (see
+ *  Operation::~Operation). The arena must outlive any heap operation that uses its nodes. Arenas are
+ *  not thread safe; a graph is built by one thread.
+ */
+class GraphArena {
+public:
+    /**
+     * @param chunk_size bytes taken from the system at a time. Bigger nodes get a chunk of their own.
+     */
+    GraphArena(size_t chunk_size=GRAPH_ARENA_DEFAULT_CHUNK_SIZE);
+
+    /** Destroys every node and frees the chunks. */
+    ~GraphArena();
+
+    GraphArena(const GraphArena& other) = delete;
+    GraphArena& operator=(const GraphArena& other) = delete;
+
+    /** Destroys every node, newest first. The chunks are kept, so building the next graph in this
+     *  arena takes no memory from the system.
+     */
+    void clear();
+
+    /** Destroys every node and gives the chunks back to the system. */
+    void release();
+
+    /** The number of live nodes.
+     * @return unsigned int
+     */
+    unsigned int get_n_nodes() const { return nodes.size(); }
+
+    /** Bytes handed out to the live nodes, including alignment.
+     * @return size_t
+     */
+    size_t get_bytes_used() const { return bytes_used; }
+
+    /** Bytes held in chunks.
+     * @return size_t
+     */
+    size_t get_bytes_reserved() const { return bytes_reserved; }
+
+    /** The arena new operations on this thread are placed in, or NULL if they go on the heap.
+     * @return GraphArena*
+     */
+    static GraphArena *get_current();
+
+
+    /* used by Operation::operator new/delete and the Operation constructors */
+
+    /** Memory for a node of size bytes, from the current arena if there is one and the heap
+     *  otherwise.
+     */
+    static void *allocate_node(size_t size);
+
+    /** Frees memory from allocate_node. Arena memory is left alone until its arena is cleared. */
+    static void deallocate_node(void *ptr);
+
+    /** If ptr was just returned by allocate_node from an arena, the arena takes the node and is
+     *  returned, so it can destroy it later with destroy(ptr). Otherwise NULL.
+     */
+    static GraphArena *claim(void *ptr, void (*destroy)(void *));
+
+protected:
+    struct chunk_t {
+        char *data;
+        size_t size;
+    };
+
+    struct node_t {
+        void *ptr;
+        void (*destroy)(void *);
+    };
+
+    void *allocate(size_t size);
+    void destroy_nodes();
+
+    size_t chunk_size;
+    std::vector<chunk_t> chunks;
+    unsigned int cur_chunk;     /* chunk nodes are placed in */
+    size_t cur_offset;          /* first free byte of cur_chunk */
+    std::vector<node_t> nodes;  /* in order of creation */
+
+    size_t bytes_used;
+    size_t bytes_reserved;
+};
+
+/** Makes arena the current arena for this thread for the life of the scope. Every operation created
+ *  in the scope, including gradient operations, is placed in and owned by the arena. Scopes nest.
+ */
+class GraphArenaScope {
+public:
+    GraphArenaScope(GraphArena& arena);
+    ~GraphArenaScope();
+
+    GraphArenaScope(const GraphArenaScope& other) = delete;
+    GraphArenaScope& operator=(const GraphArenaScope& other) = delete;
+
+protected:
+    GraphArena *arena;
+    GraphArena *previous;
+};
+
+}   // namespace op
+}   // namespace magmadnn
@@ -0,0 +1,76 @@
+/**
+ * @file graphexecutor.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-04
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <vector>
+#include <map>
+#include "compute/operation.h"
+#include "compute/memoryplanner.h"
+#include "utilities_internal.h"
+
+namespace magmadnn {
+namespace op {
+
+/** Evaluates a compute graph in a fixed topological order. The order is computed once, when the
+ *  executor is created, and each operation is evaluated at most once per run, so nodes shared
+ *  between several outputs (i.e. the forward pass under a gradient graph) are not recomputed.
+ *
+ *  Results are memoized between runs. After changing the value of a variable, call invalidate with it
+ *  so that only the operations that depend on it are computed again by the next run. As with eval,
+ *  a non-copy operation overwrites its input, so that input should not be shared with other consumers.
+ * @tparam T numeric
+ */
+template <typename T>
+class GraphExecutor {
+public:
+    /** Schedules every operation needed to evaluate outputs.
+     * @param outputs the head nodes of the compute graph
+     * @param plan_memory if true, the intermediate outputs share memory using a MemoryPlanner. Since
+     *  a shared buffer may be overwritten by a later operation, any invalidation then invalidates the
+     *  whole graph.
+     */
+    GraphExecutor(const std::vector<Operation<T> *>& outputs, bool plan_memory=false);
+
+    virtual ~GraphExecutor();
+
+    /** Evaluates every operation in the schedule that is not yet computed.
+     * @return magmadnn_error_t non-zero on error
+     */
+    virtual magmadnn_error_t run();
+
+    /** Marks op and everything in the schedule that depends on it as stale.
+     * @param op an operation in the graph, usually a variable whose value changed
+     */
+    void invalidate(Operation<T> *op);
+
+    /** Marks every operation in the schedule as stale. */
+    void invalidate_all();
+
+    /** The order operations are evaluated in. Every operation comes after its inputs.
+     * @return const std::vector<Operation<T> *>&
+     */
+    const std::vector<Operation<T> *>& get_schedule() const { return schedule; }
+
+    /** The number of operations evaluated by the last call to run.
+     * @return unsigned int
+     */
+    unsigned int get_n_evaluated() const { return n_evaluated; }
+
+protected:
+    std::vector<Operation<T> *> outputs;
+    std::vector<Operation<T> *> schedule;
+    std::map<Operation<T> *, unsigned int> pos;
+    std::vector<std::vector<unsigned int> > consumers;    /* consumers[i] are the positions that read schedule[i] */
+
+    MemoryPlanner<T> *planner;
+    unsigned int n_evaluated;
+};
+
+}   // namespace op
+}   // namespace magmadnn
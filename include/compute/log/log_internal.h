@@ -3,6 +3,8 @@
 
 #include <cmath>
 #include "tensor/tensor.h"
+#include "parallel/parallel_for.h"
+#include "compute/vmath/vmath_internal.h"
 
 namespace magmadnn {
 namespace internal {
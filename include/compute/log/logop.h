@@ -16,11 +16,12 @@ class LogOp : public Operation<T> {
 public:
 	LogOp(Operation<T> *x, bool copy=true, bool needs_grad=true);
 
-	Tensor<T> *eval(bool recompute=true);
 	Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad);
 	
 	std::string to_string() { return "log( " + x->to_string() + " )"; }
 protected:
+	Tensor<T> *_eval(bool recompute=true);
+
 	Operation<T> *x;
 	Tensor<T> *x_tensor;
 
@@ -7,8 +7,12 @@
  * @copyright Copyright (c) 2019
  */
 #pragma once
+#include <cstdio>
+#include <climits>
+#include <algorithm>
 #include "cblas.h"
 #include "tensor/tensor.h"
+#include "compute/matmul/igemm_internal.h"
 
 #if defined(_HAS_CUDA_)
 #include "magma.h"
@@ -18,7 +22,8 @@ namespace magmadnn {
 namespace internal {
 
 /** Returns true if A, B, C are valid parameters for gemm_full. It also sets M, N, K to
- *  A.get_shape(0), B.get_shape(1), and A.get_shape(1), respectively.
+ *  the rows of op(A), the columns of op(B), and the columns of op(A), respectively, where op(X)
+ *  is X or its transpose.
  * @tparam T 
  * @param A 
  * @param B 
@@ -26,11 +31,13 @@ namespace internal {
  * @param M 
  * @param N 
  * @param K 
+ * @param trans_A use the transpose of A
+ * @param trans_B use the transpose of B
  * @return true 
  * @return false 
  */
 template <typename T>
-bool gemm_check(Tensor<T> *A, Tensor<T> *B, Tensor<T> *C, unsigned int &M, unsigned int &N, unsigned int &K);
+bool gemm_check(Tensor<T> *A, Tensor<T> *B, Tensor<T> *C, unsigned int &M, unsigned int &N, unsigned int &K, bool trans_A=false, bool trans_B=false);
 
 /** Computes the matrix product C = alpha*(AB) + beta*C
  * @tparam T 
@@ -43,6 +50,22 @@ bool gemm_check(Tensor<T> *A, Tensor<T> *B, Tensor<T> *C, unsigned int &M, unsig
 template <typename T>
 void gemm_full(T alpha, Tensor<T>* A, Tensor<T>* B, T beta, Tensor<T>* C);
 
+/** Computes the matrix product C = alpha*(op(A)op(B)) + beta*C, where op(X) is X or its transpose.
+ *  The transposes are never formed, the flags are passed on to the blas routines. A and B may be
+ *  strided views (i.e. row slices or transposes) as long as one of their strides is 1; any other view
+ *  is gathered into a contiguous copy first. C must be stored row by row.
+ * @tparam T 
+ * @param alpha 
+ * @param trans_A use the transpose of A
+ * @param A 
+ * @param trans_B use the transpose of B
+ * @param B 
+ * @param beta 
+ * @param C 
+ */
+template <typename T>
+void gemm_full(T alpha, bool trans_A, Tensor<T>* A, bool trans_B, Tensor<T>* B, T beta, Tensor<T>* C);
+
 
 }   // namespace internal
 }   // namespace magmadnn
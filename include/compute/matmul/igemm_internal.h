@@ -0,0 +1,67 @@
+/**
+ * @file igemm_internal.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-08
+ *
+ * Integer matrix multiply for HOST arrays. The matrices are split into blocks that fit in cache,
+ * the blocks are packed into contiguous panels, and each IGEMM_MR x IGEMM_NR tile of C is computed
+ * by a micro-kernel that keeps the tile in registers. The micro-kernel uses AVX-512 or AVX2 when
+ * the vmath instruction set allows it (see vmath_get_isa) and plain loops otherwise.
+ *
+ * Sums are accumulated in 32-bit ints and wrap on overflow, so every instruction set gives the
+ * exact same result.
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include "compute/vmath/vmath_internal.h"
+
+namespace magmadnn {
+namespace internal {
+
+/* register tile of C computed by one call to the micro-kernel */
+#define IGEMM_MR 6
+#define IGEMM_NR 16
+
+/* cache blocks. a KC x NR panel of B stays in L1, an MC x KC block of A in L2 */
+#define IGEMM_MC 96
+#define IGEMM_KC 256
+#define IGEMM_NC 4096
+
+/** Computes C = alpha*(op(A)op(B)) + beta*C for row-major int matrices, where op(X) is X or its
+ *  transpose. Transposed matrices are read in place.
+ * @param trans_A use the transpose of A
+ * @param trans_B use the transpose of B
+ * @param M rows of A and C
+ * @param N columns of B and C
+ * @param K columns of A and rows of B
+ * @param alpha
+ * @param A M x K matrix, or K x M if trans_A
+ * @param lda row stride of A
+ * @param B K x N matrix, or N x K if trans_B
+ * @param ldb row stride of B
+ * @param beta
+ * @param C M x N matrix
+ * @param ldc row stride of C
+ */
+void igemm(bool trans_A, bool trans_B, unsigned int M, unsigned int N, unsigned int K, int alpha,
+    const int *A, size_t lda, const int *B, size_t ldb, int beta, int *C, size_t ldc);
+
+/** Micro-kernels. They set acc to the IGEMM_MR x IGEMM_NR product of a packed IGEMM_MR x kc
+ *  panel of A (column by column) and a packed kc x IGEMM_NR panel of B (row by row).
+ * @param kc length of the panels
+ * @param a packed panel of A
+ * @param b packed panel of B
+ * @param acc row-major IGEMM_MR x IGEMM_NR output
+ */
+void igemm_kernel_generic(unsigned int kc, const int *a, const int *b, int *acc);
+void igemm_kernel_avx2(unsigned int kc, const int *a, const int *b, int *acc);
+void igemm_kernel_avx512(unsigned int kc, const int *a, const int *b, int *acc);
+
+}   // namespace internal
+}   // namespace magmadnn
@@ -10,7 +10,7 @@
 #include <vector>
 #include "compute/operation.h"
 #include "compute/variable.h"
-#include "compute/dot/dotop.h"
+#include "compute/scalarproduct/scalarproductop.h"
 #include "compute/transpose/transposeop.h"
 #include "tensor/tensor.h"
 #include "gemm_internal.h"
@@ -21,13 +21,15 @@ namespace op {
 template <typename T>
 class MatmulOp : public Operation<T> {
 public:
-	MatmulOp(T alpha, Operation<T>* a, Operation<T>* b, T beta, Operation<T> *c, bool copy=true, bool needs_grad=true);
+	MatmulOp(T alpha, Operation<T>* a, Operation<T>* b, T beta, Operation<T> *c, bool copy=true, bool needs_grad=true,
+		bool trans_a=false, bool trans_b=false);
 
-	Tensor<T>* eval(bool recompute=true);
 	Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad);
 	
-	std::string to_string() { return "(" + a->to_string() + " x " + b->to_string() + ")"; }
+	std::string to_string() { return "(" + a->to_string() + ((trans_a) ? ".T" : "") + " x " + b->to_string() + ((trans_b) ? ".T" : "") + ")"; }
 protected:
+	Tensor<T> *_eval(bool recompute=true);
+
 	Operation<T> *a;
 	Operation<T> *b;
 	Operation<T> *c;
@@ -39,6 +41,8 @@ protected:
 	T alpha;
 	T beta;
 	bool copy;
+	bool trans_a;
+	bool trans_b;
 };
 
 /** Returns a new operation of type matmul. It computes the matrix product of A and B.
@@ -51,6 +55,19 @@ protected:
 template <typename T>
 MatmulOp<T>* matmul(Operation<T> *a, Operation<T> *b, bool needs_grad=true);
 
+/** Returns a new operation of type matmul. It computes the matrix product op(A)op(B), where op(X) is X or
+ * 	its transpose. The transposes are never formed.
+ * @tparam T 
+ * @param a 
+ * @param trans_a use the transpose of a
+ * @param b 
+ * @param trans_b use the transpose of b
+ * @param needs_grad 
+ * @return MatmulOp<T>* 
+ */
+template <typename T>
+MatmulOp<T>* matmul(Operation<T> *a, bool trans_a, Operation<T> *b, bool trans_b, bool needs_grad=true);
+
 /** Computes the full gemm C = alpha*(AB) + beta*(C). Overwrites C and returns it if copy is false. If true,
  * 	then it returns a copy of C.
  * @tparam T 
@@ -0,0 +1,97 @@
+/**
+ * @file memoryplanner.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-03
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstddef>
+#include "compute/operation.h"
+#include "compute/variable.h"
+#include "memory/memorymanager.h"
+#include "utilities_internal.h"
+
+namespace magmadnn {
+namespace op {
+
+/** Plans the memory of the intermediate tensors in a compute graph. Each operation that owns its
+ *  output tensor is given a lifetime, which is the range of the evaluation order during which its
+ *  output must not be overwritten. Outputs whose lifetimes never overlap are placed at the same offset
+ *  of one shared slab, so the graph only needs as much memory as it has live at one time.
+ *
+ *  The lifetimes also cover a recursive eval(true), which re-evaluates shared inputs, so a graph
+ *  can still be evaluated in the usual way after apply(). Only HOST tensors are placed in the slab.
+ * @tparam T numeric
+ */
+template <typename T>
+class MemoryPlanner {
+public:
+    /** Plans the memory for every operation needed to evaluate outputs. The outputs themselves stay
+     *  alive until the end of the evaluation, so their values can be read afterwards.
+     * @param outputs the head nodes of the compute graph
+     */
+    MemoryPlanner(const std::vector<Operation<T> *>& outputs);
+
+    /** Gives every planned tensor its own memory again and frees the slab. The planner must be
+     *  destroyed before the operations it planned for.
+     */
+    ~MemoryPlanner();
+
+    /** Allocates the slab and points each planned tensor into it. Does nothing if the plan has
+     *  already been applied. The graph must not change after this is called.
+     * @return magmadnn_error_t non-zero on error
+     */
+    magmadnn_error_t apply();
+
+    /** The number of bytes the owned intermediate outputs take if each has its own allocation.
+     * @return size_t
+     */
+    size_t get_naive_bytes() const { return naive_bytes; }
+
+    /** The number of bytes the owned intermediate outputs take with this plan. This is the size
+     *  of the slab plus any tensors that could not be planned.
+     * @return size_t
+     */
+    size_t get_planned_bytes() const { return planned_bytes; }
+
+    /** The number of tensors placed in the slab.
+     * @return unsigned int
+     */
+    unsigned int get_n_planned() const { return buffers.size(); }
+
+    /** The order the graph was planned in. Every operation comes after its inputs.
+     * @return const std::vector<Operation<T> *>&
+     */
+    const std::vector<Operation<T> *>& get_schedule() const { return schedule; }
+
+protected:
+    /* an output tensor placed in the slab */
+    struct buffer_t {
+        Tensor<T> *tensor;
+        unsigned int first;     /* first position in schedule where the tensor is live */
+        unsigned int last;      /* last position in schedule where the tensor is live */
+        size_t size;            /* number of elements, rounded up to the alignment */
+        size_t offset;          /* offset into the slab in elements */
+    };
+
+    void plan();
+
+    std::vector<Operation<T> *> outputs;
+    std::vector<Operation<T> *> schedule;
+    std::vector<buffer_t> buffers;
+
+    MemoryManager<T> *slab;
+    size_t slab_size;
+
+    size_t naive_bytes;
+    size_t planned_bytes;
+};
+
+}   // namespace op
+}   // namespace magmadnn
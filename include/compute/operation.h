@@ -8,7 +8,9 @@
  */
 #pragma once
 #include <string>
+#include <algorithm>
 #include "tensor/tensor.h"
+#include "compute/grapharena.h"
 
 namespace magmadnn {
 namespace op {
@@ -19,19 +21,54 @@ public:
     /** The operation class serves as an abstract object, which all tensors operations descend
      *  from. It is used to build a computation tree.
      */
-    Operation() {}
+    Operation() {
+        this->arena = GraphArena::claim(this, &destroy_node);
+    }
     Operation(std::vector<Operation<T> *> inputs, bool needs_grad=true) : inputs(inputs), needs_grad(needs_grad) {
-        if (needs_grad) {
-            for (typename std::vector<Operation<T> *>::iterator vit = inputs.begin(); vit != inputs.end(); vit++) {
-                (*vit)->add_consumer(this);
-            }
+        this->arena = GraphArena::claim(this, &destroy_node);
+
+        for (typename std::vector<Operation<T> *>::iterator vit = inputs.begin(); vit != inputs.end(); vit++) {
+            if (this->arena == NULL && (*vit)->arena == NULL) (*vit)->n_owners++;
+            if (needs_grad) (*vit)->add_consumer(this);
         }
     }
+
+    /** Deletes the inputs that no other operation uses. An input shared by several operations (i.e.
+     *  a variable used twice) is deleted with the last of them, so deleting the root of a graph
+     *  frees every operation in it exactly once. Operations in a GraphArena are only owned by it.
+     */
 	virtual ~Operation() {
-        for (unsigned int i = 0; i < inputs.size(); i++)
-            delete inputs[i];
+        for (unsigned int i = 0; i < inputs.size(); i++) {
+            Operation<T> *input = inputs[i];
+
+            /* the arena destroys it, if it hasn't already */
+            if (input->arena != NULL && input->arena == this->arena) continue;
+
+            if (this->arena == NULL && input->arena == NULL && --input->n_owners == 0) {
+                delete input;
+            } else {
+                /* input lives on, so it must forget about this consumer */
+                typename std::vector<Operation<T> *>::iterator it = std::find(input->consumers.begin(), input->consumers.end(), this);
+                if (it != input->consumers.end()) input->consumers.erase(it);
+            }
+        }
+        delete gathered;
     }
 
+    /* operations are placed in the current GraphArena, if there is one */
+    static void *operator new(size_t size) { return GraphArena::allocate_node(size); }
+    static void operator delete(void *ptr) { GraphArena::deallocate_node(ptr); }
+
+    /** The arena that owns this operation, or NULL if it was created on the heap.
+     * @return GraphArena* 
+     */
+    GraphArena *get_arena() const { return this->arena; }
+
+    /** The number of heap operations that have this one as an input. They own it jointly.
+     * @return unsigned int 
+     */
+    unsigned int get_n_owners() const { return this->n_owners; }
+
     /** Returns the expected output shape of this operation.
      * @return std::vector<unsigned int> 
      */
@@ -47,10 +84,10 @@ public:
     }
 
     /** The total number of elements outputted by operation.
-     * @return unsigned int 
+     * @return size_t 
      */
-    virtual unsigned int get_output_size() const {
-        unsigned int size = 1;
+    virtual size_t get_output_size() const {
+        size_t size = 1;
         for (unsigned int i = 0; i < this->output_shape.size(); i++) size *= this->output_shape[i];
         return size;
     }
@@ -60,11 +97,53 @@ public:
      */
     virtual memory_t get_memory_type() const { return this->mem_type; }
 
-    /** Returns the operation's evaluated tensor.
-     * @param recompute
+    /** Returns the operation's evaluated tensor. If recompute is false and the operation has been
+     *  computed since it was last invalidated, then the stored result is returned without evaluating
+     *  anything again. The result is always contiguous: if the operation produced a strided view,
+     *  it is gathered into a contiguous copy.
+     * @param recompute if true, the operation and everything it depends on is evaluated again
      * @return Tensor<T>* 
      */
-    virtual Tensor<T>* eval(bool recompute=true) = 0;
+    virtual Tensor<T>* eval(bool recompute=true) {
+        Tensor<T> *out = eval_view(recompute);
+
+        if (out == NULL || out->is_contiguous()) return out;
+
+        if (!this->_gathered) {
+            if (gathered == NULL || gathered->get_shape() != out->get_shape()) {
+                delete gathered;
+                gathered = new Tensor<T> (out->get_shape(), {NONE, {}}, out->get_memory_type());
+            }
+            gathered->copy_from(*out);
+            this->_gathered = true;
+        }
+        return gathered;
+    }
+
+    /** Like eval, but the result may be a strided view (see Tensor::view). Operations whose kernels
+     *  handle strides evaluate their inputs with this to avoid the copy.
+     * @param recompute if true, the operation and everything it depends on is evaluated again
+     * @return Tensor<T>* 
+     */
+    virtual Tensor<T>* eval_view(bool recompute=true) {
+        if (!recompute && this->_computed) return this->ret;
+
+        this->ret = _eval(recompute);
+        this->_computed = true;
+        this->_gathered = false;
+        return this->ret;
+    }
+
+    /** Marks the stored result as stale, so the next eval(false) computes it again. This does not
+     *  invalidate the consumers of this operation.
+     */
+    virtual void invalidate() { this->_computed = false; }
+
+    /** Whether the operation has been computed since it was last invalidated.
+     * @return true 
+     * @return false 
+     */
+    virtual bool is_computed() const { return this->_computed; }
 
     /** Computes the gradient with respect to the outputs and var.
      * @param consumer the operation that consumes this that needs the gradient
@@ -96,14 +175,27 @@ public:
     virtual std::string to_string() = 0;
     
 protected:
+    static void destroy_node(void *ptr) { ((Operation<T> *) ptr)->~Operation(); }
+
+    /** Computes the output of this operation. Implemented by each operation.
+     * @param recompute passed on to the inputs' eval
+     * @return Tensor<T>* the result
+     */
+    virtual Tensor<T>* _eval(bool recompute=true) = 0;
+
     std::vector<Operation<T>*> inputs;
     std::vector<Operation<T>*> consumers;
     std::vector<unsigned int> output_shape;
     memory_t mem_type;
 
-    Tensor<T> *ret; /* the return tensor */
+    Tensor<T> *ret = NULL; /* the return tensor */
+    Tensor<T> *gathered = NULL; /* contiguous copy of ret, if ret is a strided view */
 
     bool needs_grad;
+    unsigned int n_owners = 0; /* heap operations that have this as an input */
+    GraphArena *arena = NULL;   /* set by the constructor */
+    bool _computed = false;
+    bool _gathered = false;
 };
 
 } // namespace op
@@ -0,0 +1,65 @@
+/**
+ * @file parallelexecutor.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-05
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <vector>
+#include <set>
+#include <memory>
+#include <atomic>
+#include "compute/operation.h"
+#include "compute/variable.h"
+#include "compute/graphexecutor.h"
+#include "parallel/threadpool.h"
+
+namespace magmadnn {
+namespace op {
+
+/** A GraphExecutor that runs independent operations at the same time. Each run counts the stale
+ *  inputs of every stale operation and submits an operation to a thread pool as soon as all of them
+ *  are computed, so independent branches (i.e. the gradients of different variables) overlap.
+ *
+ *  Each operation is still computed by the same kernel, on the same inputs, as in a serial run,
+ *  so the results are bit for bit the same. Non-copy operations write into their inputs, so they are
+ *  kept in serial order with every other operation that reads or writes the same tensor. Graphs with
+ *  operations that are not on the HOST are run serially.
+ * @tparam T numeric
+ */
+template <typename T>
+class ParallelExecutor : public GraphExecutor<T> {
+public:
+    /** Schedules every operation needed to evaluate outputs. Memory planning assumes the serial
+     *  order, so it is not available here.
+     * @param outputs the head nodes of the compute graph
+     * @param pool the pool to run on. If NULL the default pool at the time of each run is used.
+     */
+    ParallelExecutor(const std::vector<Operation<T> *>& outputs, parallel::ThreadPool *pool=NULL);
+
+    /** Evaluates every operation in the schedule that is not yet computed.
+     * @return magmadnn_error_t non-zero on error
+     */
+    virtual magmadnn_error_t run();
+
+protected:
+    void run_node(unsigned int idx, parallel::TaskGroup& group);
+
+    parallel::ThreadPool *pool;
+    parallel::ThreadPool *active_pool;  /* the pool of the current run */
+    bool host_only;
+
+    std::vector<std::vector<unsigned int> > succs;  /* operations that must wait on schedule[i] */
+    std::vector<std::vector<unsigned int> > preds;  /* operations schedule[i] waits on */
+
+    std::vector<bool> stale;
+    std::unique_ptr<std::atomic<unsigned int>[]> n_waiting;
+    std::atomic<unsigned int> n_done;
+    std::atomic<bool> failed;
+};
+
+}   // namespace op
+}   // namespace magmadnn
@@ -14,29 +14,27 @@
 #include "tensor/tensor.h"
 #include "utilities_internal.h"
 #include "compute/product/product_internal.h"
+#include "compute/broadcast/broadcast_internal.h"
+#include "compute/reducesum/reducesumop.h"
 
 namespace magmadnn {
-
-namespace internal {
-enum product_op_t {
-	SCALAR_PROD_TENSOR,
-	TENSOR_PROD_SCALAR,
-	TENSOR_PROD_TENSOR
-};
-}	// namespace internal
-
 namespace op {
 
+/** The elementwise product alpha*a*b. The shapes of a and b are broadcast against each other (see
+ *  internal::broadcast_shape).
+ * @tparam T 
+ */
 template <typename T>
 class ProductOp : public Operation<T> {
 public:
 	ProductOp(T alpha, Operation<T>* a, Operation<T>* b, bool copy=true, bool needs_grad=true);
 
-	Tensor<T> *eval(bool recompute=true);
 	Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad);
 	
 	std::string to_string() { return "(" + a->to_string() + " * " + b->to_string() + ")"; }
 protected:
+	Tensor<T> *_eval(bool recompute=true);
+
 	T alpha;
 	Operation<T> *a;
 	Operation<T> *b;
@@ -44,8 +42,6 @@ protected:
 	Tensor<T> *a_tensor;
 	Tensor<T> *b_tensor;
 
-	internal::product_op_t op_type;
-
 	bool copy;
 };
 
@@ -1,8 +1,11 @@
 
 #pragma once
 
+#include <vector>
+#include <algorithm>
 #include "tensor/tensor.h"
 #include "utilities_internal.h"
+#include "parallel/parallel_for.h"
 #include "cblas.h"
 #if defined(_HAS_CUDA_)
 #include "magma.h"
@@ -11,9 +14,47 @@
 namespace magmadnn {
 namespace internal {
 
+/* how the HOST reduction adds up each sum */
+enum reduce_sum_mode_t {
+    REDUCE_SUM_PLAIN,       /* several running sums, combined at the end. fastest */
+    REDUCE_SUM_PAIRWISE,    /* blocks of plain sums added as a binary tree. error grows with log(n) */
+    REDUCE_SUM_KAHAN        /* compensated sums. error mostly independent of n */
+};
+
+/** Sums x along one axis. out has the shape of x without that axis.
+ * @tparam T 
+ * @param x 
+ * @param axis 
+ * @param out 
+ */
 template <typename T>
 void tensor_reducesum_full(Tensor<T> *x, unsigned int axis, Tensor<T> *out);
 
+/** Sums x over a set of axes. out has the shape of x without those axes, in the same order, and
+ *  holds a single element if every axis is reduced. Adjacent axes are merged, then each reduced
+ *  axis is summed with a contiguous, vectorizable inner loop, split across threads over the kept
+ *  axes (or over the reduced axis when there is little else to split).
+ * @tparam T 
+ * @param x 
+ * @param axes the axes to sum over
+ * @param out 
+ * @param mode how each sum is accumulated
+ */
+template <typename T>
+void reducesum_axes_full(Tensor<T> *x, const std::vector<unsigned int>& axes, Tensor<T> *out, reduce_sum_mode_t mode=REDUCE_SUM_PLAIN);
+
+/** Sums the middle axis of a row-major outer x len x inner array into an outer x inner array.
+ * @tparam T 
+ * @param outer 
+ * @param len 
+ * @param inner 
+ * @param x 
+ * @param out 
+ * @param mode 
+ */
+template <typename T>
+void reducesum_host(size_t outer, size_t len, size_t inner, const T *x, T *out, reduce_sum_mode_t mode);
+
 
 #if defined(_HAS_CUDA_)
 template <typename T>
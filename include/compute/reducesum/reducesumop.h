@@ -1,8 +1,10 @@
 
 #pragma once
 
+#include <vector>
 #include "compute/operation.h"
 #include "tensor/tensor.h"
+#include "compute/scalarproduct/scalarproductop.h"
 #include "compute/reducesum/reducesum_internal.h"
 
 namespace magmadnn {
@@ -12,7 +14,7 @@ enum reduce_sum_op_t {
 	ELEM_REDUCE,
 	COL_REDUCE,
 	ROW_REDUCE,
-	TENSOR_REDUCE	/* Row Reduce for arbitrary tensors (TODO) */
+	TENSOR_REDUCE	/* any set of axes of an arbitrary tensor */
 };
 }	// namespace internal
 
@@ -23,21 +25,44 @@ class ReduceSumOp : public Operation<T> {
 public:
 	ReduceSumOp(Operation<T> *x, int axis, bool copy=true, bool needs_grad=true);
 
+	/** Sums x over a set of axes. The output has the shape of x without them.
+	 * @param x 
+	 * @param axes the axes to sum over
+	 * @param mode how the sums are accumulated on the HOST
+	 * @param copy 
+	 * @param needs_grad 
+	 */
+	ReduceSumOp(Operation<T> *x, const std::vector<unsigned int>& axes, internal::reduce_sum_mode_t mode=internal::REDUCE_SUM_PLAIN, bool copy=true, bool needs_grad=true);
+
+	/** Sums x over a set of axes and gives the result the given shape, which must have as many
+	 *  elements as the axes that are left. Used to keep axes of size 1.
+	 * @param x 
+	 * @param axes the axes to sum over
+	 * @param shape the output shape
+	 * @param mode how the sums are accumulated on the HOST
+	 * @param copy 
+	 * @param needs_grad 
+	 */
+	ReduceSumOp(Operation<T> *x, const std::vector<unsigned int>& axes, const std::vector<unsigned int>& shape, internal::reduce_sum_mode_t mode, bool copy=true, bool needs_grad=true);
+
 	virtual ~ReduceSumOp() {
 		if (ones != NULL) delete ones;
 	}
 
-	Tensor<T> *eval(bool recompute=true);
 	Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad);
 	
 	std::string to_string() { return "ReduceSum( " + x->to_string() + " )"; }
 protected:
+	Tensor<T> *_eval(bool recompute=true);
+
 	Operation<T> *x;
 	Tensor<T> *x_tensor;
 
 	Tensor<T> *ones;
 
 	int axis;
+	std::vector<unsigned int> axes;
+	internal::reduce_sum_mode_t mode;
 	bool copy;
 
 	internal::reduce_sum_op_t op_type;
@@ -46,5 +71,31 @@ protected:
 template <typename T>
 ReduceSumOp<T>* reducesum(Operation<T> *x, int axis, bool copy=true, bool needs_grad=true);
 
+/** Returns a new operation that sums x over the given axes. Pass axes as a std::vector, since a
+ *  braced list with one element picks the single axis overload.
+ * @tparam T 
+ * @param x 
+ * @param axes the axes to sum over
+ * @param mode REDUCE_SUM_PAIRWISE or REDUCE_SUM_KAHAN are more accurate for long axes
+ * @param copy 
+ * @param needs_grad 
+ * @return ReduceSumOp<T>* 
+ */
+template <typename T>
+ReduceSumOp<T>* reducesum(Operation<T> *x, const std::vector<unsigned int>& axes, internal::reduce_sum_mode_t mode=internal::REDUCE_SUM_PLAIN, bool copy=true, bool needs_grad=true);
+
+/** The gradient of an operand of the given shape that was broadcast to out_shape. grad, which
+ *  broadcasts to out_shape, is summed over the axes the operand was repeated on. Axes where grad
+ *  is itself repeated (such as a scalar grad) are not summed, only counted. The result has the
+ *  operand's shape, or one that broadcasts to it. grad is returned as is if there is nothing to sum.
+ * @tparam T 
+ * @param grad 
+ * @param shape the shape of the operand
+ * @param out_shape the shape it was broadcast to
+ * @return Operation<T>* 
+ */
+template <typename T>
+Operation<T>* reducesum_to(Operation<T> *grad, const std::vector<unsigned int>& shape, const std::vector<unsigned int>& out_shape);
+
 } // namespace op
 } // namespace magmadnn
\ No newline at end of file
@@ -1,27 +1,33 @@
 
 #pragma once
 
+#include <utility>
 #include "compute/operation.h"
 #include "tensor/tensor.h"
 #include "compute/scalarproduct/scalarproduct_internal.h"
+#include "compute/transpose/transpose_internal.h"
 
 namespace magmadnn {
 namespace op {
 
-/** Multiplies a tensor by a scalar
+/** Multiplies a tensor by a scalar. If trans_x is set, x must be a matrix and the result is the
+ *  scaled transpose of x. The transpose is written straight into the output, so it is never formed
+ *  on its own. trans_x needs copy.
  * @tparam T numeric
  */
 template <typename T>
 class ScalarProductOp : public Operation<T> {
 public:
-	ScalarProductOp(T alpha, Operation<T> *x, bool copy=true, bool needs_grad=true);
-	ScalarProductOp(Operation<T> *scalar, Operation<T> *x, bool copy=true, bool needs_grad=true);
+	ScalarProductOp(T alpha, Operation<T> *x, bool copy=true, bool needs_grad=true, bool trans_x=false);
+	ScalarProductOp(Operation<T> *scalar, Operation<T> *x, bool copy=true, bool needs_grad=true, bool trans_x=false);
 
-	Tensor<T> *eval(bool recompute=true);
 	Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad);
 	
 	std::string to_string();
 protected:
+	Tensor<T> *_eval(bool recompute=true);
+	void init();
+
 	T alpha;
 	Operation<T> *scalar;
 	Operation<T> *x;
@@ -30,13 +36,14 @@ protected:
 	Tensor<T> *scalar_tensor;
 	
 	bool copy;
+	bool trans_x;
 };
 
 template <typename T>
-ScalarProductOp<T> *scalarproduct(T alpha, Operation<T> *x, bool copy=true, bool needs_grad=true);
+ScalarProductOp<T> *scalarproduct(T alpha, Operation<T> *x, bool copy=true, bool needs_grad=true, bool trans_x=false);
 
 template <typename T>
-ScalarProductOp<T> *scalarproduct(Operation<T> *scalar, Operation<T> *x, bool copy=true, bool needs_grad=true);
+ScalarProductOp<T> *scalarproduct(Operation<T> *scalar, Operation<T> *x, bool copy=true, bool needs_grad=true, bool trans_x=false);
 
 } // namespace op
 } // namespace magmadnn
@@ -9,6 +9,8 @@
 #pragma once
 #include <math.h>
 #include "tensor/tensor.h"
+#include "parallel/parallel_for.h"
+#include "compute/vmath/vmath_internal.h"
 
 
 namespace magmadnn {
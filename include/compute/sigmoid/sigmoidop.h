@@ -27,12 +27,13 @@ class SigmoidOp : public Operation<T> {
 public:
     SigmoidOp(Operation<T> *x, bool copy=true, bool fast=true);
 
-    Tensor<T>* eval(bool recompute=true);
     Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad);
 
     std::string to_string() { return "SIGMOID( " + x->to_string() + " )"; }
 
 protected:
+    Tensor<T> *_eval(bool recompute=true);
+
     Operation<T> *x;
     Tensor<T> *x_tensor;
     
@@ -0,0 +1,56 @@
+/**
+ * @file subop.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-18
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+#include <vector>
+#include "compute/operation.h"
+#include "tensor/tensor.h"
+#include "compute/negative/negativeop.h"
+#include "compute/broadcast/broadcast_internal.h"
+#include "compute/reducesum/reducesumop.h"
+
+namespace magmadnn {
+namespace op {
+
+/**	Subtracts b from a. Their shapes are broadcast against each other (see
+ *  internal::broadcast_shape).
+ * @tparam T 
+ */
+template <typename T>
+class SubOp : public Operation<T> {
+public:
+	SubOp(Operation<T>* a, Operation<T>* b, bool copy=true, bool needs_grad=true);
+
+	Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad);
+	
+	std::string to_string() { return "(" + a->to_string() + " - " + b->to_string() + ")"; }
+protected:
+	Tensor<T> *_eval(bool recompute=true);
+
+	Operation<T>* a;
+	Operation<T>* b;
+
+	Tensor<T> *a_tensor;
+	Tensor<T> *b_tensor;
+
+	bool copy;
+};
+
+/** Returns a new subtract operation (@see SubOp<T>).
+ * @tparam T 
+ * @param a 
+ * @param b 
+ * @param copy If copy is true then it returns a new tensor, if false then b=a-b. b must then have the
+ * 		  shape of the result.
+ * @return SubOp<T>* 
+ */
+template <typename T>
+SubOp<T>* sub(Operation<T> *a, Operation<T> *b, bool copy=true, bool needs_grad=true);
+
+} // namespace op
+} // namespace magmadnn
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
 #include "tensor/tensor.h"
 
 namespace magmadnn {
@@ -23,12 +23,13 @@ class SumOp : public Operation<T> {
 public:
     SumOp(std::vector<Operation<T> *> ops, bool copy=true);
 
-    Tensor<T> *eval(bool recompute=true);
     Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad);
 
     std::string to_string();
 
 protected:
+    Tensor<T> *_eval(bool recompute=true);
+
     std::vector<Operation<T> *> ops;
     bool copy;
 };
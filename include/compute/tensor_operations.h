@@ -1,11 +1,13 @@
 #pragma once
 
 #include "add/addop.h"
+#include "sub/subop.h"
 #include "sum/sumop.h"
 
 #include "matmul/matmulop.h"
 #include "scalarproduct/scalarproductop.h"
 #include "dot/dotop.h"
+#include "fullyconnected/fullyconnectedop.h"
 
 #include "sigmoid/sigmoidop.h"
 #include "tanh/tanhop.h"
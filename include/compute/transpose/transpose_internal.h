@@ -1,18 +1,67 @@
-
+/**
+ * @file transpose_internal.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-11
+ *
+ * @copyright Copyright (c) 2019
+ */
 #pragma once
 
+#include <vector>
+#include <algorithm>
 #include "tensor/tensor.h"
+#include "parallel/parallel_for.h"
+#include "compute/vmath/vmath_internal.h"
 
 namespace magmadnn {
 namespace internal {
 
+/* side of the square blocks the HOST transpose and permute work through */
+#define TRANSPOSE_BLOCK 32
+
+/** Transposes the matrix x into out.
+ * @tparam T 
+ * @param x rows x cols matrix
+ * @param out cols x rows matrix
+ */
 template <typename T>
 void transpose_full(Tensor<T> *x, Tensor<T> *out);
 
+/** Transposes a row-major rows x cols array. The array is split into square blocks, which are
+ *  spread over threads by rows of blocks, and each block is transposed in SIMD registers when the
+ *  vmath instruction set allows it.
+ * @tparam T 
+ * @param rows 
+ * @param cols 
+ * @param x rows x cols input
+ * @param out cols x rows output. Must not overlap x.
+ */
+template <typename T>
+void transpose_host(unsigned int rows, unsigned int cols, const T *x, T *out);
+
+/** Permutes the axes of x into out, so that axis i of out is axis perm[i] of x.
+ * @tparam T 
+ * @param x input tensor
+ * @param perm a permutation of [0, x.shape.size())
+ * @param out output tensor, with shape[i] = x.shape[perm[i]]
+ */
+template <typename T>
+void permute_full(Tensor<T> *x, const std::vector<unsigned int>& perm, Tensor<T> *out);
+
+#if defined(MAGMADNN_VMATH_X86)
+/* in-register transposes of an 8x8 block of 32-bit and a 4x4 block of 64-bit values. the leading
+   dimensions are in elements. */
+void transpose_tile_32_avx2(const void *x, unsigned int ld_x, void *out, unsigned int ld_out);
+void transpose_tile_64_avx2(const void *x, unsigned int ld_x, void *out, unsigned int ld_out);
+#endif
 
 #if defined(_HAS_CUDA_)
 template <typename T>
 void transpose_full_device(Tensor<T> *x, Tensor<T> *out);
+
+template <typename T>
+void permute_full_device(Tensor<T> *x, const std::vector<unsigned int>& perm, Tensor<T> *out);
 #endif
 
 
@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <vector>
 #include "compute/operation.h"
 #include "tensor/tensor.h"
 #include "utilities_internal.h"
@@ -12,21 +13,51 @@ namespace op {
 template <typename T>
 class TransposeOp : public Operation<T> {
 public:
+	/** Transposes the matrix x. If copy is false the output is a strided view of x's tensor,
+	 *  which costs O(1). Consumers that can't take strides get a contiguous copy from eval.
+	 * @param x 
+	 * @param copy 
+	 * @param needs_grad 
+	 */
 	TransposeOp(Operation<T> *x, bool copy=true, bool needs_grad=true);
 
-	Tensor<T> *eval(bool recompute=true);
+	/** Permutes the axes of x, so that axis i of the output is axis perm[i] of x.
+	 * @param x 
+	 * @param perm a permutation of the axes of x
+	 * @param copy if false the output is a strided view of x's tensor
+	 * @param needs_grad 
+	 */
+	TransposeOp(Operation<T> *x, const std::vector<unsigned int>& perm, bool copy=true, bool needs_grad=true);
+	~TransposeOp();
+
 	Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad);
 	
-	std::string to_string() { return x->to_string() + ".T"; }
+	std::string to_string();
 protected:
+	Tensor<T> *_eval(bool recompute=true);
+
 	Operation<T> *x;
 	Tensor<T> *x_tensor;
 
+	std::vector<unsigned int> perm;
 	bool copy;
+
+	Tensor<T> *view_of;	/* the tensor ret is a view of, if copy is false */
 };
 
 template <typename T>
 TransposeOp<T>* transpose(Operation<T> *x, bool copy=true, bool needs_grad=true);
 
+/** Returns a new operation that permutes the axes of x. Axis i of the output is axis perm[i] of x.
+ * @tparam T 
+ * @param x 
+ * @param perm a permutation of the axes of x
+ * @param copy 
+ * @param needs_grad 
+ * @return TransposeOp<T>* 
+ */
+template <typename T>
+TransposeOp<T>* transpose(Operation<T> *x, const std::vector<unsigned int>& perm, bool copy=true, bool needs_grad=true);
+
 } // namespace op
 } // namespace magmadnn
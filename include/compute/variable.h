@@ -24,13 +24,14 @@ public:
     Variable (std::string name, Tensor<T> *val);
     ~Variable();
 
-    Tensor<T>* eval(bool recompute=true);
     Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad);
 
     std::string to_string() { return name; }
     std::string get_name() { return name; }
 
 protected:
+    Tensor<T> *_eval(bool recompute=true);
+
     std::string name;
     Tensor<T> *val;
     bool delete_tensor;
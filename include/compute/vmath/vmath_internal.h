@@ -0,0 +1,120 @@
+/**
+ * @file vmath_internal.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-07
+ *
+ * Vectorized elementwise math for HOST arrays, and the fused Adam update. The float and double versions use AVX-512 or AVX2
+ * if the CPU supports them and a portable version of the same algorithms otherwise. The instruction
+ * set is chosen the first time one of them is called.
+ *
+ * Max error, measured against a long double reference over the normal range:
+ *      exp         2 ulp       (results in the subnormal range may lose precision)
+ *      log         1 ulp
+ *      tanh        2 ulp
+ *      sigmoid     4 ulp
+ * The portable versions meet the same bounds. Inf and nan are handled like the standard library.
+ * Other types use the standard library.
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <cmath>
+#include "compute/vmath/vmath_kernels.h"
+
+namespace magmadnn {
+namespace internal {
+
+enum vmath_isa_t {
+    VMATH_GENERIC,
+    VMATH_AVX2,
+    VMATH_AVX512
+};
+
+/** Whether the CPU can run the given instruction set.
+ * @param isa
+ * @return true
+ * @return false
+ */
+bool vmath_isa_supported(vmath_isa_t isa);
+
+/** The instruction set the vmath functions are using.
+ * @return vmath_isa_t
+ */
+vmath_isa_t vmath_get_isa();
+
+/** Changes the instruction set the vmath functions use. Mostly for testing and benchmarking.
+ * @param isa
+ * @return true if the CPU supports isa and it was set
+ * @return false otherwise
+ */
+bool vmath_set_isa(vmath_isa_t isa);
+
+/** Readable name of an instruction set.
+ * @param isa
+ * @return const char*
+ */
+const char *vmath_isa_name(vmath_isa_t isa);
+
+/** out[i] = exp(x[i]) for i in [0,n). x and out may be the same array.
+ * @param n number of elements
+ * @param x input
+ * @param out output
+ */
+void vexp(size_t n, const float *x, float *out);
+void vexp(size_t n, const double *x, double *out);
+
+/** out[i] = log(x[i]) for i in [0,n). x and out may be the same array. */
+void vlog(size_t n, const float *x, float *out);
+void vlog(size_t n, const double *x, double *out);
+
+/** out[i] = tanh(x[i]) for i in [0,n). x and out may be the same array. */
+void vtanh(size_t n, const float *x, float *out);
+void vtanh(size_t n, const double *x, double *out);
+
+/** out[i] = 1 / (1 + exp(-x[i])) for i in [0,n). x and out may be the same array. */
+void vsigmoid(size_t n, const float *x, float *out);
+void vsigmoid(size_t n, const double *x, double *out);
+
+/** One Adam step, fused: for i in [0,n)
+ *      m[i] = beta1 m[i] + (1-beta1) grad[i]
+ *      v[i] = beta2 v[i] + (1-beta2) grad[i]^2
+ *      var[i] -= step m[i] / (sqrt(v[i]) + epsilon)
+ * @param n number of elements
+ * @param var parameters, updated in place
+ * @param grad gradient of the parameters
+ * @param m first moment, updated in place
+ * @param v second moment, updated in place
+ * @param step learning rate, with the bias correction of this step folded in
+ * @param beta1 decay of the first moment
+ * @param beta2 decay of the second moment
+ * @param epsilon added to the denominator
+ */
+void vadam(size_t n, float *var, const float *grad, float *m, float *v, float step, float beta1, float beta2, float epsilon);
+void vadam(size_t n, double *var, const double *grad, double *m, double *v, double step, double beta1, double beta2, double epsilon);
+
+/* other types are computed element by element */
+template <typename T>
+void vexp(size_t n, const T *x, T *out) { for (size_t i = 0; i < n; i++) out[i] = exp(x[i]); }
+
+template <typename T>
+void vlog(size_t n, const T *x, T *out) { for (size_t i = 0; i < n; i++) out[i] = log(x[i]); }
+
+template <typename T>
+void vtanh(size_t n, const T *x, T *out) { for (size_t i = 0; i < n; i++) out[i] = tanh(x[i]); }
+
+template <typename T>
+void vsigmoid(size_t n, const T *x, T *out) { for (size_t i = 0; i < n; i++) out[i] = 1 / (1 + exp(-x[i])); }
+
+template <typename T>
+void vadam(size_t n, T *var, const T *grad, T *m, T *v, T step, T beta1, T beta2, T epsilon) {
+    for (size_t i = 0; i < n; i++) {
+        m[i] = beta1 * m[i] + (1 - beta1) * grad[i];
+        v[i] = beta2 * v[i] + (1 - beta2) * grad[i] * grad[i];
+        var[i] -= step * m[i] / (sqrt(v[i]) + epsilon);
+    }
+}
+
+}   // namespace internal
+}   // namespace magmadnn
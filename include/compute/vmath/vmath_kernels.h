@@ -0,0 +1,384 @@
+/**
+ * @file vmath_kernels.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-07
+ *
+ * Vectorized exp, log, tanh and sigmoid. The algorithms are written once against a small set of
+ * vector primitives, V, which each instruction set provides. This header is included by translation
+ * units compiled for different targets, so it must not include anything that has out of line code
+ * (i.e. the standard library). The freestanding <stddef.h> only has types, so it is fine.
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <stddef.h>
+
+#if (defined(__GNUC__) && !defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MAGMADNN_VMATH_X86
+#endif
+
+namespace magmadnn {
+namespace internal {
+namespace vmath {
+
+/* each instruction set defines these for float and double */
+#if defined(MAGMADNN_VMATH_X86)
+void exp_avx2(size_t n, const float *x, float *out);
+void exp_avx2(size_t n, const double *x, double *out);
+void log_avx2(size_t n, const float *x, float *out);
+void log_avx2(size_t n, const double *x, double *out);
+void tanh_avx2(size_t n, const float *x, float *out);
+void tanh_avx2(size_t n, const double *x, double *out);
+void sigmoid_avx2(size_t n, const float *x, float *out);
+void sigmoid_avx2(size_t n, const double *x, double *out);
+void adam_avx2(size_t n, float *var, const float *grad, float *m, float *v, float step, float beta1, float beta2, float epsilon);
+void adam_avx2(size_t n, double *var, const double *grad, double *m, double *v, double step, double beta1, double beta2, double epsilon);
+
+void exp_avx512(size_t n, const float *x, float *out);
+void exp_avx512(size_t n, const double *x, double *out);
+void log_avx512(size_t n, const float *x, float *out);
+void log_avx512(size_t n, const double *x, double *out);
+void tanh_avx512(size_t n, const float *x, float *out);
+void tanh_avx512(size_t n, const double *x, double *out);
+void sigmoid_avx512(size_t n, const float *x, float *out);
+void sigmoid_avx512(size_t n, const double *x, double *out);
+void adam_avx512(size_t n, float *var, const float *grad, float *m, float *v, float step, float beta1, float beta2, float epsilon);
+void adam_avx512(size_t n, double *var, const double *grad, double *m, double *v, double step, double beta1, double beta2, double epsilon);
+#endif
+
+/*  V must provide
+ *      scalar, reg, mask, width
+ *      set1, load, store, load_aligned, store_aligned (to sizeof(reg)), add, sub, mul, div, sqrt, fma (a*b+c), min, max, abs, round (to nearest)
+ *      lt, gt, eq, isnan (returning mask), select (mask ? a : b), copysign (|a| with the sign of b)
+ *      pow2 (2^n for an integral n in the normal exponent range)
+ *      frexp (m in [0.5,1) and e with x = m*2^e, for positive normal x)
+ *
+ *  The constants below are from the Cephes math library (S. L. Moshier).
+ */
+
+/* exp(x) for float. max error 2 ulp over the normal range. */
+template <typename V>
+inline typename V::reg exp_ps(typename V::reg x) {
+    typedef typename V::reg reg;
+
+    const reg hi = V::set1(88.72283935546875f);
+    const reg lo = V::set1(-103.972084045410f);
+    reg n, r, r2, p, half;
+
+    reg xc = V::min(V::max(x, lo), hi);
+
+    n = V::round(V::mul(xc, V::set1(1.44269504088896341f)));
+    r = V::fma(n, V::set1(-0.693359375f), xc);
+    r = V::fma(n, V::set1(2.12194440e-4f), r);
+
+    r2 = V::mul(r, r);
+    p = V::set1(1.9875691500E-4f);
+    p = V::fma(p, r, V::set1(1.3981999507E-3f));
+    p = V::fma(p, r, V::set1(8.3334519073E-3f));
+    p = V::fma(p, r, V::set1(4.1665795894E-2f));
+    p = V::fma(p, r, V::set1(1.6666665459E-1f));
+    p = V::fma(p, r, V::set1(5.0000001201E-1f));
+    p = V::fma(p, r2, V::add(r, V::set1(1.0f)));
+
+    /* scale in two steps so results near overflow and in the subnormal range are exact powers */
+    half = V::round(V::mul(n, V::set1(0.5f)));
+    p = V::mul(V::mul(p, V::pow2(half)), V::pow2(V::sub(n, half)));
+
+    p = V::select(V::gt(x, hi), V::set1(__builtin_inff()), p);
+    p = V::select(V::lt(x, lo), V::set1(0.0f), p);
+    return V::select(V::isnan(x), x, p);
+}
+
+/* exp(x) for double. max error 2 ulp over the normal range. */
+template <typename V>
+inline typename V::reg exp_pd(typename V::reg x) {
+    typedef typename V::reg reg;
+
+    const reg hi = V::set1(709.782712893383973096);
+    const reg lo = V::set1(-745.133219101941108420);
+    reg n, r, r2, px, qx, p, half;
+
+    reg xc = V::min(V::max(x, lo), hi);
+
+    n = V::round(V::mul(xc, V::set1(1.4426950408889634073599)));
+    r = V::fma(n, V::set1(-6.93145751953125E-1), xc);
+    r = V::fma(n, V::set1(-1.42860682030941723212E-6), r);
+
+    /* exp(r) = 1 + 2 r P(r^2) / (Q(r^2) - r P(r^2)) */
+    r2 = V::mul(r, r);
+    px = V::set1(1.26177193074810590878E-4);
+    px = V::fma(px, r2, V::set1(3.02994407707441961300E-2));
+    px = V::fma(px, r2, V::set1(9.99999999999999999910E-1));
+    px = V::mul(px, r);
+    qx = V::set1(3.00198505138664455042E-6);
+    qx = V::fma(qx, r2, V::set1(2.52448340349684104192E-3));
+    qx = V::fma(qx, r2, V::set1(2.27265548208155028766E-1));
+    qx = V::fma(qx, r2, V::set1(2.00000000000000000009E0));
+    p = V::div(px, V::sub(qx, px));
+    p = V::fma(p, V::set1(2.0), V::set1(1.0));
+
+    half = V::round(V::mul(n, V::set1(0.5)));
+    p = V::mul(V::mul(p, V::pow2(half)), V::pow2(V::sub(n, half)));
+
+    p = V::select(V::gt(x, hi), V::set1(__builtin_inf()), p);
+    p = V::select(V::lt(x, lo), V::set1(0.0), p);
+    return V::select(V::isnan(x), x, p);
+}
+
+/* log(x) for float. max error 1 ulp. log(0) = -inf, log(x<0) = nan */
+template <typename V>
+inline typename V::reg log_ps(typename V::reg x) {
+    typedef typename V::reg reg;
+    typedef typename V::mask mask;
+
+    reg m, e, t, z, y, r;
+    mask small, sub;
+
+    /* subnormals are scaled up into the normal range first */
+    sub = V::lt(x, V::set1(1.17549435e-38f));
+    t = V::select(sub, V::mul(x, V::set1(8388608.0f)), x);
+
+    m = V::frexp(t, e);
+    e = V::select(sub, V::sub(e, V::set1(23.0f)), e);
+
+    /* keep m in [sqrt(1/2), sqrt(2)) */
+    small = V::lt(m, V::set1(0.707106781186547524f));
+    e = V::select(small, V::sub(e, V::set1(1.0f)), e);
+    m = V::sub(V::select(small, V::add(m, m), m), V::set1(1.0f));
+
+    z = V::mul(m, m);
+    y = V::set1(7.0376836292E-2f);
+    y = V::fma(y, m, V::set1(-1.1514610310E-1f));
+    y = V::fma(y, m, V::set1(1.1676998740E-1f));
+    y = V::fma(y, m, V::set1(-1.2420140846E-1f));
+    y = V::fma(y, m, V::set1(1.4249322787E-1f));
+    y = V::fma(y, m, V::set1(-1.6668057665E-1f));
+    y = V::fma(y, m, V::set1(2.0000714765E-1f));
+    y = V::fma(y, m, V::set1(-2.4999993993E-1f));
+    y = V::fma(y, m, V::set1(3.3333331174E-1f));
+    y = V::mul(V::mul(y, m), z);
+
+    y = V::fma(e, V::set1(-2.12194440e-4f), y);
+    y = V::fma(z, V::set1(-0.5f), y);
+    r = V::add(m, y);
+    r = V::fma(e, V::set1(0.693359375f), r);
+
+    r = V::select(V::eq(x, V::set1(__builtin_inff())), x, r);
+    r = V::select(V::eq(x, V::set1(0.0f)), V::set1(-__builtin_inff()), r);
+    r = V::select(V::lt(x, V::set1(0.0f)), V::set1(__builtin_nanf("")), r);
+    return V::select(V::isnan(x), x, r);
+}
+
+/* log(x) for double. max error 1 ulp. log(0) = -inf, log(x<0) = nan */
+template <typename V>
+inline typename V::reg log_pd(typename V::reg x) {
+    typedef typename V::reg reg;
+    typedef typename V::mask mask;
+
+    reg m, e, t, z, p, q, y, r;
+    mask small, sub;
+
+    sub = V::lt(x, V::set1(2.2250738585072014e-308));
+    t = V::select(sub, V::mul(x, V::set1(18014398509481984.0)), x);
+
+    m = V::frexp(t, e);
+    e = V::select(sub, V::sub(e, V::set1(54.0)), e);
+
+    small = V::lt(m, V::set1(0.70710678118654752440));
+    e = V::select(small, V::sub(e, V::set1(1.0)), e);
+    m = V::sub(V::select(small, V::add(m, m), m), V::set1(1.0));
+
+    /* log(1+m) = m - m^2/2 + m^3 P(m)/Q(m) */
+    z = V::mul(m, m);
+    p = V::set1(1.01875663804580931796E-4);
+    p = V::fma(p, m, V::set1(4.97494994976747001425E-1));
+    p = V::fma(p, m, V::set1(4.70579119878881725854E0));
+    p = V::fma(p, m, V::set1(1.44989225341610930846E1));
+    p = V::fma(p, m, V::set1(1.79368678507819816313E1));
+    p = V::fma(p, m, V::set1(7.70838733755885391666E0));
+    q = V::add(m, V::set1(1.12873587189167450590E1));
+    q = V::fma(q, m, V::set1(4.52279145837532221105E1));
+    q = V::fma(q, m, V::set1(8.29875266912776603211E1));
+    q = V::fma(q, m, V::set1(7.11544750618563894466E1));
+    q = V::fma(q, m, V::set1(2.31251620126765340583E1));
+    y = V::mul(m, V::div(V::mul(z, p), q));
+
+    y = V::fma(e, V::set1(-2.121944400546905827679e-4), y);
+    y = V::fma(z, V::set1(-0.5), y);
+    r = V::add(m, y);
+    r = V::fma(e, V::set1(0.693359375), r);
+
+    r = V::select(V::eq(x, V::set1(__builtin_inf())), x, r);
+    r = V::select(V::eq(x, V::set1(0.0)), V::set1(-__builtin_inf()), r);
+    r = V::select(V::lt(x, V::set1(0.0)), V::set1(__builtin_nan("")), r);
+    return V::select(V::isnan(x), x, r);
+}
+
+/* tanh(x) for float. max error 2 ulp. */
+template <typename V>
+inline typename V::reg tanh_ps(typename V::reg x) {
+    typedef typename V::reg reg;
+
+    reg a, z, p, s, big;
+
+    /* |x| < 0.625: x + x^3 P(x^2) */
+    z = V::mul(x, x);
+    p = V::set1(-5.70498872745E-3f);
+    p = V::fma(p, z, V::set1(2.06390887954E-2f));
+    p = V::fma(p, z, V::set1(-5.37397155531E-2f));
+    p = V::fma(p, z, V::set1(1.33314422036E-1f));
+    p = V::fma(p, z, V::set1(-3.33332819422E-1f));
+    p = V::fma(V::mul(p, z), x, x);
+
+    /* otherwise 1 - 2 / (exp(2|x|) + 1) */
+    a = V::abs(x);
+    s = exp_ps<V>(V::add(a, a));
+    big = V::sub(V::set1(1.0f), V::div(V::set1(2.0f), V::add(s, V::set1(1.0f))));
+    big = V::copysign(big, x);
+
+    return V::select(V::gt(a, V::set1(0.625f)), big, p);
+}
+
+/* tanh(x) for double. max error 2 ulp. */
+template <typename V>
+inline typename V::reg tanh_pd(typename V::reg x) {
+    typedef typename V::reg reg;
+
+    reg a, z, p, q, s, big, small;
+
+    /* |x| < 0.625: x + x^3 P(x^2)/Q(x^2) */
+    z = V::mul(x, x);
+    p = V::set1(-9.64399179425052238628E-1);
+    p = V::fma(p, z, V::set1(-9.92877231001918586564E1));
+    p = V::fma(p, z, V::set1(-1.61468768441708447952E3));
+    q = V::add(z, V::set1(1.12811678491632931402E2));
+    q = V::fma(q, z, V::set1(2.23548839060100448583E3));
+    q = V::fma(q, z, V::set1(4.84406305325125486048E3));
+    small = V::fma(V::mul(x, z), V::div(p, q), x);
+
+    a = V::abs(x);
+    s = exp_pd<V>(V::add(a, a));
+    big = V::sub(V::set1(1.0), V::div(V::set1(2.0), V::add(s, V::set1(1.0))));
+    big = V::copysign(big, x);
+
+    return V::select(V::gt(a, V::set1(0.625)), big, small);
+}
+
+/* sigmoid(x) = 1 / (1 + exp(-x)). max error 4 ulp. */
+template <typename V>
+inline typename V::reg sigmoid_ps(typename V::reg x) {
+    typename V::reg one = V::set1(1.0f);
+    return V::div(one, V::add(one, exp_ps<V>(V::sub(V::set1(0.0f), x))));
+}
+
+template <typename V>
+inline typename V::reg sigmoid_pd(typename V::reg x) {
+    typename V::reg one = V::set1(1.0);
+    return V::div(one, V::add(one, exp_pd<V>(V::sub(V::set1(0.0), x))));
+}
+
+/* whether p is a multiple of alignment, a power of two. the standard headers are off limits here. */
+inline bool aligned_to(const void *p, unsigned long alignment) {
+    return (((unsigned long) p) & (alignment - 1)) == 0;
+}
+
+/* applies F to n elements of x. the head is done one at a time until out is aligned, so the body
+   uses aligned stores (and aligned loads if x lines up too). the tail is padded out to a full vector. */
+template <typename V, typename V::reg (*F)(typename V::reg)>
+inline void map(size_t n, const typename V::scalar *x, typename V::scalar *out) {
+    typedef typename V::scalar scalar;
+    const unsigned long alignment = sizeof(typename V::reg);
+    scalar buf[V::width];
+    size_t i, rem, head;
+
+    /* out must at least be scalar aligned to ever reach a vector boundary */
+    head = 0;
+    if (aligned_to(out, sizeof(scalar))) {
+        while (head < n && !aligned_to(out + head, alignment)) head++;
+    }
+
+    for (i = 0; i < head; i += rem) {
+        rem = head - i;
+        for (size_t j = 0; j < V::width; j++) buf[j] = (j < rem) ? x[i + j] : (scalar) 0;
+        V::store(buf, F(V::load(buf)));
+        if (rem > V::width) rem = V::width;
+        for (size_t j = 0; j < rem; j++) out[i + j] = buf[j];
+    }
+
+    if (!aligned_to(out + i, alignment)) {
+        for (; i + V::width <= n; i += V::width) {
+            V::store(out + i, F(V::load(x + i)));
+        }
+    } else if (aligned_to(x + i, alignment)) {
+        for (; i + V::width <= n; i += V::width) {
+            V::store_aligned(out + i, F(V::load_aligned(x + i)));
+        }
+    } else {
+        for (; i + V::width <= n; i += V::width) {
+            V::store_aligned(out + i, F(V::load(x + i)));
+        }
+    }
+
+    rem = n - i;
+    if (rem == 0) return;
+
+    for (size_t j = 0; j < V::width; j++) buf[j] = (j < rem) ? x[i + j] : (scalar) 0;
+    V::store(buf, F(V::load(buf)));
+    for (size_t j = 0; j < rem; j++) out[i + j] = buf[j];
+}
+
+/* one Adam step on a vector of each array: m = beta1 m + (1-beta1) g, v = beta2 v + (1-beta2) g^2,
+   var -= step m / (sqrt(v) + epsilon) */
+template <typename V>
+inline void adam_reg(typename V::scalar *var, const typename V::scalar *grad, typename V::scalar *m, typename V::scalar *v,
+    typename V::reg step, typename V::reg beta1, typename V::reg c1, typename V::reg beta2, typename V::reg c2, typename V::reg epsilon) {
+    typedef typename V::reg reg;
+
+    reg g = V::load(grad);
+    reg mi = V::fma(beta1, V::load(m), V::mul(c1, g));
+    reg vi = V::fma(beta2, V::load(v), V::mul(V::mul(c2, g), g));
+
+    V::store(m, mi);
+    V::store(v, vi);
+    V::store(var, V::sub(V::load(var), V::div(V::mul(step, mi), V::add(V::sqrt(vi), epsilon))));
+}
+
+/* one Adam step on n elements. each array is read and written once. the tail is padded out to a full vector. */
+template <typename V>
+inline void adam(size_t n, typename V::scalar *var, const typename V::scalar *grad, typename V::scalar *m, typename V::scalar *v,
+    typename V::scalar step, typename V::scalar beta1, typename V::scalar beta2, typename V::scalar epsilon) {
+    typedef typename V::scalar scalar;
+    typedef typename V::reg reg;
+
+    const reg step_r = V::set1(step), eps_r = V::set1(epsilon);
+    const reg b1 = V::set1(beta1), c1 = V::set1((scalar) 1 - beta1);
+    const reg b2 = V::set1(beta2), c2 = V::set1((scalar) 1 - beta2);
+    scalar var_buf[V::width], grad_buf[V::width], m_buf[V::width], v_buf[V::width];
+    size_t i, rem;
+
+    for (i = 0; i + V::width <= n; i += V::width) {
+        adam_reg<V>(var + i, grad + i, m + i, v + i, step_r, b1, c1, b2, c2, eps_r);
+    }
+
+    rem = n - i;
+    if (rem == 0) return;
+
+    for (size_t j = 0; j < V::width; j++) {
+        var_buf[j] = (j < rem) ? var[i + j] : (scalar) 0;
+        grad_buf[j] = (j < rem) ? grad[i + j] : (scalar) 0;
+        m_buf[j] = (j < rem) ? m[i + j] : (scalar) 0;
+        v_buf[j] = (j < rem) ? v[i + j] : (scalar) 0;
+    }
+    adam_reg<V>(var_buf, grad_buf, m_buf, v_buf, step_r, b1, c1, b2, c2, eps_r);
+    for (size_t j = 0; j < rem; j++) {
+        var[i + j] = var_buf[j];
+        m[i + j] = m_buf[j];
+        v[i + j] = v_buf[j];
+    }
+}
+
+}   // namespace vmath
+}   // namespace internal
+}   // namespace magmadnn
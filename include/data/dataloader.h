@@ -0,0 +1,131 @@
+/**
+ * @file dataloader.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-19
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <cassert>
+#include <cstdio>
+#include "types.h"
+#include "tensor/tensor.h"
+
+namespace magmadnn {
+namespace data {
+
+struct dataloader_params_t {
+    unsigned int batch_size;
+    bool shuffle = false;           /* visit the samples in a new random order every epoch */
+    std::vector<double> mean;       /* subtracted from x: empty, one value, or one per feature */
+    std::vector<double> stddev;     /* x is divided by this after the mean: empty, one value, or one per feature */
+};
+
+/** Hands out mini-batches of a data set while the next one is prepared on a background thread.
+ *  There are two buffers per tensor: the batch returned by next() and the one being filled. Filling
+ *  gathers the rows of the batch (in shuffled order if asked), converts them from the element type
+ *  of the data set to T and normalizes x, so none of that is left for the training loop.
+ *
+ *  Only full mini-batches are handed out; the rows left over at the end of an epoch are skipped.
+ *  Epochs follow one another without a break: the first batch of the next epoch is prepared while
+ *  the last batch of this one is in use.
+ * @tparam T the element type of the batches: int, float, or double
+ */
+template <typename T>
+class DataLoader {
+public:
+    /** Starts preparing the first batch.
+     * @tparam S element type of the data set: int, float, or double
+     * @param x samples, one per row. Must be in HOST memory and contiguous, and must not be written to
+     * while the loader exists.
+     * @param y labels, one per row, with the same layout rules as x
+     * @param params
+     * @param mem_type memory of the batches
+     */
+    template <typename S>
+    DataLoader(Tensor<S> *x, Tensor<S> *y, const dataloader_params_t& params, memory_t mem_type=HOST);
+
+    /** Stops the background thread. Batches from next() are not valid after this. */
+    ~DataLoader();
+
+    DataLoader(const DataLoader<T>& other) = delete;
+    DataLoader<T>& operator=(const DataLoader<T>& other) = delete;
+
+    /** Waits for the batch being prepared and hands it out. Calling next() again means the caller is
+     *  done with the previous batch: its buffers are filled with the batch after this one in the
+     *  background.
+     * @param x_batch set to the samples of the batch, shape {batch_size, ...}
+     * @param y_batch set to the labels of the batch
+     */
+    void next(Tensor<T> *&x_batch, Tensor<T> *&y_batch);
+
+    /** The number of batches in one epoch.
+     * @return unsigned int
+     */
+    unsigned int get_n_batches() const { return n_batches; }
+
+    /** The number of rows in every batch.
+     * @return unsigned int
+     */
+    unsigned int get_batch_size() const { return params.batch_size; }
+
+    /** The shape of the x batches.
+     * @return std::vector<unsigned int>
+     */
+    std::vector<unsigned int> get_x_shape() const { return x_buf[0]->get_shape(); }
+
+    /** The shape of the y batches.
+     * @return std::vector<unsigned int>
+     */
+    std::vector<unsigned int> get_y_shape() const { return y_buf[0]->get_shape(); }
+
+    /** The memory type of the batches.
+     * @return memory_t
+     */
+    memory_t get_memory_type() const { return mem_type; }
+
+protected:
+    void producer_loop();
+    void fill(unsigned int buf);
+
+    dataloader_params_t params;
+    memory_t mem_type;
+
+    unsigned int n_samples;
+    unsigned int n_batches;
+    size_t x_row_size, y_row_size;
+
+    /* copies row src_row of x and y, converted to T, to x_dst and y_dst */
+    std::function<void(unsigned int src_row, T *x_dst, T *y_dst)> read_row;
+
+    std::vector<double> mean;       /* one per feature, empty if x is not normalized */
+    std::vector<double> inv_stddev; /* one per feature */
+
+    Tensor<T> *x_buf[2], *y_buf[2];
+    Tensor<T> *x_stage, *y_stage;   /* batches are built here when mem_type is not HOST */
+
+    std::vector<unsigned int> order;    /* the rows of the current epoch, in the order they are used */
+    std::default_random_engine shuffle_engine;
+    unsigned int next_batch;        /* the batch the producer fills next */
+
+    std::thread producer;
+    std::mutex lock;
+    std::condition_variable cond;
+    unsigned int fill_buf;          /* the buffer the producer fills next */
+    bool fill_requested;            /* the producer should fill fill_buf */
+    bool filled;                    /* fill_buf holds a batch that was not handed out yet */
+    bool stop;
+};
+
+}   // namespace data
+}   // namespace magmadnn
@@ -6,6 +6,7 @@
  * 
  * @copyright Copyright (c) 2019
  */
+#pragma once
 #include <vector>
 #include "layer/layer.h"
 #include "tensor/tensor.h"
@@ -29,6 +30,10 @@ public:
 
     virtual std::vector<op::Operation<T> *> get_weights();
 
+    virtual op::Operation<T> *forward(op::Operation<T> *input);
+
+    activation_t get_activation() const { return activation_func; }
+
 protected:
     void init();
 
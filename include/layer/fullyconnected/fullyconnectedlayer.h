@@ -6,11 +6,13 @@
  * 
  * @copyright Copyright (c) 2019
  */
+#pragma once
 #include <vector>
 #include "layer/layer.h"
 #include "tensor/tensor.h"
 #include "compute/operation.h"
 #include "compute/tensor_operations.h"
+#include "layer/activation/activationlayer.h"
 
 namespace magmadnn {
 namespace layer {
@@ -19,15 +21,51 @@ template <typename T>
 class FullyConnectedLayer : public Layer<T> {
 public:
     FullyConnectedLayer(op::Operation<T> *input, unsigned int hidden_units, bool use_bias=true);
+
+    /** A fully connected layer followed by an activation, computed by a single fused operation.
+     * @param input 
+     * @param hidden_units 
+     * @param activation_func activation applied to the output
+     * @param use_bias 
+     */
+    FullyConnectedLayer(op::Operation<T> *input, unsigned int hidden_units, activation_t activation_func, bool use_bias=true);
     ~FullyConnectedLayer();
 
     virtual std::vector<op::Operation<T> *> get_weights();
 
+    virtual op::Operation<T> *forward(op::Operation<T> *input);
+
+    /** The n_in x n_out weight matrix.
+     * @return Tensor<T>* 
+     */
+    Tensor<T> *get_weights_tensor() { return weights_tensor; }
+
+    /** The 1 x n_out bias, or NULL if the layer has none.
+     * @return Tensor<T>* 
+     */
+    Tensor<T> *get_bias_tensor() { return (use_bias) ? bias_tensor : NULL; }
+
+    /** Whether the layer applies its activation itself.
+     * @return true 
+     * @return false 
+     */
+    bool is_fused() const { return fused; }
+
+    /** The activation applied by the layer. Only meaningful if is_fused().
+     * @return activation_t 
+     */
+    activation_t get_activation() const { return activation_func; }
+
 protected:
     void init();
 
+    /* input * weights + bias, with the activation if fused */
+    op::Operation<T> *build(op::Operation<T> *input, op::Operation<T> *weights, op::Operation<T> *bias);
+
     unsigned int hidden_units;
     bool use_bias;
+    bool fused;
+    activation_t activation_func;
 
     Tensor<T> *weights_tensor;
     Tensor<T> *bias_tensor;
@@ -40,5 +78,17 @@ protected:
 template <typename T>
 FullyConnectedLayer<T>* fullyconnected(op::Operation<T> *input, unsigned int hidden_units, bool use_bias=true);
 
+/** Returns a fully connected layer with a fused activation. It computes act(input*weights + bias)
+ *  in one pass and takes the place of a fullyconnected layer followed by an activation layer.
+ * @tparam T 
+ * @param input 
+ * @param hidden_units 
+ * @param activation_func 
+ * @param use_bias 
+ * @return FullyConnectedLayer<T>* 
+ */
+template <typename T>
+FullyConnectedLayer<T>* fullyconnected(op::Operation<T> *input, unsigned int hidden_units, activation_t activation_func, bool use_bias=true);
+
 }   // layer
 }   // magmadnn
\ No newline at end of file
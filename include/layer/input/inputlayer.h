@@ -21,6 +21,8 @@ public:
 
     virtual std::vector<op::Operation<T> *> get_weights();
 
+    virtual op::Operation<T> *forward(op::Operation<T> *input);
+
 protected:
     void init();
 
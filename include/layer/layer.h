@@ -20,6 +20,15 @@ public:
 	
 	virtual std::vector<op::Operation<T> *> get_weights() = 0;
 
+	/** Builds this layer's computation again on a different input, i.e. one with another batch size
+	 *  for inference. The new operations read the same weight tensors as out(), so they see every
+	 *  update to them, but they are not consumers of the layer's weight variables and do not change
+	 *  the training graph.
+	 * @param input the operation the layer is applied to
+	 * @return op::Operation<T>* the output of the layer on input
+	 */
+	virtual op::Operation<T> *forward(op::Operation<T> *input) = 0;
+
 	virtual op::Operation<T>* out() {
 		return output;
 	}
@@ -44,18 +53,18 @@ public:
 
 	/** Gets the size of the i-th axis of the input tensor
 	 * @param i axis
-	 * @return std::vector<unsigned int> 
+	 * @return unsigned int 
 	 */
-	std::vector<unsigned int> get_input_shape(unsigned int i) const {
+	unsigned int get_input_shape(unsigned int i) const {
 		assert( i < input_shape.size() );
 		return input_shape[i];
 	}
 
 	/** Gets the size of the i-th axis of the output tensor
 	 * @param i axis
-	 * @return std::vector<unsigned int> 
+	 * @return unsigned int 
 	 */
-	std::vector<unsigned int> get_output_shape(unsigned int i) const {
+	unsigned int get_output_shape(unsigned int i) const {
 		assert( i < output_shape.size() );
 		return output_shape[i];
 	}
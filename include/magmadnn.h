@@ -14,15 +14,24 @@
 #include "init_finalize.h"
 #include "utilities_internal.h"
 
+#include "memory/hostallocator.h"
 #include "memory/memorymanager.h"
 #include "tensor/tensor.h"
 #include "tensor/tensor_io.h"
 
+#include "parallel/threadpool.h"
+#include "parallel/parallel_for.h"
+
+#include "compute/grapharena.h"
 #include "compute/variable.h"
 #include "compute/tensor_operations.h"
 #include "compute/gradients.h"
+#include "compute/memoryplanner.h"
+#include "compute/graphexecutor.h"
+#include "compute/parallelexecutor.h"
 
 #include "layer/layers.h"
 
 #include "optimizer/optimizers.h"
+#include "data/dataloader.h"
 #include "model/models.h"
@@ -0,0 +1,209 @@
+/**
+ * @file hostallocator.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-13
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace magmadnn {
+
+/* every block handed out by a HostAllocator is aligned to this many bytes */
+const size_t HOST_ALLOCATOR_ALIGNMENT = 64;
+
+/* blocks up to this size are cached per thread, bigger ones only in the shared pool */
+const size_t HOST_ALLOCATOR_THREAD_MAX_BLOCK = 1 << 20;
+
+/* the most bytes each thread keeps in its own free lists */
+const size_t HOST_ALLOCATOR_THREAD_MAX_BYTES = 16 << 20;
+
+/* by default at most this many free bytes are kept for reuse */
+const size_t HOST_ALLOCATOR_DEFAULT_MAX_CACHED = (size_t) 2 << 30;
+
+/* size of the huge pages large blocks are backed by */
+const size_t HOST_ALLOCATOR_HUGE_PAGE_SIZE = 2 << 20;
+
+/* by default blocks of at least this many bytes are backed by huge pages */
+const size_t HOST_ALLOCATOR_DEFAULT_HUGE_PAGE_THRESHOLD = 4 << 20;
+
+/* how large blocks get huge pages */
+enum host_huge_pages_t {
+    HUGE_PAGES_NONE,            /* never */
+    HUGE_PAGES_TRANSPARENT,     /* a 2 MiB aligned mmap with madvise(MADV_HUGEPAGE), if the kernel has THP */
+    HUGE_PAGES_EXPLICIT         /* mmap with MAP_HUGETLB from the reserved pool, falling back to TRANSPARENT */
+};
+
+/** The largest power of two, up to 4096, that ptr is a multiple of. Kernels use it to pick
+ *  aligned fast paths.
+ * @param ptr
+ * @return size_t
+ */
+inline size_t get_alignment(const void *ptr) {
+    uintptr_t addr = (uintptr_t) ptr;
+    size_t alignment = 1;
+
+    while (alignment < 4096 && (addr & alignment) == 0) alignment <<= 1;
+    return alignment;
+}
+
+/** Whether ptr is a multiple of alignment, which must be a power of two.
+ * @param ptr
+ * @param alignment
+ * @return true
+ * @return false
+ */
+inline bool is_aligned(const void *ptr, size_t alignment) {
+    return (((uintptr_t) ptr) & (alignment - 1)) == 0;
+}
+
+/** Statistics of a HostAllocator. Byte counts are in whole blocks, so they include the rounding
+ *  up to a size class.
+ */
+struct host_allocator_stats_t {
+    size_t bytes_in_use;        /* bytes in blocks that are allocated */
+    size_t peak_bytes_in_use;   /* highest bytes_in_use so far */
+    size_t bytes_cached;        /* bytes in free blocks kept for reuse */
+    unsigned long n_allocations;
+    unsigned long n_cache_hits; /* allocations served from a free list */
+    double hit_rate;            /* n_cache_hits / n_allocations */
+    size_t bytes_huge_pages;    /* bytes of blocks, in use or cached, that were mapped for huge pages */
+};
+
+/** A caching allocator for HOST memory. Sizes are rounded up to a size class (four classes per power
+ *  of two, so at most 25% is wasted) and freed blocks are kept on a free list for their class instead
+ *  of going back to the system. Small blocks are kept in per-thread free lists, so the common
+ *  allocate/free pair takes no shared lock. Every block is 64 byte aligned.
+ *
+ *  Blocks of at least get_huge_page_threshold() bytes are mapped with mmap on 2 MiB boundaries and
+ *  backed by huge pages (see host_huge_pages_t), which cuts TLB misses on large weight matrices
+ *  and activations.
+ *
+ *  Cached memory is returned to the system by release(), or when the cache grows past
+ *  get_max_cached_bytes().
+ */
+class HostAllocator {
+public:
+    /**
+     * @param max_cached_bytes the most free bytes kept for reuse. 0 disables caching.
+     */
+    HostAllocator(size_t max_cached_bytes=HOST_ALLOCATOR_DEFAULT_MAX_CACHED);
+
+    /** Returns every cached block to the system. Blocks still in use must not be freed after this. */
+    ~HostAllocator();
+
+    /** Returns a 64 byte aligned block of at least bytes bytes.
+     * @param bytes
+     * @return void* NULL if the system is out of memory
+     */
+    void *allocate(size_t bytes);
+
+    /** Gives a block from allocate back to the allocator. ptr may be NULL.
+     * @param ptr
+     */
+    void deallocate(void *ptr);
+
+    /** Returns every cached block, in every thread's free lists, to the system. */
+    void release();
+
+    /** Sets the most free bytes kept for reuse. Blocks freed past this go back to the system.
+     *  Setting it to 0 disables caching; it does not release what is already cached.
+     * @param max_cached_bytes
+     */
+    void set_max_cached_bytes(size_t max_cached_bytes) { this->max_cached_bytes = max_cached_bytes; }
+
+    /** The most free bytes kept for reuse.
+     * @return size_t
+     */
+    size_t get_max_cached_bytes() const { return this->max_cached_bytes; }
+
+    /** Sets how blocks of at least threshold bytes are backed by huge pages. Only affects blocks
+     *  allocated from the system afterwards.
+     * @param mode
+     * @param threshold
+     */
+    void set_huge_pages(host_huge_pages_t mode, size_t threshold=HOST_ALLOCATOR_DEFAULT_HUGE_PAGE_THRESHOLD) {
+        this->huge_pages = mode;
+        this->huge_page_threshold = threshold;
+    }
+
+    /** How large blocks are backed by huge pages.
+     * @return host_huge_pages_t
+     */
+    host_huge_pages_t get_huge_pages() const { return this->huge_pages; }
+
+    /** The smallest block that is backed by huge pages.
+     * @return size_t
+     */
+    size_t get_huge_page_threshold() const { return this->huge_page_threshold; }
+
+    /** A snapshot of the allocator's statistics.
+     * @return host_allocator_stats_t
+     */
+    host_allocator_stats_t get_stats() const;
+
+    /** Resets the allocation and hit counts and the peak to the current bytes in use. */
+    void reset_stats();
+
+    /** The size a request for bytes is rounded up to.
+     * @param bytes
+     * @return size_t
+     */
+    static size_t get_block_size(size_t bytes);
+
+protected:
+    struct free_lists_t {
+        std::mutex lock;
+        std::vector<std::vector<void *> > blocks;   /* one list per size class */
+        size_t bytes;
+    };
+
+    void *pop(free_lists_t *lists, unsigned int size_class);
+    void *allocate_block(size_t block, unsigned int size_class);
+    void free_block(void *ptr);
+    free_lists_t *get_thread_lists();
+    void retire_thread_lists(free_lists_t *lists);
+    void free_all(free_lists_t *lists);
+
+    friend struct host_allocator_thread_state_t;
+
+    uint64_t id;                /* unique for the life of the program, so threads can tell allocators apart */
+    std::atomic<size_t> max_cached_bytes;
+    std::atomic<host_huge_pages_t> huge_pages;
+    std::atomic<size_t> huge_page_threshold;
+
+    free_lists_t shared;        /* big blocks and blocks that didn't fit in a thread's lists */
+    std::mutex threads_lock;
+    std::vector<free_lists_t *> thread_lists;   /* lists in use by a thread */
+    std::vector<free_lists_t *> spare_lists;    /* lists of threads that exited, reused by new threads */
+
+    std::atomic<size_t> bytes_in_use;
+    std::atomic<size_t> peak_bytes_in_use;
+    std::atomic<size_t> bytes_cached;
+    std::atomic<unsigned long> n_allocations;
+    std::atomic<unsigned long> n_cache_hits;
+    std::atomic<size_t> bytes_huge_pages;
+};
+
+/** The allocator MemoryManager uses for HOST memory. It is created on first use and lives until the
+ *  program exits. Setting the MAGMADNN_HOST_CACHE environment variable to 0 disables its caching.
+ *  It uses transparent huge pages for blocks of at least MAGMADNN_HUGE_PAGE_THRESHOLD bytes (4 MiB by
+ *  default); a threshold of 0 turns huge pages off.
+ * @return HostAllocator*
+ */
+HostAllocator *get_default_host_allocator();
+
+}   // namespace magmadnn
@@ -14,6 +14,7 @@
 #include <stdio.h>
 #include <assert.h>
 #include "types.h"
+#include "memory/hostallocator.h"
 
 // include cuda files if on GPU
 #if defined(_HAS_CUDA_)
@@ -27,12 +28,29 @@ namespace magmadnn {
 template <typename T>
 class MemoryManager {
 public:
-    /** MemoryManager class to keep track of a memory address across devices.
+    /** MemoryManager class to keep track of a memory address across devices. HOST memory comes from
+     *  get_default_host_allocator(), so it is 64 byte aligned and freed blocks are reused.
      *  @param size the size of the memory to allocate/manage
      *  @param mem_type what memory type will this data belong to
      *  @param device_id what device will the data reside on (preferred if mem_type is CUDA_MANAGED) 
      */
-    MemoryManager(unsigned int size, memory_t mem_type, device_t device_id);
+    MemoryManager(size_t size, memory_t mem_type, device_t device_id);
+
+    /** Takes the memory of other, which is left empty with size 0. No data is copied.
+     *  @param other
+     */
+    MemoryManager(MemoryManager<T>&& other) noexcept;
+
+    /** Releases this memory manager's data and takes the memory of other, which is left empty
+     *  with size 0. No data is copied.
+     *  @param other
+     *  @return MemoryManager<T>& 
+     */
+    MemoryManager<T>& operator=(MemoryManager<T>&& other) noexcept;
+
+    /* memory managers own their memory, so they cannot be copied. Use copy_from. */
+    MemoryManager(const MemoryManager<T>& other) = delete;
+    MemoryManager<T>& operator=(const MemoryManager<T>& other) = delete;
 
     /** Destroys the memory manager object and releases all its data.
      */
@@ -43,14 +61,14 @@ public:
      *  @param src the memorymanager to copy data from
      *  @return the error code (0 - no error, 1 - src ptr not allocated)
      */
-    magmadnn_error_t copy_from(const MemoryManager<T>& src, unsigned int begin_idx, unsigned int size);
+    magmadnn_error_t copy_from(const MemoryManager<T>& src, size_t begin_idx, size_t size);
 
     /** Copies the data from src memory manager into the pointer here. Asserts that
      *  src and this have the same size.
      *  @param src the memorymanager to copy data from
      *  @return the error code (0 - no error, 1 - src ptr not allocated)
      */
-    magmadnn_error_t copy_from(const MemoryManager<T>& src, unsigned int size);
+    magmadnn_error_t copy_from(const MemoryManager<T>& src, size_t size);
 
     /** Copies the data from src memory manager into the pointer here. Asserts that
      *  src and this have the same size.
@@ -64,7 +82,7 @@ public:
      *  @param src the array to copy into this.
      *  @return the error code (0 - good, 1 - not enough memory)
      */
-    magmadnn_error_t copy_from_host(T *src, unsigned int begin_idx, unsigned int size);
+    magmadnn_error_t copy_from_host(T *src, size_t begin_idx, size_t size);
 
 
     #if defined(_HAS_CUDA_)
@@ -73,21 +91,21 @@ public:
      *  @param src the array to copy into this.
      *  @return the error code (0 - good, 1 - not enough memory)
      */
-    magmadnn_error_t copy_from_device(T *src, unsigned int begin_idx, unsigned int size);
+    magmadnn_error_t copy_from_device(T *src, size_t begin_idx, size_t size);
 
     /** copies memory from a managed ptr into this memorymanager. will throw an error if it
      *  reaches the end of src allocated mem before this is filled.
      *  @param src the array to copy into this.
      *  @return the error code (0 - good, 1 - not enough memory)
      */
-    magmadnn_error_t copy_from_managed(T *host_src, T *device_src, unsigned int begin_idx, unsigned int size);
+    magmadnn_error_t copy_from_managed(T *host_src, T *device_src, size_t begin_idx, size_t size);
 
     /** copies memory from a cuda managed ptr into this memorymanager. will throw an error if it
      *  reaches the end of src allocated mem before this is filled.
      *  @param src the array to copy into this.
      *  @return the error code (0 - good, 1 - not enough memory)
      */
-    magmadnn_error_t copy_from_cudamanaged(T *src, unsigned int begin_idx, unsigned int size);
+    magmadnn_error_t copy_from_cudamanaged(T *src, size_t begin_idx, size_t size);
     #endif
 
     /** If MANAGED or CUDA_MANAGED this ensures that data is the same on all devices. It 
@@ -109,13 +127,21 @@ public:
      *  @param idx index to retrieve
      *  @return the value at index idx.
      */
-    T get(unsigned int idx) const;
+    T get(size_t idx) const;
 
     /** Sets the value at idx to val. Error if idx is out of range.
      *  @param idx index to set
      *  @param val value to set at idx
      */
-    void set(unsigned int idx, T val);
+    void set(size_t idx, T val);
+
+    /** Points this HOST memory manager at memory owned by someone else. The memory it currently
+     *  holds is released and ptr is never freed by this memory manager. Passing NULL gives the
+     *  memory manager its own allocation again (the data is not preserved).
+     *  @param ptr host memory with room for at least get_size() elements, or NULL
+     *  @return the error code (0 - ok, 1 - not HOST memory)
+     */
+    magmadnn_error_t bind_host_ptr(T *ptr);
 
     /** returns a CPU pointer to the data.
      *  @return cpu pointer
@@ -141,9 +167,9 @@ public:
     T* get_ptr();
 
     /** Returns the size of this memorymanager
-     * @return unsigned int  the size of this memory manager
+     * @return size_t  the size of this memory manager
      */
-    unsigned int get_size() const { return size; }
+    size_t get_size() const { return size; }
 
     /** Returns the memory type of this memory manager.
      * @return memory_t 
@@ -155,6 +181,12 @@ private:
     /** init with HOST parameters */
     void init_host();
 
+    /** frees the memory and leaves this memory manager empty */
+    void free_memory();
+
+    /** takes the pointers of other and leaves it empty */
+    void take(MemoryManager<T>& other);
+
     #if defined(_HAS_CUDA_)
     /** init with DEVICE parameters */
     void init_device();
@@ -169,8 +201,9 @@ private:
 	memory_t mem_type;
     device_t device_id;
         
-    unsigned int size;
+    size_t size;
     T* host_ptr;
+    bool owns_host_ptr;     /* false if host_ptr was given by bind_host_ptr */
 
     #if defined(_HAS_CUDA_)
     T* device_ptr;
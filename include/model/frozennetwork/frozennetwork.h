@@ -0,0 +1,90 @@
+/**
+ * @file frozennetwork.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-20
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <vector>
+#include <cstdio>
+#include <cassert>
+#include "types.h"
+#include "tensor/tensor.h"
+#include "compute/tensor_operations.h"
+#include "compute/relu/reluop.h"
+#include "layer/layers.h"
+#include "model/inferencegraphs.h"
+
+namespace magmadnn {
+namespace model {
+
+/** A trained network compiled for inference only. The layers are lowered to as few fused fully
+ *  connected operations as possible:
+ *   - an activation layer is folded into the fully connected layer before it,
+ *   - fully connected layers with no activation between them are folded into one, since
+ *     (x W1 + b1) W2 + b2 = x (W1 W2) + (b1 W2 + b2),
+ *   - input and output layers disappear.
+ *  The weights are copied when the network is frozen, so later training does not change it. The
+ *  operations are built without gradients, so they register no consumers, and the activations of
+ *  each batch size share one planned slab.
+ * @tparam T numeric
+ */
+template <typename T>
+class FrozenNetwork {
+public:
+    /** Compiles layers. Only input, fully connected, activation and output layers are supported.
+     * @param layers the layers of a network, in order, starting with its input layer
+     */
+    FrozenNetwork(const std::vector<layer::Layer<T> *>& layers);
+
+    ~FrozenNetwork();
+
+    FrozenNetwork(const FrozenNetwork<T>& other) = delete;
+    FrozenNetwork<T>& operator=(const FrozenNetwork<T>& other) = delete;
+
+    /** Runs the network on a batch of samples. See InferenceGraphs::run.
+     * @param samples shape {n, ...} for a batch of n, or the shape of one sample without the batch axis
+     * @return Tensor<T>* the network output, one row per sample. It belongs to the network and is
+     * overwritten by the next call with the same batch size. NULL if the samples have the wrong shape.
+     */
+    Tensor<T> *predict(Tensor<T> *samples);
+
+    /** The class of a sample: the index of the largest output.
+     * @param sample one sample, with or without a batch axis of size 1
+     * @return unsigned int
+     */
+    unsigned int predict_class(Tensor<T> *sample);
+
+    /** The class of each sample in a batch.
+     * @param samples as for predict
+     * @param classes_out set to one class per sample
+     * @return magmadnn_error_t non-zero if the samples have the wrong shape
+     */
+    magmadnn_error_t predict_classes(Tensor<T> *samples, std::vector<unsigned int>& classes_out);
+
+    /** The number of operations a forward pass runs.
+     * @return unsigned int
+     */
+    unsigned int get_n_stages() const { return stages.size(); }
+
+protected:
+    /* act(x W + b), or just act(x) if there are no weights */
+    struct stage_t {
+        Tensor<T> *weights;     /* NULL for an activation on its own */
+        Tensor<T> *bias;        /* NULL for no bias */
+        internal::fc_activation_t act;
+    };
+
+    void add_fullyconnected(Tensor<T> *weights, Tensor<T> *bias, internal::fc_activation_t act);
+    void add_activation(internal::fc_activation_t act);
+    op::Operation<T> *build(op::Operation<T> *input);
+
+    std::vector<stage_t> stages;
+    InferenceGraphs<T> *inference;
+};
+
+}   // namespace model
+}   // namespace magmadnn
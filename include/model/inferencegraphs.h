@@ -0,0 +1,87 @@
+/**
+ * @file inferencegraphs.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-20
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <vector>
+#include <map>
+#include <functional>
+#include <algorithm>
+#include <cstdio>
+#include "types.h"
+#include "tensor/tensor.h"
+#include "compute/operation.h"
+#include "compute/variable.h"
+#include "compute/grapharena.h"
+#include "compute/graphexecutor.h"
+
+namespace magmadnn {
+namespace model {
+
+/** Forward-only graphs of a network, one per batch size. A graph is built the first time its batch
+ *  size is run, in a GraphArena of its own, and is kept with its activation buffers for later runs.
+ *  The intermediate activations of a graph share one planned slab.
+ * @tparam T numeric
+ */
+template <typename T>
+class InferenceGraphs {
+public:
+    /* builds the network on input and returns its output */
+    typedef std::function<op::Operation<T> *(op::Operation<T> *input)> build_func_t;
+
+    /**
+     * @param input_shape the shape of the network input. The size of axis 0 is ignored.
+     * @param mem_type memory the graphs are computed in
+     * @param build called in the arena of each new graph to build it
+     */
+    InferenceGraphs(const std::vector<unsigned int>& input_shape, memory_t mem_type, build_func_t build);
+
+    /** Frees every graph. */
+    ~InferenceGraphs();
+
+    InferenceGraphs(const InferenceGraphs<T>& other) = delete;
+    InferenceGraphs<T>& operator=(const InferenceGraphs<T>& other) = delete;
+
+    /** Runs the network on a batch of samples. The samples are read in place when they are
+     *  contiguous and in the graphs' memory type, and copied otherwise.
+     * @param samples shape {n, ...} for a batch of n, or the shape of one sample without the batch axis
+     * @return Tensor<T>* the network output, one row per sample. It is overwritten by the next run
+     * with the same batch size. NULL if the samples have the wrong shape.
+     */
+    Tensor<T> *run(Tensor<T> *samples);
+
+    /** Runs the network and takes the index of the largest output of each sample.
+     * @param samples as for run
+     * @param classes_out set to one class per sample
+     * @return magmadnn_error_t non-zero if the samples have the wrong shape
+     */
+    magmadnn_error_t run_classes(Tensor<T> *samples, std::vector<unsigned int>& classes_out);
+
+    /** The number of batch sizes a graph was built for.
+     * @return unsigned int
+     */
+    unsigned int get_n_graphs() const { return graphs.size(); }
+
+protected:
+    struct graph_t {
+        op::GraphArena *arena;          /* owns every node of the graph */
+        op::Operation<T> *input;
+        op::Operation<T> *output;
+        op::GraphExecutor<T> *executor;
+    };
+
+    graph_t *get_graph(unsigned int batch_size);
+
+    std::vector<unsigned int> input_shape;
+    memory_t mem_type;
+    build_func_t build;
+    std::map<unsigned int, graph_t> graphs;
+};
+
+}   // namespace model
+}   // namespace magmadnn
@@ -10,6 +10,7 @@
 
 
 #include <string>
+#include <vector>
 #include "types.h"
 #include "tensor/tensor.h"
 #include "compute/operation.h"
@@ -20,19 +21,23 @@ namespace magmadnn {
 namespace model {
 
 struct metric_t {
-    double accuracy;
-    double loss;
-    double training_time;
+    double accuracy;                /* fraction of the last epoch's samples classified correctly */
+    double loss;                    /* mean loss over the last epoch's mini-batches */
+    double training_time;           /* seconds */
+    unsigned int steps_per_epoch;   /* mini-batches in each epoch */
+    double samples_per_second;      /* training samples processed per second */
 };
 
 template <typename T>
 class Model {
 public:
     Model() {}
+    virtual ~Model() {}
 
     virtual magmadnn_error_t fit(Tensor<T> *x, Tensor<T> *y, metric_t& metric_out, bool verbose=false) = 0;
     virtual Tensor<T> *predict(Tensor<T> *sample) = 0;
     virtual unsigned int predict_class(Tensor<T> *sample) = 0;
+    virtual magmadnn_error_t predict_classes(Tensor<T> *samples, std::vector<unsigned int>& classes_out) = 0;
 
     virtual double get_accuracy() { return _last_training_metric.accuracy; }
     virtual double get_loss() { return _last_training_metric.loss; }
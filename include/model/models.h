@@ -9,4 +9,6 @@
 #pragma once
 
 #include "model/model.h"
+#include "model/inferencegraphs.h"
+#include "model/frozennetwork/frozennetwork.h"
 #include "model/neuralnetwork/neuralnetwork.h"
\ No newline at end of file
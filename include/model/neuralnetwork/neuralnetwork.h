@@ -8,16 +8,26 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <numeric>
+#include <random>
 #include "model/model.h"
 #include "layer/layers.h"
 #include "optimizer/optimizers.h"
+#include "data/dataloader.h"
+#include "model/inferencegraphs.h"
+#include "model/frozennetwork/frozennetwork.h"
 
 namespace magmadnn {
 namespace model {
 
 struct nn_params_t {
     unsigned int n_epochs;
-    unsigned int batch_size;
+    unsigned int batch_size;    /* must match the number of rows the input layer was built with */
+    bool shuffle = false;       /* visit the mini-batches in a new random order every epoch */
 };
 
 template <typename T>
@@ -25,19 +35,83 @@ class NeuralNetwork : public Model<T> {
 public:
     NeuralNetwork(std::vector<layer::Layer<T> *> layers, optimizer::loss_t loss_func, optimizer::optimizer_t optimizer, nn_params_t params);
 
+    /** Frees the inference graphs. The layers belong to the caller. */
+    virtual ~NeuralNetwork();
+
+    /** Trains the network on the samples x with labels y. Each epoch takes one optimizer step per
+     *  mini-batch of batch_size rows. The input layer and the ground truth are pointed at slices of x
+     *  and y, so no samples are copied unless x or y is in a different memory type than the network.
+     *  Rows left over after the last full mini-batch are not used. If shuffle is set the order of
+     *  the mini-batches is permuted every epoch; the samples themselves are not moved.
+     * @param x samples, one per row
+     * @param y one-hot labels, one per row
+     * @param metric_out set to the metrics of the last epoch
+     * @param verbose print the loss and accuracy of every epoch
+     * @return magmadnn_error_t non-zero on error
+     */
     virtual magmadnn_error_t fit(Tensor<T> *x, Tensor<T> *y, metric_t& metric_out, bool verbose=false);
-    virtual Tensor<T> *predict(Tensor<T> *sample);
+
+    /** Trains the network on mini-batches from loader, which prepares the next batch on its own thread
+     *  while the network trains on the current one. Each epoch takes loader->get_n_batches() steps.
+     *  The input layer and the ground truth are pointed at the loader's buffers, so nothing is copied
+     *  unless the loader's memory type differs from the network's.
+     * @param loader must have a batch size equal to the rows of the input layer
+     * @param metric_out set to the metrics of the last epoch
+     * @param verbose print the loss and accuracy of every epoch
+     * @return magmadnn_error_t non-zero on error
+     */
+    virtual magmadnn_error_t fit(data::DataLoader<T> *loader, metric_t& metric_out, bool verbose=false);
+    /** Runs the network forward on a batch of samples. Only the layers' forward operations are
+     *  evaluated: no loss and no gradients. The forward graph is built the first time a batch size is
+     *  seen, in an arena of its own, and kept with its activation buffers for later calls with that
+     *  batch size. The samples are read in place when they are in the network's memory type.
+     * @param samples shape {n, ...} for a batch of n, or the shape of one sample without the batch axis
+     * @return Tensor<T>* the network output, one row per sample. It belongs to the model and is
+     * overwritten by the next call with the same batch size. NULL if the samples have the wrong shape.
+     */
+    virtual Tensor<T> *predict(Tensor<T> *samples);
+
+    /** The class of a sample: the index of the largest output.
+     * @param sample one sample, with or without a batch axis of size 1
+     * @return unsigned int
+     */
     virtual unsigned int predict_class(Tensor<T> *sample);
 
+    /** The class of each sample in a batch.
+     * @param samples as for predict
+     * @param classes_out set to one class per sample
+     * @return magmadnn_error_t non-zero if the samples have the wrong shape
+     */
+    virtual magmadnn_error_t predict_classes(Tensor<T> *samples, std::vector<unsigned int>& classes_out);
+
+    /** Compiles the network, as trained so far, into a forward-only network for inference. See FrozenNetwork.
+     * @return FrozenNetwork<T>* a new network that the caller deletes. Training the model afterwards does not change it.
+     */
+    FrozenNetwork<T> *freeze();
+
 protected:
+    /* the forward graphs predict runs, created on first use */
+    InferenceGraphs<T> *get_inference();
+
+    /* sets the input and ground truth tensors to mini-batch i of the epoch */
+    typedef std::function<magmadnn_error_t(unsigned int i, Tensor<T> *input_tensor, Tensor<T> *ground_truth_tensor)> batch_func_t;
+
+    /* the training loop shared by both fits: n_epochs epochs of n_batches steps each */
+    magmadnn_error_t train(unsigned int n_batches, const std::vector<unsigned int>& truth_shape, const batch_func_t& next_batch,
+        metric_t& metric_out, bool verbose);
+
     typename std::vector<layer::Layer<T> *> layers;
     optimizer::loss_t loss_func;
     optimizer::optimizer_t optimizer;
     nn_params_t model_params;
 
     T default_learning_rate = (T) 0.05;
+    T default_adam_learning_rate = (T) 0.001;
+    std::default_random_engine shuffle_engine;
     std::vector<op::Operation<T> *> _vars;
     op::Operation<T> *_obj;
+
+    InferenceGraphs<T> *_inference = NULL;
 };
 
 }   // namespace model
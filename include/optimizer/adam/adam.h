@@ -0,0 +1,67 @@
+/**
+ * @file adam.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-21
+ * 
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <climits>
+#include <algorithm>
+#include "optimizer/gradientdescent/gradientdescent.h"
+#include "optimizer/adam/adam_internal.h"
+
+namespace magmadnn {
+namespace optimizer {
+
+/** Adam (Kingma and Ba, 2015). Builds and evaluates the gradients like GradientDescent, but steps
+ *  each variable by its bias corrected first moment over the square root of its second moment.
+ *  The moments of all the variables live in one tensor, and every variable is updated in one
+ *  fused pass over it.
+ * @tparam T numeric
+ */
+template <typename T>
+class Adam : public GradientDescent<T> {
+public:
+    /**
+     * @param _obj_func the objective function to minimize
+     * @param learning_rate step size
+     * @param beta1 decay of the first moment
+     * @param beta2 decay of the second moment
+     * @param epsilon added to the square root of the second moment to keep the step finite
+     * @param parallel if true, independent parts of the objective and gradient graphs are
+     *  evaluated at the same time on the default thread pool
+     */
+    Adam(op::Operation<T> *_obj_func, T learning_rate=(T) 0.001, T beta1=(T) 0.9, T beta2=(T) 0.999, T epsilon=(T) 1E-8,
+        bool parallel=false);
+
+    ~Adam();
+
+    /** Forgets the moments and the number of steps taken. They are also reset whenever minimize
+     *  is called with different variables.
+     */
+    virtual void reset_moments();
+
+    /** The number of steps taken since the moments were reset.
+     * @return unsigned int
+     */
+    unsigned int get_n_steps() const { return n_steps; }
+
+protected:
+    virtual void apply_gradients(const std::vector<op::Operation<T> *>& wrt);
+
+    T beta1;
+    T beta2;
+    T epsilon;
+    unsigned int n_steps;
+    Tensor<T> *moments;                               /* {2, rows, cols}: the first and then second moments of _moments_wrt */
+    std::vector<op::Operation<T> *> _moments_wrt;     /* the variables moments is for */
+    std::vector<Tensor<T> *> _broadcast_grads;        /* grads repeated out to the shape of their variable, NULL if not needed */
+};
+
+}   // namespace optimizer
+}   // namespace magmadnn
@@ -0,0 +1,44 @@
+/**
+ * @file adam_internal.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-21
+ * 
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include "tensor/tensor.h"
+#include "parallel/parallel_for.h"
+#include "compute/vmath/vmath_internal.h"
+
+namespace magmadnn {
+namespace internal {
+
+/** One Adam step on every variable in vars, in a single pass over all of them. The moments of all
+ *  the variables are stored back to back in moments, in the order of vars: the first half holds the
+ *  first moments and the second half the second. Each half may be longer than the variables.
+ * @tparam T 
+ * @param vars variables to update
+ * @param grads gradient of each variable, with the same size as it
+ * @param moments shape {2, ...}, with at least the total size of vars in each half
+ * @param step learning rate, with the bias correction of this step folded in
+ * @param beta1 decay of the first moment
+ * @param beta2 decay of the second moment
+ * @param epsilon added to the denominator
+ * @return magmadnn_error_t non-zero if the sizes do not match
+ */
+template <typename T>
+magmadnn_error_t adam_update_internal(const std::vector<Tensor<T> *>& vars, const std::vector<Tensor<T> *>& grads, Tensor<T> *moments,
+    T step, T beta1, T beta2, T epsilon);
+
+#if defined(_HAS_CUDA_)
+template <typename T>
+magmadnn_error_t adam_update_internal_device(const std::vector<Tensor<T> *>& vars, const std::vector<Tensor<T> *>& grads, Tensor<T> *moments,
+    T step, T beta1, T beta2, T epsilon);
+#endif
+
+}   // namespace internal
+}   // namespace magmadnn
@@ -11,6 +11,8 @@
 #include "optimizer/optimizer.h"
 #include "compute/gradtable.h"
 #include "compute/gradients.h"
+#include "compute/graphexecutor.h"
+#include "compute/parallelexecutor.h"
 #include "optimizer/gradientdescent/gradientdescent_internal.h"
 
 namespace magmadnn {
@@ -19,15 +21,45 @@ namespace optimizer {
 template <typename T>
 class GradientDescent : public Optimizer<T> {
 public:
-    GradientDescent(op::Operation<T> *_obj_func, T learning_rate);
+    /**
+     * @param _obj_func the objective function to minimize
+     * @param learning_rate step size
+     * @param parallel if true, independent parts of the objective and gradient graphs are
+     *  evaluated at the same time on the default thread pool
+     */
+    GradientDescent(op::Operation<T> *_obj_func, T learning_rate, bool parallel=false);
 
+    ~GradientDescent();
+
+    /** Takes one gradient descent step for each variable in wrt. The gradient graph is only
+     *  built the first time it is needed for a set of variables and is reused on later calls.
+     *  It lives in an arena of the optimizer's, which frees it when it is rebuilt, so the
+     *  objective's graph must outlive the optimizer.
+     *  The objective and all of the gradients are evaluated once, in one pass over the graph,
+     *  before any variable is updated.
+     * @param wrt variables to minimize with respect to
+     */
     virtual void minimize(const std::vector<op::Operation<T> *>& wrt);
 
+    virtual void invalidate(op::Operation<T> *var);
+
+    /** Throws away the cached gradient graph. Must be called if the compute graph of the
+     *  objective function changes, so that the next call to minimize rebuilds it.
+     */
+    virtual void reset_grad_table();
+
 protected:
     virtual void update(op::Operation<T> *var, op::Operation<T> *grad);
 
+    /* updates every variable in wrt once its gradient in table is computed. calls update on each by default. */
+    virtual void apply_gradients(const std::vector<op::Operation<T> *>& wrt);
+
     T learning_rate;
+    bool parallel;
+    op::GraphArena _arena;                        /* owns the gradient graph */
     op::GradTable<T> table;
+    std::vector<op::Operation<T> *> _table_wrt;   /* the variables table was built for */
+    op::GraphExecutor<T> *_executor;              /* evaluates the objective and the gradients */
 };
 
 }   // namespace optimizer
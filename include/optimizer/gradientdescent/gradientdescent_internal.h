@@ -9,10 +9,20 @@
 #pragma once
 
 #include "tensor/tensor.h"
+#include "parallel/parallel_for.h"
+#include "compute/broadcast/broadcast_internal.h"
 
 namespace magmadnn {
 namespace internal {
 
+/** var -= learning_rate * grad. grad may have fewer elements than var if its shape broadcasts to
+ *  var's, such as a scalar grad.
+ * @tparam T 
+ * @param var 
+ * @param grad 
+ * @param learning_rate 
+ * @return magmadnn_error_t 
+ */
 template <typename T>
 magmadnn_error_t gradientdescent_update_internal(Tensor<T> *var, Tensor<T> *grad, T learning_rate);
 
@@ -19,10 +19,16 @@ template <typename T>
 class Optimizer {
 public:
     Optimizer(op::Operation<T> *_obj_func) : _obj_func(_obj_func) {}
-
+    virtual ~Optimizer() {}
 
     virtual void minimize(const std::vector<op::Operation<T> *>& wrt) = 0;
 
+    /** Tells the optimizer that the value of var was changed outside of minimize (i.e. new input
+     *  data was copied into it), so any results it has stored that depend on var are stale.
+     * @param var the operation whose value changed
+     */
+    virtual void invalidate(op::Operation<T> *var) { var->invalidate(); }
+
     virtual std::string get_name() { return _name; }
 
 protected:
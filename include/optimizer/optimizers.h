@@ -10,6 +10,7 @@
 
 #include "optimizer/optimizer.h"
 #include "optimizer/gradientdescent/gradientdescent.h"
+#include "optimizer/adam/adam.h"
 
 namespace magmadnn {
 namespace optimizer {
@@ -0,0 +1,48 @@
+/**
+ * @file parallel_for.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-06
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <algorithm>
+#include "parallel/threadpool.h"
+
+namespace magmadnn {
+namespace parallel {
+
+/** Calls body on disjoint sub-ranges that together cover [begin, end). The sub-ranges run on the
+ *  default thread pool, and each holds at least get_grain_size() elements, so ranges smaller than
+ *  twice the grain size run serially on the calling thread. Returns once every sub-range is done.
+ * @param begin first index
+ * @param end one past the last index
+ * @param body called as body(sub_begin, sub_end)
+ */
+void parallel_for(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body);
+
+/** Like parallel_for(begin, end, body), but with a given grain size. For loops whose iterations each
+ *  cover many elements (i.e. blocks of rows).
+ * @param begin first index
+ * @param end one past the last index
+ * @param grain_size smallest number of iterations given to a thread
+ * @param body called as body(sub_begin, sub_end)
+ */
+void parallel_for(size_t begin, size_t end, size_t grain_size, const std::function<void(size_t, size_t)>& body);
+
+/** Sets the smallest number of elements parallel_for gives to a thread.
+ * @param grain_size number of elements. 0 resets to the default.
+ */
+void set_grain_size(size_t grain_size);
+
+/** The smallest number of elements parallel_for gives to a thread.
+ * @return size_t
+ */
+size_t get_grain_size();
+
+}   // namespace parallel
+}   // namespace magmadnn
@@ -0,0 +1,116 @@
+/**
+ * @file threadpool.h
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-05
+ *
+ * @copyright Copyright (c) 2019
+ */
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <cstdlib>
+
+namespace magmadnn {
+namespace parallel {
+
+/** Counts the outstanding tasks submitted to a ThreadPool, so that a caller can wait on them. */
+class TaskGroup {
+public:
+    TaskGroup() : pending(0) {}
+
+    /** Whether every task in the group has finished.
+     * @return true
+     * @return false
+     */
+    bool done() const { return pending.load() == 0; }
+
+protected:
+    friend class ThreadPool;
+    std::atomic<unsigned int> pending;
+};
+
+/** A pool of worker threads that share work by stealing. Each worker has its own queue. A task
+ *  submitted from a worker goes onto that worker's queue, and a worker with an empty queue takes
+ *  the oldest task from another. A thread that waits on a TaskGroup runs queued tasks while it
+ *  waits, so tasks may submit and wait on more tasks without deadlocking the pool.
+ */
+class ThreadPool {
+public:
+    /** Starts n_workers threads. With 0 workers every task is run by the thread that waits on it.
+     * @param n_workers number of worker threads
+     */
+    ThreadPool(unsigned int n_workers);
+
+    /** Finishes the queued tasks and joins the workers. */
+    ~ThreadPool();
+
+    /** Queues task as part of group.
+     * @param group the group the task is counted in
+     * @param task the work to run
+     */
+    void submit(TaskGroup& group, const std::function<void()>& task);
+
+    /** Returns once every task in group has finished. The calling thread runs queued tasks
+     *  in the mean time.
+     * @param group the group to wait on
+     */
+    void wait(TaskGroup& group);
+
+    /** The number of threads that run tasks, which includes the thread that waits.
+     * @return unsigned int
+     */
+    unsigned int get_n_threads() const { return workers.size() + 1; }
+
+protected:
+    struct task_t {
+        std::function<void()> func;
+        TaskGroup *group;
+    };
+
+    struct queue_t {
+        std::deque<task_t> tasks;
+        std::mutex lock;
+    };
+
+    void worker_loop(unsigned int idx);
+    bool try_run(int idx);
+    bool pop(int idx, task_t& task);
+    void run(task_t& task);
+
+    std::vector<std::thread> workers;
+    std::vector<queue_t *> queues;          /* one per worker, plus a shared queue at the end */
+    std::atomic<unsigned int> n_queued;
+    std::atomic<bool> stop;
+
+    std::mutex sleep_lock;
+    std::condition_variable sleep_cond;
+};
+
+/** The pool used by the library when none is given. It is created on first use with
+ *  get_num_threads()-1 workers, since the calling thread also runs tasks.
+ * @return ThreadPool*
+ */
+ThreadPool *get_default_thread_pool();
+
+/** Sets the number of threads the default pool uses. The current default pool is shut down, so
+ *  this must not be called while work is running on it.
+ * @param n_threads number of threads, including the caller. 0 resets to the default.
+ */
+void set_num_threads(unsigned int n_threads);
+
+/** The number of threads the default pool uses. Unless set with set_num_threads, this is the
+ *  value of the MAGMADNN_NUM_THREADS environment variable or the number of hardware threads.
+ * @return unsigned int
+ */
+unsigned int get_num_threads();
+
+}   // namespace parallel
+}   // namespace magmadnn
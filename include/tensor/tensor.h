@@ -9,6 +9,7 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 #include "types.h"
 #include "memory/memorymanager.h"
 #include "tensor_internal.h"
@@ -68,18 +69,87 @@ public:
 	 */
 	Tensor(std::vector<unsigned int> shape, tensor_filler_t<T> filler, memory_t mem_type, device_t device_id);
 
-	/** Free tensor memory
+	/** Takes the memory, shape and strides of other without copying. other is left empty (size 0)
+	 *  and may only be assigned to or destroyed.
+	 * @param other 
+	 */
+	Tensor(Tensor<T>&& other) noexcept;
+
+	/** Releases this tensor's reference to its memory and takes the memory of other, which is left
+	 *  empty.
+	 * @param other 
+	 * @return Tensor<T>& 
+	 */
+	Tensor<T>& operator=(Tensor<T>&& other) noexcept;
+
+	/* copying a tensor would either copy its data or silently share it, so both are explicit:
+	   use share() or copy_from. */
+	Tensor(const Tensor<T>& other) = delete;
+	Tensor<T>& operator=(const Tensor<T>& other) = delete;
+
+	/** Drops this tensor's reference to its memory. The memory is freed with the last tensor
+	 *  (including views and shares) that refers to it.
 	 */
 	~Tensor();
 
 
-	/** Copies data from src[begin_idx] to src[begin_idx+size] into this tensor.
+	/** Returns a tensor that shares this tensor's memory, shape and strides. The memory is reference
+	 *  counted, so it lives until both tensors (and every other share or view of it) are gone, and
+	 *  writes through either are seen by the other. No memory is allocated or copied.
+	 * @return Tensor<T> 
+	 */
+	Tensor<T> share();
+
+	/** The number of tensors (shares and views included) that refer to this tensor's memory.
+	 * @return long 
+	 */
+	long get_use_count() const { return this->storage.use_count(); }
+
+	/** Returns a view of the rows [begin, end) of axis 0. Views share the memory of the tensor they
+	 *  are made from and cost O(1). Like share(), they keep the memory alive and are deleted by the
+	 *  caller.
+	 * @param begin first index of axis 0
+	 * @param end one past the last index of axis 0
+	 * @return Tensor<T>* a view with shape {end-begin, ...}
+	 */
+	Tensor<T> *slice(unsigned int begin, unsigned int end);
+
+	/** Returns a view of this tensor with a new shape of the same size. The tensor must be contiguous.
+	 * @param shape 
+	 * @return Tensor<T>* 
+	 */
+	Tensor<T> *reshape(const std::vector<unsigned int>& shape);
+
+	/** Returns a view with the axes permuted, so axis i of the view is axis perm[i] of this tensor.
+	 *  Only the strides change, so the view is usually not contiguous.
+	 * @param perm a permutation of the axes
+	 * @return Tensor<T>* 
+	 */
+	Tensor<T> *permute(const std::vector<unsigned int>& perm);
+
+	/** Returns a transposed view of this matrix. Same as permute({1,0}).
+	 * @return Tensor<T>* 
+	 */
+	Tensor<T> *transpose();
+
+	/** Returns a view with the given shape, strides and offset into this tensor's memory. Strides and
+	 *  the offset are in elements and relative to the memory, not to this tensor's strides.
+	 * @param shape 
+	 * @param strides 
+	 * @param offset 
+	 * @return Tensor<T>* 
+	 */
+	Tensor<T> *view(const std::vector<unsigned int>& shape, const std::vector<size_t>& strides, size_t offset);
+
+
+	/** Copies the elements [begin_idx, begin_idx+size) of src, in row-major order, into the first
+	 *  size elements of this tensor. Either tensor may be a view.
 	 * @param src 
 	 * @param begin_idx 
 	 * @param size 
 	 * @return magmadnn_error_t non-zero if error
 	 */
-	magmadnn_error_t copy_from(const Tensor<T>& src, unsigned int begin_idx, unsigned int size);
+	magmadnn_error_t copy_from(const Tensor<T>& src, size_t begin_idx, size_t size);
 
 	/** Copies the tensor src into this tensor.
 	 * @param src 
@@ -98,7 +168,7 @@ public:
 	 * @param idx indices to retreive value from
 	 * @return the value at idx
 	 */
-	T get(unsigned int flattened_idx) const;
+	T get(size_t flattened_idx) const;
 
 	/** sets the value at the given index.
 	 * @param idx indices to set value at
@@ -110,7 +180,7 @@ public:
 	 * @param idx indices to set value at
 	 * @param val value to write into idx
 	 */
-	void set(unsigned int flattened_idx, T val);	
+	void set(size_t flattened_idx, T val);	
 	
 
 	/** Returns the memory manager used by this tensor
@@ -130,14 +200,50 @@ public:
 	unsigned int get_shape(unsigned int idx) const;
 
 	/** returns the number of elements in tensor
-	 * @return unsigned int total number of elements in tensor
+	 * @return size_t total number of elements in tensor
+	 */
+	size_t get_size() const { return this->size; }
+
+	/** returns the strides of each axis, in elements.
+	 * @return std::vector<size_t> 
+	 */
+	const std::vector<size_t>& get_strides() const { return this->strides; }
+
+	/** returns the stride of axis idx, in elements.
+	 * @param idx 
+	 * @return size_t 
 	 */
-	unsigned int get_size() const { return this->size; }
+	size_t get_stride(unsigned int idx) const;
 
-	/** returns the pointer used by the memory manager.
+	/** returns the offset of the first element into the memory, in elements.
+	 * @return size_t 
+	 */
+	size_t get_offset() const { return this->offset; }
+
+	/** whether the elements are laid out in row-major order with no gaps. Only contiguous tensors can
+	 *  be passed to kernels that work on get_ptr() as a flat array.
+	 * @return true 
+	 * @return false 
+	 */
+	bool is_contiguous() const;
+
+	/** whether this tensor is a view into the memory of another tensor.
+	 * @return true 
+	 * @return false 
+	 */
+	bool is_view() const { return this->viewing; }
+
+	/** returns the pointer to the first element. For views that are not contiguous the elements
+	 *  must be indexed using get_strides().
 	 * @return T* 
 	 */
-	T* get_ptr() { return this->mem_manager->get_ptr(); }
+	T* get_ptr() { return this->mem_manager->get_ptr() + this->offset; }
+
+	/** the largest power of two, up to 4096, that get_ptr() is a multiple of. Whole HOST tensors are
+	 *  at least 64 byte aligned; views and slices may not be.
+	 * @return size_t 
+	 */
+	size_t get_alignment() { return magmadnn::get_alignment(get_ptr()); }
 
 	/** returns the memory type of this tensor
 	 * @return memory_t 
@@ -150,13 +256,22 @@ public:
 	device_t get_device_id() const { return this->device_id; }
 
 private:
+	/* constructs a tensor on storage, with the given layout */
+	Tensor(const std::shared_ptr<MemoryManager<T> >& storage, const std::vector<unsigned int>& shape,
+		const std::vector<size_t>& strides, size_t offset, bool viewing, memory_t mem_type, device_t device_id);
+
 	void init(std::vector<unsigned int>& shape, tensor_filler_t<T> filler, memory_t mem_type, device_t device_id);
-	unsigned int get_flattened_index(const std::vector<int>& idx) const;
+	size_t get_flattened_index(const std::vector<int>& idx) const;
+	size_t get_memory_index(size_t flattened_idx) const;
 
-	MemoryManager<T> *mem_manager;	/* allocated by init */
+	std::shared_ptr<MemoryManager<T> > storage;	/* shared with every share and view of this tensor */
+	MemoryManager<T> *mem_manager;	/* storage.get(), kept to avoid the indirection */
+	bool viewing;			/* true for views, which may see only part of the memory */
 	
 	std::vector<unsigned int> shape;	/* tensor axes (shape) */
-	unsigned int size;		/* total number of elements in tensor */
+	std::vector<size_t> strides;	/* elements between consecutive indices of each axis */
+	size_t offset;			/* index of the first element in mem_manager */
+	size_t size;			/* total number of elements in tensor */
 	memory_t mem_type;		/* the type of memory to use for this tensor */
 	device_t device_id;		/* device number i.e. gpu0 or cpu1 */
 
@@ -8,8 +8,11 @@
  */
 #pragma once
 
+#include <vector>
+#include <algorithm>
 #include "memory/memorymanager.h"
 #include "fill_internal.h"
+#include "parallel/parallel_for.h"
 
 
 namespace magmadnn {
@@ -23,5 +26,18 @@ namespace internal {
 template <typename T>
 void fill_memory(MemoryManager<T> &m, tensor_filler_t<T> filler);
 
+/** Copies the elements of a strided HOST array into another strided HOST array of the same shape.
+ *  Rows of the last axis are split across threads, and copied with std::copy when both have unit stride.
+ * @tparam T 
+ * @param shape shape of both arrays
+ * @param src first element of the source
+ * @param src_strides strides of the source, in elements
+ * @param dst first element of the destination
+ * @param dst_strides strides of the destination, in elements
+ */
+template <typename T>
+void strided_copy_host(const std::vector<unsigned int>& shape, const T *src, const std::vector<size_t>& src_strides,
+    T *dst, const std::vector<size_t>& dst_strides);
+
 }   // namespace internal
 }   // namespace magmadnn
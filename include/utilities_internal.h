@@ -14,6 +14,7 @@
 #include <vector>
 #include <set>
 #include <deque>
+#include <utility>
 #include "compute/operation.h"
 
 
@@ -42,5 +43,15 @@ void print_vector(const std::vector<unsigned int>& vec, bool debug=true, char be
 template <typename T>
 void print_compute_graph(op::Operation<T> *node, bool debug=true);
 
+/** Collects every operation that outputs depend on (including outputs) into order, such that
+ *  each operation comes after all of its inputs. Inputs are visited in order, so this is the
+ *  same order a depth-first eval would first reach each operation in.
+ * @tparam T numeric
+ * @param outputs the head nodes of the graph
+ * @param order filled with the sorted operations. Each operation appears once.
+ */
+template <typename T>
+void topological_sort(const std::vector<op::Operation<T> *>& outputs, std::vector<op::Operation<T> *>& order);
+
 }   // namespace internal
 }   // namespace magmadnn
\ No newline at end of file
@@ -13,11 +13,11 @@ class <#OPERATION_NAME#>Op : public Operation<T> {
 public:
 	<#OPERATION_NAME#>Op();
 
-	Tensor<T> *eval();
 	Operation<T> *grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad);
 	
 	std::string to_string() { return ""; }
 protected:
+	Tensor<T> *_eval(bool recompute=true);
 
 };
 
@@ -16,15 +16,13 @@ AddOp<T>::AddOp(Operation<T>* a, Operation<T>* b, bool copy, bool needs_grad) :
 	Operation<T>::Operation({a,b}, needs_grad), a(a), b(b), copy(copy) {
 	
 	assert( a->get_memory_type() == b->get_memory_type() );
-	assert( a->get_output_size() == b->get_output_size() || a->get_output_size() == 1 || b->get_output_size() == 1 );
 
-	/* if a is scalar then use b's size */
-	if (a->get_output_size() == 1) {
-		this->output_shape = b->get_output_shape();
-	} else {
-		/* other wise a's size is good */
-		this->output_shape = a->get_output_shape();
+	if (!internal::broadcast_shape(a->get_output_shape(), b->get_output_shape(), this->output_shape)) {
+		std::fprintf(stderr, "Error: can not broadcast the operands of add.\n");
+		assert( false );
 	}
+	assert( copy || b->get_output_shape() == this->output_shape );
+
 	this->mem_type = a->get_memory_type();
 
 	/* Go ahead and create copy tensor if we can */
@@ -34,34 +32,22 @@ AddOp<T>::AddOp(Operation<T>* a, Operation<T>* b, bool copy, bool needs_grad) :
 }
 
 template <typename T>
-Tensor<T>* AddOp<T>::eval(bool recompute) {
-
-	/* early exit if we can */
-	if (!recompute && this->ret != NULL) {
-		return this->ret;
-	}
+Tensor<T>* AddOp<T>::_eval(bool recompute) {
 
 	a_tensor = a->eval(recompute);
 	b_tensor = b->eval(recompute);
 
 	if (!copy) this->ret = b_tensor;
 
-	if (a_tensor->get_size() == 1) {
-		a_tensor->get_memory_manager()->sync(true);
-		internal::tensor_scalar_add_full(a_tensor->get(0), b_tensor, this->ret);
-	} else if (b_tensor->get_size() == 1) {
-		b_tensor->get_memory_manager()->sync(true);
-		internal::tensor_scalar_add_full(b_tensor->get(0), a_tensor, this->ret);
-	} else {
-		internal::geadd_full((T)1, a_tensor, (T)1, b_tensor, this->ret);
-	}
+	internal::broadcast_full(internal::BROADCAST_ADD, (T) 1, a_tensor, (T) 1, b_tensor, this->ret);
 	
 	return this->ret;
 } 
 
 template <typename T>
 Operation<T> *AddOp<T>::grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad) {
-	return grad;
+	/* summed over the axes var was broadcast along */
+	return reducesum_to(grad, var->get_output_shape(), this->output_shape);
 }
 template class AddOp<int>;
 template class AddOp<float>;
@@ -33,11 +33,13 @@ void geadd_full(T alpha, Tensor<T> *A, T beta, Tensor<T> *B, Tensor<T> *C) {
         T *a_ptr = A->get_ptr();
         T *b_ptr = B->get_ptr();
         T *c_ptr = C->get_ptr();
-        unsigned int size = A->get_size();
+        size_t size = A->get_size();
 
-        for (unsigned int i = 0; i < size; i++) {
-            c_ptr[i] = (alpha * a_ptr[i]) + (beta * b_ptr[i]);
-        }
+        parallel::parallel_for(0, size, [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                c_ptr[i] = (alpha * a_ptr[i]) + (beta * b_ptr[i]);
+            }
+        });
     }
     #if defined(_HAS_CUDA_)
     else {
@@ -54,11 +56,13 @@ void tensor_scalar_add_full(T alpha, Tensor<T> *x, Tensor<T> *out) {
     if (x->get_memory_type() == HOST) {
         T *x_ptr = x->get_ptr();
         T *out_ptr = out->get_ptr();
-        unsigned int size = x->get_size();
+        size_t size = x->get_size();
 
-        for (unsigned int i = 0; i < size; i++) {
-            out_ptr[i] = alpha + x_ptr[i];
-        }
+        parallel::parallel_for(0, size, [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                out_ptr[i] = alpha + x_ptr[i];
+            }
+        });
     }
     #if defined(_HAS_CUDA_)
     else {
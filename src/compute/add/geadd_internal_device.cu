@@ -16,10 +16,10 @@ namespace internal {
 template <typename T>
 __global__ void kernel_geadd_full_device(unsigned int M, unsigned int N, T alpha, T *A, T beta, T *B, T *C) {
 
-	unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-	unsigned int stride = blockDim.x * gridDim.x;
+	size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+	size_t stride = blockDim.x * gridDim.x;
 
-	for (unsigned int i = idx; i < M*N; i += stride) {
+	for (size_t i = idx; i < (size_t) M * N; i += stride) {
 		C[i] = alpha*A[i] + beta*B[i];
 	}
 }
@@ -34,19 +34,19 @@ template void geadd_full_device(unsigned int M, unsigned int N, double alpha, do
 
 
 template <typename T>
-__global__ void kernel_tensor_scalar_add_full_device(T alpha, T *x, T *out, unsigned int arr_size) {
+__global__ void kernel_tensor_scalar_add_full_device(T alpha, T *x, T *out, size_t arr_size) {
 
-	unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-	unsigned int stride = blockDim.x * gridDim.x;
+	size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+	size_t stride = blockDim.x * gridDim.x;
 
-	for (unsigned int i = idx; i < arr_size; i += stride) {
+	for (size_t i = idx; i < arr_size; i += stride) {
 		out[i] = alpha + x[i];
 	}
 }
 
 template <typename T>
 void tensor_scalar_add_full_device(T alpha, Tensor<T> *x, Tensor<T> *out) {
-	unsigned int size = x->get_size();
+	size_t size = x->get_size();
 	kernel_tensor_scalar_add_full_device <<< 1, size >>> (alpha, x->get_ptr(), out->get_ptr(), size);
 }
 template void tensor_scalar_add_full_device(int alpha, Tensor<int> *x, Tensor<int> *out);
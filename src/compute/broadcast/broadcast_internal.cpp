@@ -0,0 +1,168 @@
+/**
+ * @file broadcast_internal.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-18
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "compute/broadcast/broadcast_internal.h"
+
+namespace magmadnn {
+namespace internal {
+
+bool broadcast_shape(const std::vector<unsigned int>& a, const std::vector<unsigned int>& b, std::vector<unsigned int>& out) {
+    unsigned int n_axes = std::max(a.size(), b.size());
+
+    out.assign(n_axes, 1);
+    for (unsigned int i = 0; i < n_axes; i++) {
+        /* i counts from the last axis */
+        unsigned int a_dim = (i < a.size()) ? a[a.size()-1-i] : 1;
+        unsigned int b_dim = (i < b.size()) ? b[b.size()-1-i] : 1;
+
+        if (a_dim != b_dim && a_dim != 1 && b_dim != 1) return false;
+        out[n_axes-1-i] = (a_dim == 1) ? b_dim : a_dim;
+    }
+    return true;
+}
+
+template <typename T>
+std::vector<size_t> get_broadcast_strides(Tensor<T> *x, const std::vector<unsigned int>& out_shape) {
+    std::vector<unsigned int> const& shape = x->get_shape();
+    std::vector<size_t> strides (out_shape.size(), 0);
+    int lead = (int) out_shape.size() - (int) shape.size();
+
+    for (int i = 0; i < (int) shape.size(); i++) {
+        /* x may have extra leading axes of size 1 */
+        if (lead + i < 0) { assert( shape[i] == 1 ); continue; }
+
+        assert( shape[i] == out_shape[lead+i] || shape[i] == 1 );
+        if (shape[i] != 1) strides[lead+i] = x->get_stride(i);
+    }
+    return strides;
+}
+template std::vector<size_t> get_broadcast_strides(Tensor<int> *x, const std::vector<unsigned int>& out_shape);
+template std::vector<size_t> get_broadcast_strides(Tensor<float> *x, const std::vector<unsigned int>& out_shape);
+template std::vector<size_t> get_broadcast_strides(Tensor<double> *x, const std::vector<unsigned int>& out_shape);
+
+template <typename T>
+broadcast_plan_t get_broadcast_plan(Tensor<T> *a, Tensor<T> *b, const std::vector<unsigned int>& out_shape) {
+    std::vector<size_t> a_strides = get_broadcast_strides(a, out_shape);
+    std::vector<size_t> b_strides = get_broadcast_strides(b, out_shape);
+    broadcast_plan_t plan;
+
+    plan.size = 1;
+    for (unsigned int i = 0; i < out_shape.size(); i++) {
+        plan.size *= out_shape[i];
+        if (out_shape[i] == 1) continue;
+
+        /* an axis merges into the previous one if both operands step over the previous axis by
+           walking this one to its end */
+        if (!plan.shape.empty() && plan.a_strides.back() == a_strides[i] * out_shape[i]
+            && plan.b_strides.back() == b_strides[i] * out_shape[i]) {
+            plan.shape.back() *= out_shape[i];
+            plan.a_strides.back() = a_strides[i];
+            plan.b_strides.back() = b_strides[i];
+        } else {
+            plan.shape.push_back(out_shape[i]);
+            plan.a_strides.push_back(a_strides[i]);
+            plan.b_strides.push_back(b_strides[i]);
+        }
+    }
+
+    if (plan.shape.empty()) {
+        plan.shape = {1};
+        plan.a_strides = {0};
+        plan.b_strides = {0};
+    }
+    return plan;
+}
+template broadcast_plan_t get_broadcast_plan(Tensor<int> *a, Tensor<int> *b, const std::vector<unsigned int>& out_shape);
+template broadcast_plan_t get_broadcast_plan(Tensor<float> *a, Tensor<float> *b, const std::vector<unsigned int>& out_shape);
+template broadcast_plan_t get_broadcast_plan(Tensor<double> *a, Tensor<double> *b, const std::vector<unsigned int>& out_shape);
+
+/* out[j] = f(a[j*a_stride], b[j*b_stride]) for j < n. unit and zero strides get their own loops so
+   the compiler can vectorize them. */
+template <typename T, typename F>
+static inline void broadcast_row(size_t n, const T *a, size_t a_stride, const T *b, size_t b_stride, T *out, F f) {
+    if (a_stride == 1 && b_stride == 1) {
+        for (size_t j = 0; j < n; j++) out[j] = f(a[j], b[j]);
+    } else if (a_stride == 1 && b_stride == 0) {
+        T b_val = b[0];
+        for (size_t j = 0; j < n; j++) out[j] = f(a[j], b_val);
+    } else if (a_stride == 0 && b_stride == 1) {
+        T a_val = a[0];
+        for (size_t j = 0; j < n; j++) out[j] = f(a_val, b[j]);
+    } else {
+        for (size_t j = 0; j < n; j++) out[j] = f(a[j * a_stride], b[j * b_stride]);
+    }
+}
+
+/* the result is split evenly between threads. each walks its range a row of the innermost axis at
+   a time and works out where the row starts in a and b. */
+template <typename T, typename F>
+static void broadcast_host(const broadcast_plan_t& plan, const T *a, const T *b, T *out, F f) {
+    unsigned int n_axes = plan.shape.size();
+    size_t inner = plan.shape[n_axes-1];
+    size_t a_inner = plan.a_strides[n_axes-1], b_inner = plan.b_strides[n_axes-1];
+
+    parallel::parallel_for(0, plan.size, [&](size_t begin, size_t end) {
+        size_t row = begin / inner, col = begin % inner;
+
+        for (size_t i = begin; i < end; row++, col = 0) {
+            size_t a_offset = 0, b_offset = 0, rem = row;
+
+            for (int k = (int) n_axes - 2; k >= 0; k--) {
+                size_t idx = rem % plan.shape[k];
+                rem /= plan.shape[k];
+                a_offset += idx * plan.a_strides[k];
+                b_offset += idx * plan.b_strides[k];
+            }
+
+            size_t len = std::min(inner - col, end - i);
+            broadcast_row(len, a + a_offset + col * a_inner, a_inner, b + b_offset + col * b_inner, b_inner, out + i, f);
+            i += len;
+        }
+    });
+}
+
+template <typename T>
+void broadcast_full(broadcast_op_t op, T alpha, Tensor<T> *a, T beta, Tensor<T> *b, Tensor<T> *out) {
+    assert( out->is_contiguous() );
+
+    if (out->get_memory_type() == HOST) {
+        broadcast_plan_t plan = get_broadcast_plan(a, b, out->get_shape());
+        const T *a_ptr = a->get_ptr();
+        const T *b_ptr = b->get_ptr();
+        T *out_ptr = out->get_ptr();
+
+        assert( plan.size == out->get_size() );
+
+        switch (op) {
+            case BROADCAST_ADD:
+                if (alpha == (T) 1 && beta == (T) 1) {
+                    broadcast_host(plan, a_ptr, b_ptr, out_ptr, [](T x, T y) { return x + y; });
+                } else {
+                    broadcast_host(plan, a_ptr, b_ptr, out_ptr, [alpha, beta](T x, T y) { return alpha * x + beta * y; });
+                }
+                break;
+            case BROADCAST_MUL:
+                broadcast_host(plan, a_ptr, b_ptr, out_ptr, [alpha](T x, T y) { return alpha * x * y; });
+                break;
+            case BROADCAST_DIV:
+                broadcast_host(plan, a_ptr, b_ptr, out_ptr, [alpha](T x, T y) { return alpha * x / y; });
+                break;
+        }
+    }
+    #if defined(_HAS_CUDA_)
+    else {
+        broadcast_full_device(op, alpha, a, beta, b, out);
+    }
+    #endif
+}
+template void broadcast_full(broadcast_op_t op, int alpha, Tensor<int> *a, int beta, Tensor<int> *b, Tensor<int> *out);
+template void broadcast_full(broadcast_op_t op, float alpha, Tensor<float> *a, float beta, Tensor<float> *b, Tensor<float> *out);
+template void broadcast_full(broadcast_op_t op, double alpha, Tensor<double> *a, double beta, Tensor<double> *b, Tensor<double> *out);
+
+}   // namespace internal
+}   // namespace magmadnn
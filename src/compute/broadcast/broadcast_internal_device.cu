@@ -0,0 +1,68 @@
+/**
+ * @file broadcast_internal_device.cu
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-18
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "compute/broadcast/broadcast_internal.h"
+
+namespace magmadnn {
+namespace internal {
+
+/* the merged axes of a broadcast_plan_t, passed to the kernel by value */
+struct broadcast_args_t {
+    unsigned int n_axes;
+    size_t shape[BROADCAST_MAX_AXES];
+    size_t a_strides[BROADCAST_MAX_AXES];
+    size_t b_strides[BROADCAST_MAX_AXES];
+};
+
+template <typename T>
+__global__ void kernel_broadcast_full_device(size_t size, broadcast_op_t op, T alpha, const T *a, T beta, const T *b, T *out, broadcast_args_t args) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
+
+    for (size_t i = idx; i < size; i += stride) {
+        size_t rem = i, a_idx = 0, b_idx = 0;
+        for (int axis = (int) args.n_axes - 1; axis >= 0; axis--) {
+            size_t axis_idx = rem % args.shape[axis];
+            rem /= args.shape[axis];
+            a_idx += axis_idx * args.a_strides[axis];
+            b_idx += axis_idx * args.b_strides[axis];
+        }
+
+        switch (op) {
+            case BROADCAST_ADD:
+                out[i] = alpha * a[a_idx] + beta * b[b_idx]; break;
+            case BROADCAST_MUL:
+                out[i] = alpha * a[a_idx] * b[b_idx]; break;
+            case BROADCAST_DIV:
+                out[i] = alpha * a[a_idx] / b[b_idx]; break;
+        }
+    }
+}
+
+template <typename T>
+void broadcast_full_device(broadcast_op_t op, T alpha, Tensor<T> *a, T beta, Tensor<T> *b, Tensor<T> *out) {
+    broadcast_plan_t plan = get_broadcast_plan(a, b, out->get_shape());
+    broadcast_args_t args;
+
+    assert( plan.shape.size() <= BROADCAST_MAX_AXES );
+
+    args.n_axes = plan.shape.size();
+    for (unsigned int i = 0; i < args.n_axes; i++) {
+        args.shape[i] = plan.shape[i];
+        args.a_strides[i] = plan.a_strides[i];
+        args.b_strides[i] = plan.b_strides[i];
+    }
+
+    kernel_broadcast_full_device <<< (plan.size+255)/256, 256 >>> (plan.size, op, alpha, a->get_ptr(), beta, b->get_ptr(), out->get_ptr(), args);
+}
+template void broadcast_full_device(broadcast_op_t op, int alpha, Tensor<int> *a, int beta, Tensor<int> *b, Tensor<int> *out);
+template void broadcast_full_device(broadcast_op_t op, float alpha, Tensor<float> *a, float beta, Tensor<float> *b, Tensor<float> *out);
+template void broadcast_full_device(broadcast_op_t op, double alpha, Tensor<double> *a, double beta, Tensor<double> *b, Tensor<double> *out);
+
+}   // namespace internal
+}   // namespace magmadnn
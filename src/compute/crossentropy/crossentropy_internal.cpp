@@ -1,43 +1,95 @@
-
+/**
+ * @file crossentropy_internal.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-05-30
+ * 
+ * @copyright Copyright (c) 2019
+ */
 #include "compute/crossentropy/crossentropy_internal.h"
 
+/* independent accumulators per row, so the compiler can vectorize the reductions */
+#define CE_LANES 8
+
 namespace magmadnn {
 namespace internal {
 
+template <typename T>
+static T row_max(unsigned int n, const T *x) {
+    T lanes[CE_LANES];
+    T x_max = x[0];
+    unsigned int i = 0;
+
+    for (unsigned int k = 0; k < CE_LANES; k++) lanes[k] = x[0];
+    for (; i + CE_LANES <= n; i += CE_LANES) {
+        for (unsigned int k = 0; k < CE_LANES; k++) lanes[k] = (x[i+k] > lanes[k]) ? x[i+k] : lanes[k];
+    }
+    for (; i < n; i++) x_max = (x[i] > x_max) ? x[i] : x_max;
+    for (unsigned int k = 0; k < CE_LANES; k++) x_max = (lanes[k] > x_max) ? lanes[k] : x_max;
+
+    return x_max;
+}
+
+/* the loss of one row, sum(y * log(softmax(x))). e holds exp(x - x_max) and is normalized in place. */
+template <typename T>
+static T row_crossentropy(unsigned int n, const T *x, const T *y, T x_max, T *e) {
+    T e_lanes[CE_LANES] = {0}, yx_lanes[CE_LANES] = {0}, y_lanes[CE_LANES] = {0};
+    T e_sum = (T) 0, yx_sum = (T) 0, y_sum = (T) 0, inv;
+    unsigned int i = 0;
+
+    for (; i + CE_LANES <= n; i += CE_LANES) {
+        for (unsigned int k = 0; k < CE_LANES; k++) {
+            e_lanes[k] += e[i+k];
+            yx_lanes[k] += y[i+k] * x[i+k];
+            y_lanes[k] += y[i+k];
+        }
+    }
+    for (; i < n; i++) {
+        e_sum += e[i];
+        yx_sum += y[i] * x[i];
+        y_sum += y[i];
+    }
+    for (unsigned int k = 0; k < CE_LANES; k++) {
+        e_sum += e_lanes[k];
+        yx_sum += yx_lanes[k];
+        y_sum += y_lanes[k];
+    }
+
+    inv = ((T) 1) / e_sum;
+    for (i = 0; i < n; i++) e[i] *= inv;
+
+    return yx_sum - (x_max + (T) std::log((double) e_sum)) * y_sum;
+}
+
 template <typename T>
 void crossentropy_full(Tensor<T> *x, Tensor<T> *y, Tensor<T> *softmax, Tensor<T> *out) {
     if (out->get_memory_type() == HOST) {
-        T *x_ptr = x->get_ptr();
-        T *y_ptr = y->get_ptr();
+        const T *x_ptr = x->get_ptr();
+        const T *y_ptr = y->get_ptr();
         T *softmax_ptr = softmax->get_ptr();
-        T *out_ptr = out->get_ptr();
-        unsigned int x_size = x->get_size();
-        T x_max = x_ptr[0];
-        T exps_sum = (T) 0;
         unsigned int n_rows = x->get_shape(0);
+        unsigned int n_cols = x->get_shape(1);
+        std::vector<T> row_loss (n_rows);
+        T *row_loss_ptr = row_loss.data();
+        T loss = (T) 0;
 
-        /* compute max of x */
-        for (unsigned int i = 1; i < x_size; i++) {
-            if (x_ptr[i] > x_max) {
-                x_max = x_ptr[i];
-            }
-        }
+        parallel::parallel_for(0, n_rows, std::max((size_t) 1, parallel::get_grain_size() / std::max(n_cols, 1u)),
+            [=](size_t begin, size_t end) {
+            for (size_t r = begin; r < end; r++) {
+                const T *x_row = x_ptr + r * n_cols;
+                T *e_row = softmax_ptr + r * n_cols;
+                T x_max = row_max(n_cols, x_row);
 
-        /* softmax = exp(x- max(x)). also sum exp elements */
-        for (unsigned int i = 0; i < x_size; i++) {
-            softmax_ptr[i] = exp(x_ptr[i] - x_max);
-            exps_sum += softmax_ptr[i];
-        }
+                for (unsigned int j = 0; j < n_cols; j++) e_row[j] = x_row[j] - x_max;
+                vexp(n_cols, e_row, e_row);
 
-        /* divide each exp by exps_sum */
-        for (unsigned int i = 0; i < x_size; i++) {
-            softmax_ptr[i] /= exps_sum;
-        }
+                row_loss_ptr[r] = row_crossentropy(n_cols, x_row, y_ptr + r * n_cols, x_max, e_row);
+            }
+        });
 
-        for (unsigned int i = 0; i < x_size; i++) {
-            out_ptr[0] += y_ptr[i] * log(softmax_ptr[i]);
-        }
-        out_ptr[0] /= - ((T) n_rows);
+        /* summed in row order, so the loss does not depend on the number of threads */
+        for (unsigned int r = 0; r < n_rows; r++) loss += row_loss_ptr[r];
+        out->set(0, -loss / ((T) n_rows));
     }
     #if defined(_HAS_CUDA_)
     else {
@@ -49,5 +101,30 @@ template void crossentropy_full(Tensor<int> *x, Tensor<int> *y, Tensor<int> *sof
 template void crossentropy_full(Tensor<float> *x, Tensor<float> *y, Tensor<float> *softmax, Tensor<float> *out);
 template void crossentropy_full(Tensor<double> *x, Tensor<double> *y, Tensor<double> *softmax, Tensor<double> *out);
 
-}   // namespace op
-}   // namespace magmadnn
\ No newline at end of file
+
+template <typename T>
+void crossentropy_grad_full(Tensor<T> *softmax, Tensor<T> *y, Tensor<T> *grad, Tensor<T> *out) {
+    if (out->get_memory_type() == HOST) {
+        const T *softmax_ptr = softmax->get_ptr();
+        const T *y_ptr = y->get_ptr();
+        T *out_ptr = out->get_ptr();
+        T scale = grad->get(0) / ((T) softmax->get_shape(0));
+
+        parallel::parallel_for(0, out->get_size(), [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                out_ptr[i] = scale * (softmax_ptr[i] - y_ptr[i]);
+            }
+        });
+    }
+    #if defined(_HAS_CUDA_)
+    else {
+        crossentropy_grad_full_device(softmax, y, grad, out);
+    }
+    #endif
+}
+template void crossentropy_grad_full(Tensor<int> *softmax, Tensor<int> *y, Tensor<int> *grad, Tensor<int> *out);
+template void crossentropy_grad_full(Tensor<float> *softmax, Tensor<float> *y, Tensor<float> *grad, Tensor<float> *out);
+template void crossentropy_grad_full(Tensor<double> *softmax, Tensor<double> *y, Tensor<double> *grad, Tensor<double> *out);
+
+}   // namespace internal
+}   // namespace magmadnn
@@ -1,21 +1,73 @@
-
 #include "compute/crossentropy/crossentropy_internal.h"
 
+#define CE_BLOCK 256
+
 namespace magmadnn {
 namespace internal {
  
+/* a single block: each thread does whole rows, then the row losses are summed in shared memory */
 template <typename T>
-__global__ void kernel_crossentropy_full_device(T *x, T *y, T *softmax, T *out) {
+__global__ void kernel_crossentropy_full_device(unsigned int n_rows, unsigned int n_cols, const T *x, const T *y, T *softmax, T *out) {
+    __shared__ double partial[CE_BLOCK];
+    double loss = 0;
+
+    for (unsigned int r = threadIdx.x; r < n_rows; r += blockDim.x) {
+        const T *x_row = x + (size_t) r * n_cols;
+        const T *y_row = y + (size_t) r * n_cols;
+        T *e_row = softmax + (size_t) r * n_cols;
+        double x_max = x_row[0], e_sum = 0, yx_sum = 0, y_sum = 0;
+
+        for (unsigned int j = 1; j < n_cols; j++) x_max = (x_row[j] > x_max) ? x_row[j] : x_max;
+        for (unsigned int j = 0; j < n_cols; j++) {
+            double e = exp((double) x_row[j] - x_max);
+            e_row[j] = e;
+            e_sum += e;
+            yx_sum += (double) y_row[j] * x_row[j];
+            y_sum += y_row[j];
+        }
+        for (unsigned int j = 0; j < n_cols; j++) e_row[j] = e_row[j] / e_sum;
 
+        loss += yx_sum - (x_max + log(e_sum)) * y_sum;
+    }
+
+    partial[threadIdx.x] = loss;
+    __syncthreads();
+    for (unsigned int s = blockDim.x / 2; s > 0; s >>= 1) {
+        if (threadIdx.x < s) partial[threadIdx.x] += partial[threadIdx.x + s];
+        __syncthreads();
+    }
+
+    if (threadIdx.x == 0) out[0] = (T) (-partial[0] / n_rows);
 }
 
 template <typename T>
-void crossentropy_full_device(Tensor<T> *x, Tensor<T> *y, Tensor<T> *softmax, Tensor<T> *out) {
+__global__ void kernel_crossentropy_grad_full_device(size_t size, T n_rows, const T *softmax, const T *y, const T *grad, T *out) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
+    T scale = grad[0] / n_rows;
 
+    for (size_t i = idx; i < size; i += stride) {
+        out[i] = scale * (softmax[i] - y[i]);
+    }
+}
+
+template <typename T>
+void crossentropy_full_device(Tensor<T> *x, Tensor<T> *y, Tensor<T> *softmax, Tensor<T> *out) {
+    kernel_crossentropy_full_device <<< 1, CE_BLOCK >>> (x->get_shape(0), x->get_shape(1), x->get_ptr(), y->get_ptr(), softmax->get_ptr(), out->get_ptr());
 }
 template void crossentropy_full_device(Tensor<int> *x, Tensor<int> *y, Tensor<int> *softmax, Tensor<int> *out);
 template void crossentropy_full_device(Tensor<float> *x, Tensor<float> *y, Tensor<float> *softmax, Tensor<float> *out);
 template void crossentropy_full_device(Tensor<double> *x, Tensor<double> *y, Tensor<double> *softmax, Tensor<double> *out);
+
+template <typename T>
+void crossentropy_grad_full_device(Tensor<T> *softmax, Tensor<T> *y, Tensor<T> *grad, Tensor<T> *out) {
+    size_t size = out->get_size();
+
+    kernel_crossentropy_grad_full_device <<< (size+255)/256, 256 >>> (size, (T) softmax->get_shape(0), softmax->get_ptr(), y->get_ptr(), grad->get_ptr(), out->get_ptr());
+}
+template void crossentropy_grad_full_device(Tensor<int> *softmax, Tensor<int> *y, Tensor<int> *grad, Tensor<int> *out);
+template void crossentropy_grad_full_device(Tensor<float> *softmax, Tensor<float> *y, Tensor<float> *grad, Tensor<float> *out);
+template void crossentropy_grad_full_device(Tensor<double> *softmax, Tensor<double> *y, Tensor<double> *grad, Tensor<double> *out);
  
 }   // namespace op
-}   // namespace magmadnn
\ No newline at end of file
+}   // namespace magmadnn
@@ -6,7 +6,7 @@ namespace op {
 
 template <typename T>
 CrossEntropyOp<T>::CrossEntropyOp(Operation<T> *x, Operation<T> *y, bool copy, bool needs_grad)
-: Operation<T>::Operation({x,y}, needs_grad), x(x), y(y), copy(copy) {
+: Operation<T>::Operation({x,y}, needs_grad), x(x), y(y), copy(copy), x_grad(NULL), x_grad_of(NULL) {
 
 
     /*  x should be (n_samples x n_classes)
@@ -35,11 +35,8 @@ CrossEntropyOp<T>::~CrossEntropyOp() {
 }
 
 template <typename T>
-Tensor<T> *CrossEntropyOp<T>::eval(bool recompute) {
+Tensor<T> *CrossEntropyOp<T>::_eval(bool recompute) {
     
-    if (!recompute && this->ret != NULL) {
-        return this->ret;
-    }
 
     x_tensor = x->eval(recompute);
     y_tensor = y->eval(recompute);
@@ -51,8 +48,14 @@ Tensor<T> *CrossEntropyOp<T>::eval(bool recompute) {
 
 template <typename T>
 Operation<T> *CrossEntropyOp<T>::grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad) {
-    /* softmax(x) -= 1 and /= N */
-    return grad;
+    /* d/dx = grad * (softmax(x) - y) / N. the ground truth is not differentiated. */
+    assert( var == x );
+
+    if (x_grad == NULL || x_grad_of != grad) {
+        x_grad = new CrossEntropyGradOp<T> (this, y, grad);
+        x_grad_of = grad;
+    }
+    return x_grad;
 }
 
 template class CrossEntropyOp<int>;
@@ -60,6 +63,43 @@ template class CrossEntropyOp<float>;
 template class CrossEntropyOp<double>;
 
 
+template <typename T>
+CrossEntropyGradOp<T>::CrossEntropyGradOp(CrossEntropyOp<T> *loss, Operation<T> *y, Operation<T> *grad)
+: Operation<T>::Operation({loss, y, grad}, false), loss(loss), y(y), grad_op(grad) {
+
+    assert( grad->get_output_size() == 1 );
+
+    this->output_shape = y->get_output_shape();
+    this->mem_type = y->get_memory_type();
+
+    this->ret = new Tensor<T> (this->output_shape, {NONE, {}}, this->mem_type);
+}
+
+template <typename T>
+CrossEntropyGradOp<T>::~CrossEntropyGradOp() {
+    /* the loss must not hand out this gradient after it is gone */
+    if (loss->x_grad == this) {
+        loss->x_grad = NULL;
+        loss->x_grad_of = NULL;
+    }
+}
+
+template <typename T>
+Tensor<T> *CrossEntropyGradOp<T>::_eval(bool recompute) {
+    /* evaluating the loss refreshes the softmax it stores */
+    loss->eval(recompute);
+    Tensor<T> *y_tensor = y->eval(recompute);
+    Tensor<T> *grad_tensor = grad_op->eval(recompute);
+
+    internal::crossentropy_grad_full(loss->get_softmax(), y_tensor, grad_tensor, this->ret);
+
+    return this->ret;
+}
+template class CrossEntropyGradOp<int>;
+template class CrossEntropyGradOp<float>;
+template class CrossEntropyGradOp<double>;
+
+
 template <typename T>
 CrossEntropyOp<T> *crossentropy(Operation<T> *x, Operation<T> *y, bool copy, bool needs_grad) {
     return new CrossEntropyOp<T>(x, y, copy, needs_grad);
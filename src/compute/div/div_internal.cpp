@@ -10,12 +10,14 @@ void tensor_div_tensor_full(Tensor<T> *a, Tensor<T> *b, Tensor<T> *out) {
         T *a_ptr = a->get_ptr();
         T *b_ptr = b->get_ptr();
         T *out_ptr = out->get_ptr();
-        unsigned int size = out->get_size();
+        size_t size = out->get_size();
 
-        for (unsigned int i = 0; i < size; i++) {
-            if (b_ptr[i] == (T) 0) assert( false );
-            out_ptr[i] = a_ptr[i] / b_ptr[i];
-        }
+        parallel::parallel_for(0, size, [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                if (b_ptr[i] == (T) 0) assert( false );
+                out_ptr[i] = a_ptr[i] / b_ptr[i];
+            }
+        });
     }
     #if defined(_HAS_CUDA_)
     else {
@@ -35,11 +37,13 @@ void tensor_div_scalar_full(Tensor<T> *a, T scalar, Tensor<T> *out) {
     if (out->get_memory_type() == HOST) {
         T *a_ptr = a->get_ptr();
         T *out_ptr = out->get_ptr();
-        unsigned int size = out->get_size();
+        size_t size = out->get_size();
 
-        for (unsigned int i = 0; i < size; i++) {
-            out_ptr[i] = a_ptr[i] / scalar;
-        }
+        parallel::parallel_for(0, size, [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                out_ptr[i] = a_ptr[i] / scalar;
+            }
+        });
     }
     #if defined(_HAS_CUDA_)
     else {
@@ -57,12 +61,14 @@ void scalar_div_tensor_full(T scalar, Tensor<T> *a, Tensor<T> *out) {
     if (out->get_memory_type() == HOST) {
         T *a_ptr = a->get_ptr();
         T *out_ptr = out->get_ptr();
-        unsigned int size = out->get_size();
+        size_t size = out->get_size();
 
-        for (unsigned int i = 0; i < size; i++) {
-            if (a_ptr[i] == (T) 0) assert( false );
-            out_ptr[i] = scalar / a_ptr[i];
-        }
+        parallel::parallel_for(0, size, [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                if (a_ptr[i] == (T) 0) assert( false );
+                out_ptr[i] = scalar / a_ptr[i];
+            }
+        });
     }
     #if defined(_HAS_CUDA_)
     else {
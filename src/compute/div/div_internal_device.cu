@@ -5,18 +5,18 @@ namespace magmadnn {
 namespace internal {
  
 template <typename T>
-__global__ void tensor_div_tensor_full_device(T *a, T *b, T *out, unsigned int size) {
-    unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
-    unsigned int stride = blockDim.x * gridDim.x;
+__global__ void tensor_div_tensor_full_device(T *a, T *b, T *out, size_t size) {
+    size_t idx = blockDim.x * blockIdx.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
 
-    for (unsigned int i = idx; i < size; i += stride) {
+    for (size_t i = idx; i < size; i += stride) {
         if (b[i] == (T) 0) continue;
         out[i] = a[i] / b[i];
     }
 }
 template <typename T>
 void tensor_div_tensor_full_device(Tensor<T> *a, Tensor<T> *b, Tensor<T> *out) {
-    unsigned int size = out->get_size();
+    size_t size = out->get_size();
     tensor_div_tensor_full_device <<< 1, size >>> (a->get_ptr(), b->get_ptr(), out->get_ptr(), size);
 }
 template void tensor_div_tensor_full_device(Tensor<int> *a, Tensor<int> *b, Tensor<int> *out);
@@ -25,18 +25,18 @@ template void tensor_div_tensor_full_device(Tensor<double> *a, Tensor<double> *b
  
  
 template <typename T>
-__global__ void kernel_tensor_div_scalar_full_device(T *a, T scalar, T *out, unsigned int size) {
-    unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
-    unsigned int stride = blockDim.x * gridDim.x;
+__global__ void kernel_tensor_div_scalar_full_device(T *a, T scalar, T *out, size_t size) {
+    size_t idx = blockDim.x * blockIdx.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
 
-    for (unsigned int i = idx; i < size; i += stride) {
+    for (size_t i = idx; i < size; i += stride) {
         out[i] = a[i] / scalar;
     }
 }
 template <typename T>
 void tensor_div_scalar_full_device(Tensor<T> *a, T scalar, Tensor<T> *out) {
     if (scalar == (T) 0) return;
-    unsigned int size = out->get_size();
+    size_t size = out->get_size();
     kernel_tensor_div_scalar_full_device <<< 1, size >>> (a->get_ptr(), scalar, out->get_ptr(), size);
 }
 template void tensor_div_scalar_full_device(Tensor<int> *a, int scalar, Tensor<int> *out);
@@ -45,18 +45,18 @@ template void tensor_div_scalar_full_device(Tensor<double> *a, double scalar, Te
  
  
 template <typename T>
-__global__ void kernel_scalar_div_tensor_full_device(T scalar, T *a, T *out, unsigned int size) {
-    unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
-    unsigned int stride = blockDim.x * gridDim.x;
+__global__ void kernel_scalar_div_tensor_full_device(T scalar, T *a, T *out, size_t size) {
+    size_t idx = blockDim.x * blockIdx.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
 
-    for (unsigned int i = idx; i < size; i += stride) {
+    for (size_t i = idx; i < size; i += stride) {
         if (a[i] == (T) 0) continue;
         out[i] = scalar / a[i];
     }
 }
 template <typename T>
 void scalar_div_tensor_full_device(T scalar, Tensor<T> *a, Tensor<T> *out) {
-    unsigned int size = out->get_size();
+    size_t size = out->get_size();
     kernel_scalar_div_tensor_full_device <<< 1, size >>> (scalar, a->get_ptr(), out->get_ptr(), size);    
 }
 template void scalar_div_tensor_full_device(int scalar, Tensor<int> *b, Tensor<int> *out);
@@ -8,29 +8,15 @@ template <typename T>
 DivOp<T>::DivOp(Operation<T> *a, Operation<T> *b, bool copy, bool needs_grad) 
     : Operation<T>::Operation({a,b}, needs_grad), a(a), b(b), copy(copy) {
     
-    this->mem_type = a->get_memory_type();
+    assert( a->get_memory_type() == b->get_memory_type() );
 
-    unsigned int a_size = a->get_output_size();
-    unsigned int b_size = b->get_output_size();
-
-    if (a_size == 1 && b_size == 1) {
-        /* scalar-scalar ,but we can use TENSOR_DIV_TENSOR */
-        op_type = internal::TENSOR_DIV_TENSOR;
-        this->output_shape = a->get_output_shape();
-    } else if (a_size == 1) {
-        /* scalar-tensor */
-        op_type = internal::SCALAR_DIV_TENSOR;
-        this->output_shape = b->get_output_shape();
-    } else if (b_size == 1) {
-        /* tensor-scalar */
-        op_type = internal::TENSOR_DIV_SCALAR;
-        this->output_shape = a->get_output_shape();
-    } else {
-        /* tensor-tensor for now (TODO : include VEC cases) */
-        assert( a_size == b_size );
-        op_type = internal::TENSOR_DIV_TENSOR;
-        this->output_shape = a->get_output_shape();
+    if (!internal::broadcast_shape(a->get_output_shape(), b->get_output_shape(), this->output_shape)) {
+        std::fprintf(stderr, "Error: can not broadcast the operands of div.\n");
+        assert( false );
     }
+    assert( copy || b->get_output_shape() == this->output_shape );
+
+    this->mem_type = a->get_memory_type();
 
     if (copy) {
         this->ret = new Tensor<T> (this->output_shape, {NONE,{}}, this->mem_type);
@@ -38,37 +24,32 @@ DivOp<T>::DivOp(Operation<T> *a, Operation<T> *b, bool copy, bool needs_grad)
 }
 
 template <typename T>
-Tensor<T> *DivOp<T>::eval(bool recompute) {
-
-    if (!recompute && this->ret != NULL) {
-        return this->ret;
-    }
+Tensor<T> *DivOp<T>::_eval(bool recompute) {
 
     a_tensor = a->eval(recompute);
     b_tensor = b->eval(recompute);
 
     if (!copy) this->ret = b_tensor;
 
-    switch (op_type) {
-        case internal::TENSOR_DIV_TENSOR:
-            internal::tensor_div_tensor_full(a_tensor, b_tensor, this->ret); break;
-        case internal::SCALAR_DIV_TENSOR:
-            a_tensor->get_memory_manager()->sync(true);
-            internal::scalar_div_tensor_full(a_tensor->get(0), b_tensor, this->ret); break;
-        case internal::TENSOR_DIV_SCALAR:
-            b_tensor->get_memory_manager()->sync(true);
-            internal::tensor_div_scalar_full(a_tensor, b_tensor->get(0), this->ret); break;
-        default:
-            std::fprintf(stderr, "This type of div is not yet supported.\n");
-    }
+    internal::broadcast_full(internal::BROADCAST_DIV, (T) 1, a_tensor, (T) 0, b_tensor, this->ret);
 
     return this->ret;
 }
 
 template <typename T>
 Operation<T> *DivOp<T>::grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad) {
-    /* grad is ... */
-    return grad;
+    /* wrt a: grad / b, wrt b: -grad a / b^2. each summed over the axes it was broadcast along. */
+    Operation<T> *partial;
+
+    if (a == b) {
+        /* a / a is constant. this is called once for each side, so neither call may count. */
+        partial = product((T) 0, grad, a, true, false);
+    } else if (var == a) {
+        partial = div(grad, b, true, false);
+    } else {
+        partial = negative(div(product(grad, a, true, false), product(b, b, true, false), true, false), true, false);
+    }
+    return reducesum_to(partial, var->get_output_shape(), this->output_shape);
 }
 
 template class DivOp<int>;
@@ -0,0 +1,135 @@
+/**
+ * @file fullyconnected_internal.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-10
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "compute/fullyconnected/fullyconnected_internal.h"
+
+namespace magmadnn {
+namespace internal {
+
+/* elements of output computed per block. big enough for gemm to be efficient, small enough that
+   the block is still in L2 when the activation reads it back */
+#define FC_BLOCK_SIZE 16384
+
+/* out = x w + beta*out on raw row-major arrays */
+template <typename T>
+static void fc_gemm(unsigned int m, unsigned int n, unsigned int k, const T *x, const T *w, T beta, T *out);
+
+template <>
+void fc_gemm(unsigned int m, unsigned int n, unsigned int k, const int *x, const int *w, int beta, int *out) {
+    igemm(false, false, m, n, k, 1, x, (size_t) k, w, (size_t) n, beta, out, (size_t) n);
+}
+
+template <>
+void fc_gemm(unsigned int m, unsigned int n, unsigned int k, const float *x, const float *w, float beta, float *out) {
+    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, m, n, k, 1.0f, x, k, w, n, beta, out, n);
+}
+
+template <>
+void fc_gemm(unsigned int m, unsigned int n, unsigned int k, const double *x, const double *w, double beta, double *out) {
+    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, m, n, k, 1.0, x, k, w, n, beta, out, n);
+}
+
+template <typename T>
+static void fc_activation(size_t size, T *z, fc_activation_t act) {
+    switch (act) {
+        case FC_SIGMOID:
+            vsigmoid(size, z, z); break;
+        case FC_TANH:
+            vtanh(size, z, z); break;
+        case FC_RELU:
+            for (size_t i = 0; i < size; i++) z[i] = (z[i] < (T) 0) ? (T) 0 : z[i];
+            break;
+        default:
+            break;
+    }
+}
+
+template <typename T>
+magmadnn_error_t fullyconnected_full(Tensor<T> *x, Tensor<T> *w, Tensor<T> *b, Tensor<T> *out, fc_activation_t act) {
+    unsigned int m = x->get_shape(0);
+    unsigned int k = x->get_shape(1);
+    unsigned int n = w->get_shape(1);
+
+    assert( w->get_shape(0) == k );
+    assert( out->get_shape(0) == m && out->get_shape(1) == n );
+    assert( b == NULL || b->get_size() == n );
+
+    if (out->get_memory_type() == HOST) {
+        const T *x_ptr = x->get_ptr();
+        const T *w_ptr = w->get_ptr();
+        const T *b_ptr = (b != NULL) ? b->get_ptr() : NULL;
+        T *out_ptr = out->get_ptr();
+        unsigned int block_rows = std::max(1u, FC_BLOCK_SIZE / std::max(n, 1u));
+
+        for (unsigned int row = 0; row < m; row += block_rows) {
+            unsigned int rows = std::min(block_rows, m - row);
+            T *block = out_ptr + (size_t) row * n;
+
+            /* broadcast the bias into the block, then gemm accumulates onto it */
+            if (b_ptr != NULL) {
+                for (unsigned int i = 0; i < rows; i++) std::copy(b_ptr, b_ptr + n, block + (size_t) i * n);
+            }
+            fc_gemm(rows, n, k, x_ptr + (size_t) row * k, w_ptr, (b_ptr != NULL) ? (T) 1 : (T) 0, block);
+
+            fc_activation((size_t) rows * n, block, act);
+        }
+    }
+    #if defined(_HAS_CUDA_)
+    else {
+        fullyconnected_full_device(x, w, b, out, act);
+    }
+    #endif
+
+    return (magmadnn_error_t) 0;
+}
+template magmadnn_error_t fullyconnected_full(Tensor<int> *x, Tensor<int> *w, Tensor<int> *b, Tensor<int> *out, fc_activation_t act);
+template magmadnn_error_t fullyconnected_full(Tensor<float> *x, Tensor<float> *w, Tensor<float> *b, Tensor<float> *out, fc_activation_t act);
+template magmadnn_error_t fullyconnected_full(Tensor<double> *x, Tensor<double> *w, Tensor<double> *b, Tensor<double> *out, fc_activation_t act);
+
+
+template <typename T>
+magmadnn_error_t fullyconnected_grad_full(Tensor<T> *y, Tensor<T> *grad, Tensor<T> *dz, fc_activation_t act) {
+
+    if (y->get_memory_type() == HOST) {
+        const T *y_ptr = y->get_ptr();
+        const T *grad_ptr = grad->get_ptr();
+        T *dz_ptr = dz->get_ptr();
+        bool scalar_grad = (grad->get_size() == 1);
+
+        parallel::parallel_for(0, y->get_size(), [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                T g = (scalar_grad) ? grad_ptr[0] : grad_ptr[i];
+                T y_i = y_ptr[i];
+
+                switch (act) {
+                    case FC_SIGMOID:
+                        dz_ptr[i] = g * y_i * ((T) 1 - y_i); break;
+                    case FC_TANH:
+                        dz_ptr[i] = g * ((T) 1 - y_i * y_i); break;
+                    case FC_RELU:
+                        dz_ptr[i] = (y_i > (T) 0) ? g : (T) 0; break;
+                    default:
+                        dz_ptr[i] = g; break;
+                }
+            }
+        });
+    }
+    #if defined(_HAS_CUDA_)
+    else {
+        fullyconnected_grad_full_device(y, grad, dz, act);
+    }
+    #endif
+
+    return (magmadnn_error_t) 0;
+}
+template magmadnn_error_t fullyconnected_grad_full(Tensor<int> *y, Tensor<int> *grad, Tensor<int> *dz, fc_activation_t act);
+template magmadnn_error_t fullyconnected_grad_full(Tensor<float> *y, Tensor<float> *grad, Tensor<float> *dz, fc_activation_t act);
+template magmadnn_error_t fullyconnected_grad_full(Tensor<double> *y, Tensor<double> *grad, Tensor<double> *dz, fc_activation_t act);
+
+}   // namespace internal
+}   // namespace magmadnn
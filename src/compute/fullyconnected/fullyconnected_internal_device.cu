@@ -0,0 +1,89 @@
+/**
+ * @file fullyconnected_internal_device.cu
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-10
+ * 
+ * @copyright Copyright (c) 2019
+ */
+#include "compute/fullyconnected/fullyconnected_internal.h"
+
+namespace magmadnn {
+namespace internal {
+
+template <typename T>
+__global__ void kernel_fullyconnected_bias_device(size_t size, unsigned int n, const T *b, T *out) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
+
+    for (size_t i = idx; i < size; i += stride) {
+        out[i] = b[i % n];
+    }
+}
+
+template <typename T>
+__global__ void kernel_fullyconnected_activation_device(size_t size, T *out, fc_activation_t act) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
+
+    for (size_t i = idx; i < size; i += stride) {
+        switch (act) {
+            case FC_SIGMOID:
+                out[i] = 1 / (1 + exp((double) -out[i])); break;
+            case FC_TANH:
+                out[i] = tanh((double) out[i]); break;
+            case FC_RELU:
+                if (out[i] < 0) out[i] = 0;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+template <typename T>
+__global__ void kernel_fullyconnected_grad_device(size_t size, const T *y, const T *grad, bool scalar_grad, T *dz, fc_activation_t act) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
+
+    for (size_t i = idx; i < size; i += stride) {
+        T g = (scalar_grad) ? grad[0] : grad[i];
+
+        switch (act) {
+            case FC_SIGMOID:
+                dz[i] = g * y[i] * (1 - y[i]); break;
+            case FC_TANH:
+                dz[i] = g * (1 - y[i] * y[i]); break;
+            case FC_RELU:
+                dz[i] = (y[i] > 0) ? g : 0; break;
+            default:
+                dz[i] = g; break;
+        }
+    }
+}
+
+template <typename T>
+void fullyconnected_full_device(Tensor<T> *x, Tensor<T> *w, Tensor<T> *b, Tensor<T> *out, fc_activation_t act) {
+    size_t size = out->get_size();
+
+    if (b != NULL) {
+        kernel_fullyconnected_bias_device <<< (size+255)/256, 256 >>> (size, out->get_shape(1), b->get_ptr(), out->get_ptr());
+    }
+    gemm_full((T) 1, x, w, (b != NULL) ? (T) 1 : (T) 0, out);
+    kernel_fullyconnected_activation_device <<< (size+255)/256, 256 >>> (size, out->get_ptr(), act);
+}
+template void fullyconnected_full_device(Tensor<int> *x, Tensor<int> *w, Tensor<int> *b, Tensor<int> *out, fc_activation_t act);
+template void fullyconnected_full_device(Tensor<float> *x, Tensor<float> *w, Tensor<float> *b, Tensor<float> *out, fc_activation_t act);
+template void fullyconnected_full_device(Tensor<double> *x, Tensor<double> *w, Tensor<double> *b, Tensor<double> *out, fc_activation_t act);
+
+template <typename T>
+void fullyconnected_grad_full_device(Tensor<T> *y, Tensor<T> *grad, Tensor<T> *dz, fc_activation_t act) {
+    size_t size = y->get_size();
+    kernel_fullyconnected_grad_device <<< (size+255)/256, 256 >>> (size, y->get_ptr(), grad->get_ptr(), grad->get_size() == 1, dz->get_ptr(), act);
+}
+template void fullyconnected_grad_full_device(Tensor<int> *y, Tensor<int> *grad, Tensor<int> *dz, fc_activation_t act);
+template void fullyconnected_grad_full_device(Tensor<float> *y, Tensor<float> *grad, Tensor<float> *dz, fc_activation_t act);
+template void fullyconnected_grad_full_device(Tensor<double> *y, Tensor<double> *grad, Tensor<double> *dz, fc_activation_t act);
+
+}   // namespace internal
+}   // namespace magmadnn
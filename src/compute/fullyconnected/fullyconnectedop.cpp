@@ -0,0 +1,138 @@
+/**
+ * @file fullyconnectedop.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-10
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "compute/fullyconnected/fullyconnectedop.h"
+
+namespace magmadnn {
+namespace op {
+
+template <typename T>
+FullyConnectedOp<T>::FullyConnectedOp(Operation<T> *x, Operation<T> *w, Operation<T> *b, internal::fc_activation_t act, bool needs_grad)
+    : Operation<T>::Operation((b != NULL) ? std::vector<Operation<T> *> {x,w,b} : std::vector<Operation<T> *> {x,w}, needs_grad),
+    x(x), w(w), b(b), b_tensor(NULL), act(act), act_grad(NULL), act_grad_of(NULL), ones(NULL) {
+
+    assert( x->get_memory_type() == w->get_memory_type() );
+    assert( x->get_output_shape().size() == 2 );
+    assert( w->get_output_shape().size() == 2 );
+    assert( x->get_output_shape(1) == w->get_output_shape(0) );
+
+    if (b != NULL) {
+        assert( b->get_memory_type() == x->get_memory_type() );
+        assert( b->get_output_size() == w->get_output_shape(1) );
+    }
+
+    this->output_shape = {x->get_output_shape(0), w->get_output_shape(1)};
+    this->mem_type = x->get_memory_type();
+
+    this->ret = new Tensor<T> (this->output_shape, {NONE,{}}, this->mem_type);
+}
+
+template <typename T>
+FullyConnectedOp<T>::~FullyConnectedOp() {
+    /* a gradient graph that outlives this op must not reach back into it */
+    if (act_grad != NULL) act_grad->y = NULL;
+
+    if (ones != NULL) delete ones;
+}
+
+template <typename T>
+Tensor<T> *FullyConnectedOp<T>::_eval(bool recompute) {
+
+    x_tensor = x->eval(recompute);
+    w_tensor = w->eval(recompute);
+    if (b != NULL) b_tensor = b->eval(recompute);
+
+    internal::fullyconnected_full(x_tensor, w_tensor, b_tensor, this->ret, act);
+
+    return this->ret;
+}
+
+template <typename T>
+Operation<T> *FullyConnectedOp<T>::grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad) {
+    /* with z = xW + b:  dz = grad * act'(z)
+       wrt x: dz W^T  |  wrt w: x^T dz  |  wrt b: the column sums of dz */
+    Operation<T> *dz;
+
+    if (act == internal::FC_NONE && grad->get_output_shape().size() == 2) {
+        dz = grad;
+    } else {
+        /* the grads of x, w and b are requested one at a time with the same grad */
+        if (act_grad == NULL || act_grad_of != grad) {
+            act_grad = new FullyConnectedGradOp<T> (this, grad, act);
+            act_grad_of = grad;
+        }
+        dz = act_grad;
+    }
+
+    if (var == x) {
+        return matmul(dz, false, w, true, false);
+    } else if (var == w) {
+        return matmul(x, true, dz, false, false);
+    } else {
+        if (ones == NULL) ones = new Tensor<T> ({1, this->output_shape[0]}, {ONE, {}}, this->mem_type);
+        return matmul(op::var<T> ("__fullyconnected_ones", ones), false, dz, false, false);
+    }
+}
+
+template <typename T>
+std::string FullyConnectedOp<T>::to_string() {
+    std::string names[] = {"", "SIGMOID", "TANH", "RELU"};
+    std::string affine = x->to_string() + " x " + w->to_string() + ((b != NULL) ? " + " + b->to_string() : "");
+
+    return (act == internal::FC_NONE) ? "(" + affine + ")" : names[act] + "( " + affine + " )";
+}
+template class FullyConnectedOp<int>;
+template class FullyConnectedOp<float>;
+template class FullyConnectedOp<double>;
+
+
+template <typename T>
+FullyConnectedGradOp<T>::FullyConnectedGradOp(FullyConnectedOp<T> *y, Operation<T> *grad, internal::fc_activation_t act)
+    : Operation<T>::Operation({y, grad}, false), y(y), grad_op(grad), act(act) {
+
+    assert( grad->get_output_size() == 1 || grad->get_output_size() == y->get_output_size() );
+
+    this->output_shape = y->get_output_shape();
+    this->mem_type = y->get_memory_type();
+
+    this->ret = new Tensor<T> (this->output_shape, {NONE,{}}, this->mem_type);
+}
+
+template <typename T>
+FullyConnectedGradOp<T>::~FullyConnectedGradOp() {
+    /* the fully connected op must not hand out this gradient after it is gone */
+    if (y != NULL && y->act_grad == this) {
+        y->act_grad = NULL;
+        y->act_grad_of = NULL;
+    }
+}
+
+template <typename T>
+Tensor<T> *FullyConnectedGradOp<T>::_eval(bool recompute) {
+    Tensor<T> *y_tensor = y->eval(recompute);
+    Tensor<T> *grad_tensor = grad_op->eval(recompute);
+
+    internal::fullyconnected_grad_full(y_tensor, grad_tensor, this->ret, act);
+
+    return this->ret;
+}
+template class FullyConnectedGradOp<int>;
+template class FullyConnectedGradOp<float>;
+template class FullyConnectedGradOp<double>;
+
+
+template <typename T>
+FullyConnectedOp<T> *fullyconnected(Operation<T> *x, Operation<T> *w, Operation<T> *b, internal::fc_activation_t act, bool needs_grad) {
+    return new FullyConnectedOp<T> (x, w, b, act, needs_grad);
+}
+template FullyConnectedOp<int> *fullyconnected(Operation<int> *x, Operation<int> *w, Operation<int> *b, internal::fc_activation_t act, bool needs_grad);
+template FullyConnectedOp<float> *fullyconnected(Operation<float> *x, Operation<float> *w, Operation<float> *b, internal::fc_activation_t act, bool needs_grad);
+template FullyConnectedOp<double> *fullyconnected(Operation<double> *x, Operation<double> *w, Operation<double> *b, internal::fc_activation_t act, bool needs_grad);
+
+}   // namespace op
+}   // namespace magmadnn
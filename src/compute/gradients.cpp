@@ -22,9 +22,12 @@ magmadnn_error_t get_grad_table(const std::vector<Operation<T> *>& vars, Operati
         descendents of nodes in vars. */
     /* TODO */
 
-    /* init Loss in grad table to one */
-    Operation<T> *grad_loss = op::scalar<T>("1", 1, graph->get_memory_type());
-    table.set(graph, grad_loss);
+    /* init Loss in grad table to one. if it is already set, then this table was built for
+       graph before and build_grad will return the cached gradients. */
+    if (table.get(graph) == NULL) {
+        Operation<T> *grad_loss = op::scalar<T>("1", 1, graph->get_memory_type());
+        table.set(graph, grad_loss);
+    }
 
     /* compute the gradients for each variable */
     for (typename std::vector<Operation<T> *>::const_iterator vit = vars.begin(); vit != vars.end(); vit++) {
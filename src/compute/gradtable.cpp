@@ -42,6 +42,11 @@ void GradTable<T>::set(Operation<T> *var, Operation<T> *grad) {
     
 }
 
+template <typename T>
+void GradTable<T>::clear() {
+    _table.clear();
+}
+
 template class GradTable<int>;
 template class GradTable<float>;
 template class GradTable<double>;
@@ -0,0 +1,131 @@
+/**
+ * @file grapharena.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-17
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "compute/grapharena.h"
+
+namespace magmadnn {
+namespace op {
+
+/* every node has a header in front of it with the arena it came from, or NULL for the heap. It takes
+   a whole alignment unit so the node stays aligned. */
+struct node_header_t {
+    GraphArena *arena;
+};
+
+/* the arena operations on this thread go in, and the node allocate_node handed out last, which the
+   Operation constructor that runs next claims */
+static thread_local GraphArena *current_arena = NULL;
+static thread_local char *pending_node = NULL;
+static thread_local size_t pending_size = 0;
+
+GraphArena::GraphArena(size_t chunk_size)
+    : chunk_size(chunk_size), cur_chunk(0), cur_offset(0), bytes_used(0), bytes_reserved(0) {}
+
+GraphArena::~GraphArena() {
+    release();
+}
+
+void GraphArena::clear() {
+    destroy_nodes();
+
+    cur_chunk = 0;
+    cur_offset = 0;
+    bytes_used = 0;
+}
+
+void GraphArena::release() {
+    clear();
+
+    for (unsigned int i = 0; i < chunks.size(); i++) ::operator delete(chunks[i].data);
+    chunks.clear();
+    bytes_reserved = 0;
+}
+
+GraphArena *GraphArena::get_current() {
+    return current_arena;
+}
+
+void *GraphArena::allocate_node(size_t size) {
+    size_t total = GRAPH_ARENA_ALIGNMENT + (size + GRAPH_ARENA_ALIGNMENT - 1) / GRAPH_ARENA_ALIGNMENT * GRAPH_ARENA_ALIGNMENT;
+    char *raw;
+
+    raw = (char *) ((current_arena != NULL) ? current_arena->allocate(total) : ::operator new(total));
+    ((node_header_t *) raw)->arena = current_arena;
+
+    if (current_arena != NULL) {
+        pending_node = raw + GRAPH_ARENA_ALIGNMENT;
+        pending_size = size;
+    }
+    return raw + GRAPH_ARENA_ALIGNMENT;
+}
+
+void GraphArena::deallocate_node(void *ptr) {
+    char *raw;
+
+    if (ptr == NULL) return;
+
+    raw = (char *) ptr - GRAPH_ARENA_ALIGNMENT;
+    if (((node_header_t *) raw)->arena == NULL) ::operator delete(raw);
+}
+
+GraphArena *GraphArena::claim(void *ptr, void (*destroy)(void *)) {
+    GraphArena *arena;
+    node_t node;
+
+    if (pending_node == NULL || (char *) ptr < pending_node || (char *) ptr >= pending_node + pending_size) return NULL;
+
+    arena = ((node_header_t *) (pending_node - GRAPH_ARENA_ALIGNMENT))->arena;
+    pending_node = NULL;
+
+    node.ptr = ptr;
+    node.destroy = destroy;
+    arena->nodes.push_back(node);
+    return arena;
+}
+
+void *GraphArena::allocate(size_t size) {
+    void *ptr;
+    chunk_t chunk;
+
+    /* the first chunk from the current one on with room */
+    while (cur_chunk < chunks.size() && cur_offset + size > chunks[cur_chunk].size) {
+        cur_chunk++;
+        cur_offset = 0;
+    }
+
+    if (cur_chunk == chunks.size()) {
+        chunk.size = (size > chunk_size) ? size : chunk_size;
+        chunk.data = (char *) ::operator new(chunk.size);
+        chunks.push_back(chunk);
+        bytes_reserved += chunk.size;
+        cur_offset = 0;
+    }
+
+    ptr = chunks[cur_chunk].data + cur_offset;
+    cur_offset += size;
+    bytes_used += size;
+    return ptr;
+}
+
+void GraphArena::destroy_nodes() {
+    /* newest first, so consumers go before their inputs */
+    for (int i = ((int) nodes.size()) - 1; i >= 0; i--) nodes[i].destroy(nodes[i].ptr);
+    nodes.clear();
+}
+
+
+GraphArenaScope::GraphArenaScope(GraphArena& arena) : arena(&arena), previous(current_arena) {
+    current_arena = this->arena;
+}
+
+GraphArenaScope::~GraphArenaScope() {
+    current_arena = previous;
+}
+
+}   // namespace op
+}   // namespace magmadnn
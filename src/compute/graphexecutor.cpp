@@ -0,0 +1,101 @@
+/**
+ * @file graphexecutor.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-04
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "compute/graphexecutor.h"
+
+namespace magmadnn {
+namespace op {
+
+template <typename T>
+GraphExecutor<T>::GraphExecutor(const std::vector<Operation<T> *>& outputs, bool plan_memory)
+    : outputs(outputs), planner(NULL), n_evaluated(0) {
+    unsigned int n;
+
+    internal::topological_sort(outputs, schedule);
+    n = schedule.size();
+
+    for (unsigned int i = 0; i < n; i++) pos[schedule[i]] = i;
+
+    consumers.resize(n);
+    for (unsigned int i = 0; i < n; i++) {
+        std::vector<Operation<T> *> const& inputs = schedule[i]->get_inputs();
+
+        for (unsigned int k = 0; k < inputs.size(); k++) {
+            consumers[pos[inputs[k]]].push_back(i);
+        }
+    }
+
+    if (plan_memory) {
+        planner = new MemoryPlanner<T> (outputs);
+        planner->apply();
+    }
+}
+
+template <typename T>
+GraphExecutor<T>::~GraphExecutor() {
+    if (planner != NULL) delete planner;
+}
+
+template <typename T>
+magmadnn_error_t GraphExecutor<T>::run() {
+    n_evaluated = 0;
+
+    for (unsigned int i = 0; i < schedule.size(); i++) {
+        if (schedule[i]->is_computed()) continue;
+
+        if (schedule[i]->eval(false) == NULL) return (magmadnn_error_t) 1;
+        n_evaluated++;
+    }
+
+    return (magmadnn_error_t) 0;
+}
+
+template <typename T>
+void GraphExecutor<T>::invalidate(Operation<T> *op) {
+    typename std::map<Operation<T> *, unsigned int>::iterator it;
+    std::vector<unsigned int> stack;
+    std::vector<bool> visited (schedule.size(), false);
+
+    if (planner != NULL) {
+        invalidate_all();
+        return;
+    }
+
+    it = pos.find(op);
+    if (it == pos.end()) {
+        op->invalidate();
+        return;
+    }
+
+    stack.push_back(it->second);
+    visited[it->second] = true;
+    while (!stack.empty()) {
+        unsigned int cur = stack.back();
+        stack.pop_back();
+
+        schedule[cur]->invalidate();
+        for (unsigned int k = 0; k < consumers[cur].size(); k++) {
+            if (!visited[consumers[cur][k]]) {
+                visited[consumers[cur][k]] = true;
+                stack.push_back(consumers[cur][k]);
+            }
+        }
+    }
+}
+
+template <typename T>
+void GraphExecutor<T>::invalidate_all() {
+    for (unsigned int i = 0; i < schedule.size(); i++) schedule[i]->invalidate();
+}
+
+template class GraphExecutor<int>;
+template class GraphExecutor<float>;
+template class GraphExecutor<double>;
+
+}   // namespace op
+}   // namespace magmadnn
@@ -9,11 +9,11 @@ void log_full(Tensor<T> *x, Tensor<T> *out) {
     if (x->get_memory_type() == HOST) {
         T *x_ptr = x->get_ptr();
         T *out_ptr = out->get_ptr();
-        unsigned int size = x->get_size();
+        size_t size = x->get_size();
 
-        for (unsigned int i = 0; i < size; i++) {
-            out_ptr[i] = log( x_ptr[i] );
-        }
+        parallel::parallel_for(0, size, [=](size_t begin, size_t end) {
+            vlog(end - begin, x_ptr + begin, out_ptr + begin);
+        });
     }
     #if defined(_HAS_CUDA_)
     else { 
@@ -5,26 +5,26 @@ namespace magmadnn {
 namespace internal {
  
 template <typename T>
-__global__ void kernel_log_full_device(T *x, T *out, unsigned int size) {
-    unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
-    unsigned int stride = blockDim.x * gridDim.x;
+__global__ void kernel_log_full_device(T *x, T *out, size_t size) {
+    size_t idx = blockDim.x * blockIdx.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
 
-    for (unsigned int i = idx; i < size; i += stride) {
+    for (size_t i = idx; i < size; i += stride) {
         out[i] = log( x[i] );
     }
 }
-template <> __global__ void kernel_log_full_device(int *x, int *out, unsigned int size) {
-    unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
-    unsigned int stride = blockDim.x * gridDim.x;
+template <> __global__ void kernel_log_full_device(int *x, int *out, size_t size) {
+    size_t idx = blockDim.x * blockIdx.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
 
-    for (unsigned int i = idx; i < size; i += stride) {
+    for (size_t i = idx; i < size; i += stride) {
         out[i] = (int) log( (float) x[i] );
     }
 }
 
 template <typename T>
 void log_full_device(Tensor<T> *x, Tensor<T> *out) {
-    unsigned int size = x->get_size();
+    size_t size = x->get_size();
     kernel_log_full_device <<< 1, size >>> (x->get_ptr(), out->get_ptr(), size);
 }
 template void log_full_device(Tensor<int> *x, Tensor<int> *out);
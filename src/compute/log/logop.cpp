@@ -17,11 +17,7 @@ LogOp<T>::LogOp(Operation<T> *x, bool copy, bool needs_grad)
 }
 
 template <typename T>
-Tensor<T> *LogOp<T>::eval(bool recompute) {
-
-    if (!recompute && this->ret != NULL) {
-        return this->ret;
-    }
+Tensor<T> *LogOp<T>::_eval(bool recompute) {
 
     x_tensor = x->eval(recompute);
 
@@ -12,7 +12,7 @@ namespace magmadnn {
 namespace internal {
 
 template <typename T>
-bool gemm_check(Tensor<T> *A, Tensor<T> *B, Tensor<T> *C, unsigned int &M, unsigned int &N, unsigned int &K) {
+bool gemm_check(Tensor<T> *A, Tensor<T> *B, Tensor<T> *C, unsigned int &M, unsigned int &N, unsigned int &K, bool trans_A, bool trans_B) {
 	// must have same memory types
 	assert( A->get_memory_type() == B->get_memory_type() );
 	assert( B->get_memory_type() == C->get_memory_type() );
@@ -22,94 +22,191 @@ bool gemm_check(Tensor<T> *A, Tensor<T> *B, Tensor<T> *C, unsigned int &M, unsig
 	assert( B->get_shape().size() == 2 );
 	assert( C->get_shape().size() == 2 );
 
-	// A: MxK  B: KxN  C: MxN
-	M = A->get_shape(0);
-	K = A->get_shape(1);
-	N = B->get_shape(1);
+	// op(A): MxK  op(B): KxN  C: MxN
+	M = A->get_shape((trans_A) ? 1 : 0);
+	K = A->get_shape((trans_A) ? 0 : 1);
+	N = B->get_shape((trans_B) ? 0 : 1);
 
 	// valid shapes
-	assert( B->get_shape(0) == K );
+	assert( B->get_shape((trans_B) ? 1 : 0) == K );
 	assert( C->get_shape(0) == M );
 	assert( C->get_shape(1) == N );
 
 	return true;
 }
 
+/* A matrix view goes to blas as is if one of its strides is 1. With a unit row stride it is the transpose
+   of a row-major matrix, so it is passed with the opposite trans flag. blas takes int leading dimensions,
+   so views with longer strides are copied. */
+template <typename T>
+static bool gemm_layout(Tensor<T> *X, bool &trans, size_t &ld) {
+	unsigned int rows = X->get_shape(0), cols = X->get_shape(1);
+	size_t row_stride = X->get_stride(0), col_stride = X->get_stride(1);
+
+	if (row_stride > (size_t) INT_MAX || col_stride > (size_t) INT_MAX) return false;
+
+	if ((col_stride == 1 || cols == 1) && (rows == 1 || row_stride >= cols)) {
+		ld = (rows == 1) ? (size_t) std::max(cols, 1u) : row_stride;
+		return true;
+	}
+	if ((row_stride == 1 || rows == 1) && (cols == 1 || col_stride >= rows)) {
+		trans = !trans;
+		ld = (cols == 1) ? (size_t) std::max(rows, 1u) : col_stride;
+		return true;
+	}
+	return false;
+}
+
+/* Returns X, or a contiguous copy of X if blas can't take its strides. Copies are deleted by the caller. */
+template <typename T>
+static Tensor<T> *gemm_operand(Tensor<T> *X, bool &trans, size_t &ld) {
+	Tensor<T> *gathered;
+
+	if (gemm_layout(X, trans, ld)) return X;
+
+	gathered = new Tensor<T> (X->get_shape(), {NONE, {}}, X->get_memory_type());
+	gathered->copy_from(*X);
+	gemm_layout(gathered, trans, ld);
+	return gathered;
+}
+
 /* INT */
 template <>
-void gemm_full(int alpha, Tensor<int> *A, Tensor<int> *B, int beta, Tensor<int> *C) {
+void gemm_full(int alpha, bool trans_A, Tensor<int> *A, bool trans_B, Tensor<int> *B, int beta, Tensor<int> *C) {
 	unsigned int M, N, K;
-	if (!gemm_check(A, B, C, M, N, K)) return;
-
-	// standard O(MNK) gemm algorithm
-	// TODO: replace with strassen
-	for (int i = 0; i < (int)M; i++) {
-		for (int j = 0; j < (int)N; j++) {
-			int sum = 0;
-			for (int k = 0; k < (int)K; k++) {
-				sum = sum + alpha*(A->get({i,k}) * B->get({k,j}));
+	if (!gemm_check(A, B, C, M, N, K, trans_A, trans_B)) return;
+
+	if (A->get_memory_type() == HOST) {
+		size_t lda, ldb, ldc;
+		bool trans_C = false;
+
+		if (!gemm_layout(C, trans_C, ldc) || trans_C) {
+			std::fprintf(stderr, "gemm output must be stored row by row.\n");
+			return;
+		}
+
+		Tensor<int> *A_use = gemm_operand(A, trans_A, lda);
+		Tensor<int> *B_use = gemm_operand(B, trans_B, ldb);
+
+		// blocked and packed kernel on the raw row-major arrays
+		igemm(trans_A, trans_B,
+			M, N, K,
+			alpha, A_use->get_ptr(), lda,
+			B_use->get_ptr(), ldb, beta,
+			C->get_ptr(), ldc);
+
+		if (A_use != A) delete A_use;
+		if (B_use != B) delete B_use;
+	} else {
+		// standard O(MNK) gemm algorithm
+		for (int i = 0; i < (int)M; i++) {
+			for (int j = 0; j < (int)N; j++) {
+				int sum = 0;
+				for (int k = 0; k < (int)K; k++) {
+					int a_ik = (trans_A) ? A->get({k,i}) : A->get({i,k});
+					int b_kj = (trans_B) ? B->get({j,k}) : B->get({k,j});
+					sum = sum + alpha*(a_ik * b_kj);
+				}
+				C->set({i,j}, sum + beta*C->get({i,j}));
 			}
-			C->set({i,j}, sum + beta*C->get({i,j}));
 		}
-	} 
+	}
 }
 
 /* FLOAT */
 template <>
-void gemm_full(float alpha, Tensor<float> *A, Tensor<float> *B, float beta, Tensor<float> *C) {
+void gemm_full(float alpha, bool trans_A, Tensor<float> *A, bool trans_B, Tensor<float> *B, float beta, Tensor<float> *C) {
 	unsigned int M, N, K;
-	if (!gemm_check(A, B, C, M, N, K)) return;
+	if (!gemm_check(A, B, C, M, N, K, trans_A, trans_B)) return;
 
 	// A: MxK  B: KxN  C: MxN
 	// (MxR)(RxN) + (MxN) = (MxN) + (MxN) = (MxN)
 
+	size_t lda, ldb, ldc;
+	bool trans_C = false;
+
+	// views are passed with their leading dimensions, so only C has to be stored row by row
+	if (!gemm_layout(C, trans_C, ldc) || trans_C) {
+		std::fprintf(stderr, "gemm output must be stored row by row.\n");
+		return;
+	}
+
+	Tensor<float> *A_use = gemm_operand(A, trans_A, lda);
+	Tensor<float> *B_use = gemm_operand(B, trans_B, ldb);
+
 	if (A->get_memory_type() == HOST) {
 		// specify ROW MAJOR, since tensors are stored in row-major
-		cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, 
+		cblas_sgemm(CblasRowMajor, (trans_A) ? CblasTrans : CblasNoTrans, (trans_B) ? CblasTrans : CblasNoTrans,
 			M, N, K,
-			alpha, A->get_ptr(), K,
-			B->get_ptr(), N, beta,
-			C->get_ptr(), N);
+			alpha, A_use->get_ptr(), lda,
+			B_use->get_ptr(), ldb, beta,
+			C->get_ptr(), ldc);
 	}
 	#if defined(_HAS_CUDA_)
 	else {
 		// since magma is column-major we'll need the transpose of everything
 		// i.e. (AB)^T = (C)^T and the fact that (AB)^T = (B^T)(A^T)
-		magma_sgemm(MagmaNoTrans, MagmaNoTrans,
+		magma_sgemm((trans_B) ? MagmaTrans : MagmaNoTrans, (trans_A) ? MagmaTrans : MagmaNoTrans,
 			N, M, K,
-			alpha, B->get_ptr(), N,
-			A->get_ptr(), K,
-			beta, C->get_ptr(), N);
+			alpha, B_use->get_ptr(), ldb,
+			A_use->get_ptr(), lda,
+			beta, C->get_ptr(), ldc);
 	}
 	#endif
+
+	if (A_use != A) delete A_use;
+	if (B_use != B) delete B_use;
 }
 
 /* DOUBLE */
 template <>
-void gemm_full(double alpha, Tensor<double> *A, Tensor<double> *B, double beta, Tensor<double> *C) {
+void gemm_full(double alpha, bool trans_A, Tensor<double> *A, bool trans_B, Tensor<double> *B, double beta, Tensor<double> *C) {
 	unsigned int M, N, K;
-	if (!gemm_check(A, B, C, M, N, K)) return;
+	if (!gemm_check(A, B, C, M, N, K, trans_A, trans_B)) return;
+
+	size_t lda, ldb, ldc;
+	bool trans_C = false;
+
+	// views are passed with their leading dimensions, so only C has to be stored row by row
+	if (!gemm_layout(C, trans_C, ldc) || trans_C) {
+		std::fprintf(stderr, "gemm output must be stored row by row.\n");
+		return;
+	}
+
+	Tensor<double> *A_use = gemm_operand(A, trans_A, lda);
+	Tensor<double> *B_use = gemm_operand(B, trans_B, ldb);
 
 	if (A->get_memory_type() == HOST) {
 		// specify ROW MAJOR, since tensors are stored in row-major
-		cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, 
+		cblas_dgemm(CblasRowMajor, (trans_A) ? CblasTrans : CblasNoTrans, (trans_B) ? CblasTrans : CblasNoTrans,
 			M, N, K,
-			alpha, A->get_ptr(), K,
-			B->get_ptr(), N, beta,
-			C->get_ptr(), N);
+			alpha, A_use->get_ptr(), lda,
+			B_use->get_ptr(), ldb, beta,
+			C->get_ptr(), ldc);
 	}
 	#if defined(_HAS_CUDA_)
 	else {	
 		// since magma is column-major we'll need the transpose of everything
 		// i.e. (AB)^T = (C)^T and the fact that (AB)^T = (B^T)(A^T)
-		magma_dgemm(MagmaNoTrans, MagmaNoTrans,
+		magma_dgemm((trans_B) ? MagmaTrans : MagmaNoTrans, (trans_A) ? MagmaTrans : MagmaNoTrans,
 			N, M, K,
-			alpha, B->get_ptr(), N,
-			A->get_ptr(), K,
-			beta, C->get_ptr(), N);
+			alpha, B_use->get_ptr(), ldb,
+			A_use->get_ptr(), lda,
+			beta, C->get_ptr(), ldc);
 	}
-	#endif	
+	#endif
+
+	if (A_use != A) delete A_use;
+	if (B_use != B) delete B_use;	
+}
+
+template <typename T>
+void gemm_full(T alpha, Tensor<T> *A, Tensor<T> *B, T beta, Tensor<T> *C) {
+	gemm_full(alpha, false, A, false, B, beta, C);
 }
+template void gemm_full(int alpha, Tensor<int> *A, Tensor<int> *B, int beta, Tensor<int> *C);
+template void gemm_full(float alpha, Tensor<float> *A, Tensor<float> *B, float beta, Tensor<float> *C);
+template void gemm_full(double alpha, Tensor<double> *A, Tensor<double> *B, double beta, Tensor<double> *C);
 
 }   // namespace internal
 }   // namespace magmadnn
@@ -0,0 +1,50 @@
+/**
+ * @file igemm_avx2.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-08
+ *
+ * AVX2 integer gemm micro-kernel. Everything in this file is compiled for AVX2, so it is only
+ * called after checking that the CPU supports it.
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "compute/matmul/igemm_internal.h"
+
+#if defined(MAGMADNN_VMATH_X86)
+#pragma GCC target("avx2")
+#include <immintrin.h>
+
+namespace magmadnn {
+namespace internal {
+
+void igemm_kernel_avx2(unsigned int kc, const int *a, const int *b, int *acc) {
+    /* each row of the tile is two registers of 8 ints */
+    __m256i c[IGEMM_MR][2];
+
+    for (unsigned int i = 0; i < IGEMM_MR; i++) {
+        c[i][0] = _mm256_setzero_si256();
+        c[i][1] = _mm256_setzero_si256();
+    }
+
+    for (unsigned int p = 0; p < kc; p++) {
+        __m256i b0 = _mm256_loadu_si256((const __m256i *) (b + p * IGEMM_NR));
+        __m256i b1 = _mm256_loadu_si256((const __m256i *) (b + p * IGEMM_NR + 8));
+
+        for (unsigned int i = 0; i < IGEMM_MR; i++) {
+            __m256i a_ip = _mm256_set1_epi32(a[p * IGEMM_MR + i]);
+            c[i][0] = _mm256_add_epi32(c[i][0], _mm256_mullo_epi32(a_ip, b0));
+            c[i][1] = _mm256_add_epi32(c[i][1], _mm256_mullo_epi32(a_ip, b1));
+        }
+    }
+
+    for (unsigned int i = 0; i < IGEMM_MR; i++) {
+        _mm256_storeu_si256((__m256i *) (acc + i * IGEMM_NR), c[i][0]);
+        _mm256_storeu_si256((__m256i *) (acc + i * IGEMM_NR + 8), c[i][1]);
+    }
+}
+
+}   // namespace internal
+}   // namespace magmadnn
+
+#endif
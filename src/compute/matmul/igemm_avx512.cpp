@@ -0,0 +1,45 @@
+/**
+ * @file igemm_avx512.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-08
+ *
+ * AVX-512F integer gemm micro-kernel. Everything in this file is compiled for AVX-512F, so it is
+ * only called after checking that the CPU supports it.
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "compute/matmul/igemm_internal.h"
+
+#if defined(MAGMADNN_VMATH_X86)
+#pragma GCC target("avx512f")
+
+/* the AVX-512 intrinsics start from _mm512_undefined_*, which gcc reports as uninitialized */
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include <immintrin.h>
+
+namespace magmadnn {
+namespace internal {
+
+void igemm_kernel_avx512(unsigned int kc, const int *a, const int *b, int *acc) {
+    /* each row of the tile is one register of 16 ints */
+    __m512i c[IGEMM_MR];
+
+    for (unsigned int i = 0; i < IGEMM_MR; i++) c[i] = _mm512_setzero_si512();
+
+    for (unsigned int p = 0; p < kc; p++) {
+        __m512i b0 = _mm512_loadu_si512((const void *) (b + p * IGEMM_NR));
+
+        for (unsigned int i = 0; i < IGEMM_MR; i++) {
+            c[i] = _mm512_add_epi32(c[i], _mm512_mullo_epi32(_mm512_set1_epi32(a[p * IGEMM_MR + i]), b0));
+        }
+    }
+
+    for (unsigned int i = 0; i < IGEMM_MR; i++) _mm512_storeu_si512((void *) (acc + i * IGEMM_NR), c[i]);
+}
+
+}   // namespace internal
+}   // namespace magmadnn
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * @file igemm_internal.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-08
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "compute/matmul/igemm_internal.h"
+
+namespace magmadnn {
+namespace internal {
+
+typedef void (*igemm_kernel_t)(unsigned int, const int *, const int *, int *);
+
+static igemm_kernel_t igemm_get_kernel() {
+    #if defined(MAGMADNN_VMATH_X86)
+    switch (vmath_get_isa()) {
+        case VMATH_AVX512:
+            return igemm_kernel_avx512;
+        case VMATH_AVX2:
+            return igemm_kernel_avx2;
+        default:
+            break;
+    }
+    #endif
+    return igemm_kernel_generic;
+}
+
+void igemm_kernel_generic(unsigned int kc, const int *a, const int *b, int *acc) {
+    /* unsigned so that overflow wraps like the vector instructions */
+    unsigned int c[IGEMM_MR * IGEMM_NR] = {0};
+
+    for (unsigned int p = 0; p < kc; p++) {
+        for (unsigned int i = 0; i < IGEMM_MR; i++) {
+            unsigned int a_ip = (unsigned int) a[p * IGEMM_MR + i];
+            for (unsigned int j = 0; j < IGEMM_NR; j++) {
+                c[i * IGEMM_NR + j] += a_ip * (unsigned int) b[p * IGEMM_NR + j];
+            }
+        }
+    }
+
+    for (unsigned int i = 0; i < IGEMM_MR * IGEMM_NR; i++) acc[i] = (int) c[i];
+}
+
+/* packs rows [0,mc) and columns [0,kc) of A into panels of IGEMM_MR rows, stored column by column.
+   element (i,p) of A is A[i*rs + p*cs]. the last panel is padded with zeros. */
+static void igemm_pack_a(unsigned int mc, unsigned int kc, const int *A, size_t rs, size_t cs, int *packed) {
+    for (unsigned int ir = 0; ir < mc; ir += IGEMM_MR) {
+        unsigned int mr = std::min((unsigned int) IGEMM_MR, mc - ir);
+
+        for (unsigned int p = 0; p < kc; p++) {
+            for (unsigned int i = 0; i < IGEMM_MR; i++) {
+                *packed++ = (i < mr) ? A[(size_t) (ir + i) * rs + (size_t) p * cs] : 0;
+            }
+        }
+    }
+}
+
+/* packs rows [0,kc) and columns [0,nc) of B into panels of IGEMM_NR columns, stored row by row.
+   element (p,j) of B is B[p*rs + j*cs]. the last panel is padded with zeros. */
+static void igemm_pack_b(unsigned int kc, unsigned int nc, const int *B, size_t rs, size_t cs, int *packed) {
+    for (unsigned int jr = 0; jr < nc; jr += IGEMM_NR) {
+        unsigned int nr = std::min((unsigned int) IGEMM_NR, nc - jr);
+
+        for (unsigned int p = 0; p < kc; p++) {
+            const int *row = B + (size_t) p * rs + (size_t) jr * cs;
+            for (unsigned int j = 0; j < IGEMM_NR; j++) {
+                *packed++ = (j < nr) ? row[(size_t) j * cs] : 0;
+            }
+        }
+    }
+}
+
+void igemm(bool trans_A, bool trans_B, unsigned int M, unsigned int N, unsigned int K, int alpha,
+    const int *A, size_t lda, const int *B, size_t ldb, int beta, int *C, size_t ldc) {
+
+    /* a transposed matrix is packed by walking it with its strides swapped */
+    size_t a_rs = (trans_A) ? 1 : lda, a_cs = (trans_A) ? lda : 1;
+    size_t b_rs = (trans_B) ? 1 : ldb, b_cs = (trans_B) ? ldb : 1;
+
+    igemm_kernel_t kernel = igemm_get_kernel();
+    unsigned int max_mc = std::min((unsigned int) IGEMM_MC, M);
+    unsigned int max_kc = std::min((unsigned int) IGEMM_KC, K);
+    unsigned int max_nc = std::min((unsigned int) IGEMM_NC, N);
+
+    /* panels are padded to whole tiles */
+    std::vector<int> packed_a (((max_mc + IGEMM_MR - 1) / IGEMM_MR) * IGEMM_MR * max_kc);
+    std::vector<int> packed_b (((max_nc + IGEMM_NR - 1) / IGEMM_NR) * IGEMM_NR * max_kc);
+    int acc[IGEMM_MR * IGEMM_NR];
+
+    /* C = beta*C first, so each block of K only has to add to it */
+    for (unsigned int i = 0; i < M; i++) {
+        for (unsigned int j = 0; j < N; j++) {
+            C[(size_t) i * ldc + j] = (beta == 0) ? 0 : (int) ((unsigned int) beta * (unsigned int) C[(size_t) i * ldc + j]);
+        }
+    }
+    if (alpha == 0) return;
+
+    for (unsigned int jc = 0; jc < N; jc += IGEMM_NC) {
+        unsigned int nc = std::min((unsigned int) IGEMM_NC, N - jc);
+
+        for (unsigned int pc = 0; pc < K; pc += IGEMM_KC) {
+            unsigned int kc = std::min((unsigned int) IGEMM_KC, K - pc);
+
+            igemm_pack_b(kc, nc, B + (size_t) pc * b_rs + (size_t) jc * b_cs, b_rs, b_cs, packed_b.data());
+
+            for (unsigned int ic = 0; ic < M; ic += IGEMM_MC) {
+                unsigned int mc = std::min((unsigned int) IGEMM_MC, M - ic);
+
+                igemm_pack_a(mc, kc, A + (size_t) ic * a_rs + (size_t) pc * a_cs, a_rs, a_cs, packed_a.data());
+
+                for (unsigned int jr = 0; jr < nc; jr += IGEMM_NR) {
+                    unsigned int nr = std::min((unsigned int) IGEMM_NR, nc - jr);
+
+                    for (unsigned int ir = 0; ir < mc; ir += IGEMM_MR) {
+                        unsigned int mr = std::min((unsigned int) IGEMM_MR, mc - ir);
+                        int *c = C + (size_t) (ic + ir) * ldc + jc + jr;
+
+                        kernel(kc, &packed_a[(size_t) ir * kc], &packed_b[(size_t) jr * kc], acc);
+
+                        for (unsigned int i = 0; i < mr; i++) {
+                            for (unsigned int j = 0; j < nr; j++) {
+                                c[(size_t) i * ldc + j] = (int) ((unsigned int) c[(size_t) i * ldc + j] + (unsigned int) alpha * (unsigned int) acc[i * IGEMM_NR + j]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+}   // namespace internal
+}   // namespace magmadnn
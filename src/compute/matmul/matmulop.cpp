@@ -12,8 +12,10 @@ namespace magmadnn {
 namespace op {
 
 template <typename T>
-MatmulOp<T>::MatmulOp(T alpha, Operation<T>* a, Operation<T>* b, T beta, Operation<T> *c, bool copy, bool needs_grad) : 
-		Operation<T>::Operation({a,b,c}, needs_grad), a(a), b(b), c(c), alpha(alpha), beta(beta), copy(copy) {
+MatmulOp<T>::MatmulOp(T alpha, Operation<T>* a, Operation<T>* b, T beta, Operation<T> *c, bool copy, bool needs_grad,
+		bool trans_a, bool trans_b) : 
+		Operation<T>::Operation({a,b,c}, needs_grad), a(a), b(b), c(c), alpha(alpha), beta(beta), copy(copy),
+		trans_a(trans_a), trans_b(trans_b) {
 
     unsigned int M, N, K;
 
@@ -26,13 +28,13 @@ MatmulOp<T>::MatmulOp(T alpha, Operation<T>* a, Operation<T>* b, T beta, Operati
 	assert( b->get_output_shape().size() == 2 );
 	assert( c->get_output_shape().size() == 2 );
 
-	// A: MxK  B: KxN  C: MxN
-	M = a->get_output_shape(0);
-	K = a->get_output_shape(1);
-	N = b->get_output_shape(1);
+	// op(A): MxK  op(B): KxN  C: MxN
+	M = a->get_output_shape((trans_a) ? 1 : 0);
+	K = a->get_output_shape((trans_a) ? 0 : 1);
+	N = b->get_output_shape((trans_b) ? 0 : 1);
 
 	// valid shapes
-	assert( b->get_output_shape(0) == K );
+	assert( b->get_output_shape((trans_b) ? 1 : 0) == K );
 	assert( c->get_output_shape(0) == M );
 	assert( c->get_output_shape(1) == N );
 
@@ -46,14 +48,12 @@ MatmulOp<T>::MatmulOp(T alpha, Operation<T>* a, Operation<T>* b, T beta, Operati
 }
 
 template <typename T>
-Tensor<T>* MatmulOp<T>::eval(bool recompute) {
+Tensor<T>* MatmulOp<T>::_eval(bool recompute) {
     
-    if (!recompute && this->ret != NULL) {
-        return this->ret;
-    }
 
-	a_tensor = a->eval(recompute);    // MxK
-	b_tensor = b->eval(recompute);    // KxN
+	/* gemm takes strided views, so lazy transposes and slices are not copied */
+	a_tensor = a->eval_view(recompute);    // MxK, or KxM if trans_a
+	b_tensor = b->eval_view(recompute);    // KxN, or NxK if trans_b
     c_tensor = c->eval(recompute);
 
     if (copy) {
@@ -62,18 +62,29 @@ Tensor<T>* MatmulOp<T>::eval(bool recompute) {
         this->ret = c_tensor;
     }
 
-    internal::gemm_full(alpha, a_tensor, b_tensor, beta, this->ret);
+    internal::gemm_full(alpha, trans_a, a_tensor, trans_b, b_tensor, beta, this->ret);
 
     return this->ret;
 } 
 
 template <typename T>
 Operation<T> *MatmulOp<T>::grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad) {
-    /* wrt a: dot(grad, B^T)  |  wrt b: dot(a^T, grad) */
+    /* wrt a: grad op(B)^T, or op(B) grad^T if a is transposed
+       wrt b: op(A)^T grad, or grad^T op(A) if b is transposed.
+       the transposes are passed on to gemm, so none of them are formed */
+    if (grad->get_output_shape().size() != 2) {
+        /* a scalar grad (i.e. the seed of the grad graph) just scales op(B)^T or op(A)^T. there is no
+           product for gemm to fold the transpose into, so the scalar product writes it out directly. */
+        if (var == a) return scalarproduct(grad, b, true, false, !trans_b);
+        return scalarproduct(grad, a, true, false, !trans_a);
+    }
+
     if (var == a) {
-        return dot(grad, transpose(b, true, false), true, false);
+        if (trans_a) return matmul(b, trans_b, grad, true, false);
+        return matmul(grad, false, b, !trans_b, false);
     } else {
-        return dot(transpose(a, true, false), grad, true, false);
+        if (trans_b) return matmul(grad, true, a, trans_a, false);
+        return matmul(a, !trans_a, grad, false, false);
     }
 }
 template class MatmulOp<int>;
@@ -95,6 +106,22 @@ template MatmulOp<int>* matmul(Operation<int> *a, Operation<int> *b, bool needs_
 template MatmulOp<float>* matmul(Operation<float> *a, Operation<float> *b, bool needs_grad);
 template MatmulOp<double>* matmul(Operation<double> *a, Operation<double> *b, bool needs_grad);
 
+template <typename T>
+MatmulOp<T>* matmul(Operation<T> *a, bool trans_a, Operation<T> *b, bool trans_b, bool needs_grad) {
+
+    assert( a->get_output_shape().size() == 2 );
+    assert( b->get_output_shape().size() == 2 );
+
+    unsigned int m = a->get_output_shape((trans_a) ? 1 : 0);
+    unsigned int n = b->get_output_shape((trans_b) ? 0 : 1);
+    Tensor<T> *c_tensor = new Tensor<T> ({m, n}, a->get_memory_type());
+    Operation<T> *c = var("__matmul_c_internal", c_tensor);
+    return new MatmulOp<T> ((T)1, a, b, (T)0, c, false, needs_grad, trans_a, trans_b);
+}
+template MatmulOp<int>* matmul(Operation<int> *a, bool trans_a, Operation<int> *b, bool trans_b, bool needs_grad);
+template MatmulOp<float>* matmul(Operation<float> *a, bool trans_a, Operation<float> *b, bool trans_b, bool needs_grad);
+template MatmulOp<double>* matmul(Operation<double> *a, bool trans_a, Operation<double> *b, bool trans_b, bool needs_grad);
+
 template <typename T>
 MatmulOp<T>* matmul(T alpha, Operation<T> *a, Operation<T> *b, T beta, Operation<T> *c, bool copy, bool needs_grad) {
     return new MatmulOp<T> (alpha, a, b, beta, c, copy);
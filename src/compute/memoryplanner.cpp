@@ -0,0 +1,185 @@
+/**
+ * @file memoryplanner.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-03
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "compute/memoryplanner.h"
+
+namespace magmadnn {
+namespace op {
+
+/* offsets into the slab are kept 64 byte aligned */
+const unsigned int MEMORY_PLAN_ALIGNMENT = 64;
+
+template <typename T>
+MemoryPlanner<T>::MemoryPlanner(const std::vector<Operation<T> *>& outputs)
+    : outputs(outputs), slab(NULL), slab_size(0), naive_bytes(0), planned_bytes(0) {
+    plan();
+}
+
+template <typename T>
+MemoryPlanner<T>::~MemoryPlanner() {
+    if (slab == NULL) return;
+
+    for (unsigned int i = 0; i < buffers.size(); i++) {
+        buffers[i].tensor->get_memory_manager()->bind_host_ptr(NULL);
+    }
+    delete slab;
+}
+
+template <typename T>
+void MemoryPlanner<T>::plan() {
+    std::map<Operation<T> *, unsigned int> pos;
+    unsigned int n, align;
+
+    internal::topological_sort(outputs, schedule);
+    n = schedule.size();
+    align = MEMORY_PLAN_ALIGNMENT / sizeof(T);
+
+    for (unsigned int i = 0; i < n; i++) pos[schedule[i]] = i;
+
+    std::vector<unsigned int> first (n), last (n), subtree_first (n);
+    std::vector<bool> is_var (n), owns (n);
+    std::vector<std::vector<unsigned int> > sources (n);
+
+    for (unsigned int i = 0; i < n; i++) {
+        Operation<T> *cur = schedule[i];
+        std::vector<Operation<T> *> const& inputs = cur->get_inputs();
+
+        is_var[i] = (dynamic_cast<Variable<T> *>(cur) != NULL);
+        first[i] = last[i] = i;
+
+        /* eval never writes to variables, so they don't count towards the positions written under i */
+        subtree_first[i] = (is_var[i]) ? n : i;
+
+        /* an operation owns its output if it allocated it itself (copy=true). Otherwise it writes
+           into one of its inputs and ret is still NULL, shared with that input or a view of it. */
+        owns[i] = !is_var[i] && cur->get_return_ptr() != NULL && !cur->get_return_ptr()->is_view();
+
+        for (unsigned int k = 0; k < inputs.size(); k++) {
+            unsigned int in = pos[inputs[k]];
+            subtree_first[i] = std::min(subtree_first[i], subtree_first[in]);
+            if (inputs[k]->get_return_ptr() == cur->get_return_ptr()) owns[i] = false;
+        }
+    }
+
+    /* an input must survive until its consumer is computed. While the consumer is evaluated it
+       also evaluates its later inputs, which may recompute anything beneath them. */
+    for (unsigned int i = 0; i < n; i++) {
+        std::vector<Operation<T> *> const& inputs = schedule[i]->get_inputs();
+
+        for (unsigned int k = 0; k < inputs.size(); k++) {
+            unsigned int in = pos[inputs[k]];
+            last[in] = std::max(last[in], i);
+
+            for (unsigned int j = k+1; j < inputs.size(); j++) {
+                first[in] = std::min(first[in], subtree_first[pos[inputs[j]]]);
+            }
+        }
+    }
+
+    /* outputs are read after evaluation */
+    for (unsigned int i = 0; i < outputs.size(); i++) {
+        if (outputs[i] != NULL) last[pos[outputs[i]]] = n;
+    }
+
+    /* an operation that writes into its inputs keeps their tensors alive for as long as it is */
+    for (unsigned int i = 0; i < n; i++) {
+        if (owns[i]) {
+            sources[i].push_back(i);
+        } else if (!is_var[i]) {
+            std::vector<Operation<T> *> const& inputs = schedule[i]->get_inputs();
+
+            for (unsigned int k = 0; k < inputs.size(); k++) {
+                std::vector<unsigned int> const& in_sources = sources[pos[inputs[k]]];
+                sources[i].insert(sources[i].end(), in_sources.begin(), in_sources.end());
+            }
+            for (unsigned int k = 0; k < sources[i].size(); k++) {
+                first[sources[i][k]] = std::min(first[sources[i][k]], first[i]);
+                last[sources[i][k]] = std::max(last[sources[i][k]], last[i]);
+            }
+        }
+    }
+
+    /* collect the tensors to place */
+    for (unsigned int i = 0; i < n; i++) {
+        if (!owns[i]) continue;
+
+        Tensor<T> *tensor = schedule[i]->get_return_ptr();
+        naive_bytes += tensor->get_size() * sizeof(T);
+
+        if (tensor->get_memory_type() != HOST) {
+            planned_bytes += tensor->get_size() * sizeof(T);
+            continue;
+        }
+
+        buffer_t buf;
+        buf.tensor = tensor;
+        buf.first = first[i];
+        buf.last = last[i];
+        buf.size = ((tensor->get_size() + align - 1) / align) * align;
+        buf.offset = 0;
+        buffers.push_back(buf);
+    }
+
+    /* place the largest tensors first. each goes into the lowest gap that doesn't overlap
+       a placed tensor whose lifetime overlaps its own. */
+    std::vector<unsigned int> by_size (buffers.size());
+    std::vector<unsigned int> placed;
+    for (unsigned int i = 0; i < by_size.size(); i++) by_size[i] = i;
+    std::stable_sort(by_size.begin(), by_size.end(), [this](unsigned int a, unsigned int b) {
+        return buffers[a].size > buffers[b].size;
+    });
+
+    for (unsigned int i = 0; i < by_size.size(); i++) {
+        buffer_t& buf = buffers[by_size[i]];
+        std::vector<unsigned int> conflicts;
+
+        for (unsigned int j = 0; j < placed.size(); j++) {
+            buffer_t const& other = buffers[placed[j]];
+            if (other.first <= buf.last && buf.first <= other.last) conflicts.push_back(placed[j]);
+        }
+        std::sort(conflicts.begin(), conflicts.end(), [this](unsigned int a, unsigned int b) {
+            return buffers[a].offset < buffers[b].offset;
+        });
+
+        size_t offset = 0;
+        for (unsigned int j = 0; j < conflicts.size(); j++) {
+            buffer_t const& other = buffers[conflicts[j]];
+            if (offset + buf.size <= other.offset) break;
+            offset = std::max(offset, other.offset + other.size);
+        }
+
+        buf.offset = offset;
+        slab_size = std::max(slab_size, offset + buf.size);
+        placed.push_back(by_size[i]);
+    }
+
+    planned_bytes += slab_size * sizeof(T);
+}
+
+template <typename T>
+magmadnn_error_t MemoryPlanner<T>::apply() {
+    magmadnn_error_t err;
+
+    if (slab != NULL || buffers.empty()) return (magmadnn_error_t) 0;
+
+    slab = new MemoryManager<T> (slab_size, HOST, (device_t) 0);
+
+    for (unsigned int i = 0; i < buffers.size(); i++) {
+        err = buffers[i].tensor->get_memory_manager()->bind_host_ptr(slab->get_host_ptr() + buffers[i].offset);
+        if (err != 0) return err;
+    }
+
+    return (magmadnn_error_t) 0;
+}
+
+template class MemoryPlanner<int>;
+template class MemoryPlanner<float>;
+template class MemoryPlanner<double>;
+
+}   // namespace op
+}   // namespace magmadnn
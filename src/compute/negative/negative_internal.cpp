@@ -9,11 +9,13 @@ void negative_full(Tensor<T> *x, Tensor<T> *out) {
     if (out->get_memory_type() == HOST) {
         T *x_ptr = x->get_ptr();
         T *out_ptr = out->get_ptr();
-        unsigned int size = out->get_size();
+        size_t size = out->get_size();
 
-        for (unsigned int i = 0; i < size; i++) {
-            out_ptr[i] = - x_ptr[i];
-        }
+        parallel::parallel_for(0, size, [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                out_ptr[i] = - x_ptr[i];
+            }
+        });
     }
     #if defined(_HAS_CUDA_)
     else {
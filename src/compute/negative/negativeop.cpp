@@ -17,11 +17,7 @@ NegativeOp<T>::NegativeOp(Operation<T> *x, bool copy, bool needs_grad)
 }
 
 template <typename T>
-Tensor<T> *NegativeOp<T>::eval(bool recompute) {
-
-    if (!recompute && this->ret != NULL) {
-        return this->ret;
-    }
+Tensor<T> *NegativeOp<T>::_eval(bool recompute) {
 
     x_tensor = x->eval(recompute);
 
@@ -0,0 +1,146 @@
+/**
+ * @file parallelexecutor.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-05
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "compute/parallelexecutor.h"
+
+namespace magmadnn {
+namespace op {
+
+template <typename T>
+ParallelExecutor<T>::ParallelExecutor(const std::vector<Operation<T> *>& outputs, parallel::ThreadPool *pool)
+    : GraphExecutor<T>::GraphExecutor(outputs, false), pool(pool), active_pool(NULL), host_only(true) {
+    unsigned int n = this->schedule.size();
+    std::vector<std::set<unsigned int> > edges (n);
+    std::vector<std::vector<unsigned int> > sources (n), holders (n);
+
+    for (unsigned int i = 0; i < n; i++) {
+        Operation<T> *cur = this->schedule[i];
+        std::vector<Operation<T> *> const& inputs = cur->get_inputs();
+        bool owns;
+
+        if (cur->get_memory_type() != HOST) host_only = false;
+
+        /* an operation owns its output if it allocated it itself. Otherwise its output is the
+           tensor of one of its inputs or a view of it, or it hasn't been created yet. */
+        owns = (dynamic_cast<Variable<T> *>(cur) != NULL) || (cur->get_return_ptr() != NULL && !cur->get_return_ptr()->is_view());
+
+        for (unsigned int k = 0; k < inputs.size(); k++) {
+            edges[this->pos[inputs[k]]].insert(i);
+            if (inputs[k]->get_return_ptr() == cur->get_return_ptr()) owns = false;
+        }
+
+        if (owns) {
+            sources[i].push_back(i);
+        } else {
+            std::set<unsigned int> s;
+            for (unsigned int k = 0; k < inputs.size(); k++) {
+                std::vector<unsigned int> const& in_sources = sources[this->pos[inputs[k]]];
+                s.insert(in_sources.begin(), in_sources.end());
+            }
+            sources[i].assign(s.begin(), s.end());
+        }
+
+        for (unsigned int k = 0; k < sources[i].size(); k++) holders[sources[i][k]].push_back(i);
+    }
+
+    /* a non-copy operation writes into the tensors it takes its output from. Everything else that
+       holds or reads those tensors has to stay on the same side of it as in the serial order. */
+    for (unsigned int i = 0; i < n; i++) {
+        if (sources[i].size() == 1 && sources[i][0] == i) continue;
+
+        std::set<unsigned int> touched;
+        for (unsigned int k = 0; k < sources[i].size(); k++) {
+            std::vector<unsigned int> const& h = holders[sources[i][k]];
+
+            for (unsigned int j = 0; j < h.size(); j++) {
+                touched.insert(h[j]);
+                touched.insert(this->consumers[h[j]].begin(), this->consumers[h[j]].end());
+            }
+        }
+
+        for (typename std::set<unsigned int>::iterator it = touched.begin(); it != touched.end(); it++) {
+            if (*it < i) {
+                edges[*it].insert(i);
+            } else if (*it > i) {
+                edges[i].insert(*it);
+            }
+        }
+    }
+
+    /* every edge points forward in the schedule, so there are no cycles */
+    succs.resize(n);
+    preds.resize(n);
+    for (unsigned int i = 0; i < n; i++) {
+        for (typename std::set<unsigned int>::iterator it = edges[i].begin(); it != edges[i].end(); it++) {
+            succs[i].push_back(*it);
+            preds[*it].push_back(i);
+        }
+    }
+
+    n_waiting.reset(new std::atomic<unsigned int>[n]);
+}
+
+template <typename T>
+magmadnn_error_t ParallelExecutor<T>::run() {
+    unsigned int n = this->schedule.size();
+    std::vector<unsigned int> ready;
+    parallel::TaskGroup group;
+
+    active_pool = (pool != NULL) ? pool : parallel::get_default_thread_pool();
+    if (!host_only || active_pool->get_n_threads() == 1) return GraphExecutor<T>::run();
+
+    stale.assign(n, false);
+    for (unsigned int i = 0; i < n; i++) stale[i] = !this->schedule[i]->is_computed();
+
+    for (unsigned int i = 0; i < n; i++) {
+        unsigned int count = 0;
+        for (unsigned int k = 0; k < preds[i].size(); k++) {
+            if (stale[preds[i][k]]) count++;
+        }
+        n_waiting[i] = count;
+        if (stale[i] && count == 0) ready.push_back(i);
+    }
+
+    n_done = 0;
+    failed = false;
+
+    /* start with the stale operations whose inputs are all ready. the rest are submitted by the
+       last of their inputs to finish. */
+    for (unsigned int i = 0; i < ready.size(); i++) {
+        unsigned int idx = ready[i];
+        active_pool->submit(group, [this, idx, &group]() { this->run_node(idx, group); });
+    }
+    active_pool->wait(group);
+
+    this->n_evaluated = n_done;
+    return (failed) ? (magmadnn_error_t) 1 : (magmadnn_error_t) 0;
+}
+
+template <typename T>
+void ParallelExecutor<T>::run_node(unsigned int idx, parallel::TaskGroup& group) {
+
+    if (!failed) {
+        if (this->schedule[idx]->eval(false) == NULL) failed = true;
+        n_done++;
+    }
+
+    for (unsigned int k = 0; k < succs[idx].size(); k++) {
+        unsigned int next = succs[idx][k];
+
+        if (stale[next] && --n_waiting[next] == 0) {
+            active_pool->submit(group, [this, next, &group]() { this->run_node(next, group); });
+        }
+    }
+}
+
+template class ParallelExecutor<int>;
+template class ParallelExecutor<float>;
+template class ParallelExecutor<double>;
+
+}   // namespace op
+}   // namespace magmadnn
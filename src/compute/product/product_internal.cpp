@@ -18,10 +18,13 @@ void product_full(T alpha, Tensor<T> *a, Tensor<T> *b, Tensor<T> *out) {
         T *a_ptr = a->get_ptr();
         T *b_ptr = b->get_ptr();
         T *out_ptr = out->get_ptr();
-        unsigned int size = out->get_size();
-        for (unsigned int i = 0; i < size; i++) {
-            out_ptr[i] = alpha * a_ptr[i] * b_ptr[i];
-        }
+        size_t size = out->get_size();
+
+        parallel::parallel_for(0, size, [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                out_ptr[i] = alpha * a_ptr[i] * b_ptr[i];
+            }
+        });
     }
     #if defined(_HAS_CUDA_)
     else {
@@ -41,10 +44,13 @@ void scalar_tensor_product_full(T scalar, Tensor<T> *a, Tensor<T> *out) {
     if (out->get_memory_type() == HOST) {
         T *a_ptr = a->get_ptr();
         T *out_ptr = out->get_ptr();
-        unsigned int size = out->get_size();
-        for (unsigned int i = 0; i < size; i++) {
-            out_ptr[i] = scalar * a_ptr[i];
-        }
+        size_t size = out->get_size();
+
+        parallel::parallel_for(0, size, [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                out_ptr[i] = scalar * a_ptr[i];
+            }
+        });
     }
     #if defined(_HAS_CUDA_)
     else {
@@ -12,11 +12,11 @@ namespace magmadnn {
 namespace internal {
 
 template <typename T>
-__global__ void kernel_product_full_device(T alpha, T *a, T *b, T *out, unsigned int arr_size) {
-    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-    unsigned int stride = blockDim.x * gridDim.x;
+__global__ void kernel_product_full_device(T alpha, T *a, T *b, T *out, size_t arr_size) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
 
-    for (unsigned int i = idx; i < arr_size; i += stride) {
+    for (size_t i = idx; i < arr_size; i += stride) {
         out[i] = a[i] * b[i];
     }
 }
@@ -31,18 +31,18 @@ template void product_full_device(double alpha, Tensor<double> *a, Tensor<double
 
 
 template <typename T>
-__global__ void kernel_scalar_tensor_product_full_device(T scalar, T *a, T *out, unsigned int arr_size) {
-    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-    unsigned int stride = blockDim.x * gridDim.x;
+__global__ void kernel_scalar_tensor_product_full_device(T scalar, T *a, T *out, size_t arr_size) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
 
-    for (unsigned int i = idx; i < arr_size; i += stride) {
+    for (size_t i = idx; i < arr_size; i += stride) {
         out[i] = scalar * a[i];
     }
 }
 
 template <typename T>
 void scalar_tensor_product_full_device(T scalar, Tensor<T> *a, Tensor<T> *out) {
-    unsigned int size = out->get_size();
+    size_t size = out->get_size();
     kernel_scalar_tensor_product_full_device <<< 1, size >>> (scalar, a->get_ptr(), out->get_ptr(), size);
 }
 template void scalar_tensor_product_full_device(int scalar, Tensor<int> *a, Tensor<int> *out);
@@ -14,62 +14,44 @@ namespace op {
 template <typename T>
 ProductOp<T>::ProductOp(T alpha, Operation<T> *a, Operation<T> *b, bool copy, bool needs_grad)
     : Operation<T>::Operation({a,b}, needs_grad), alpha(alpha), a(a), b(b), copy(copy) {
-    
-    if (a->get_output_size() == 1) {
-        op_type = internal::SCALAR_PROD_TENSOR;
-        this->output_shape = b->get_output_shape();
-    } else if (b->get_output_size() == 1) {
-        op_type = internal::TENSOR_PROD_SCALAR;
-        this->output_shape = a->get_output_shape();
-    } else {
-        assert( a->get_output_size() == b->get_output_size() );
-        op_type = internal::TENSOR_PROD_TENSOR;
-        this->output_shape = a->get_output_shape();
+
+    assert( a->get_memory_type() == b->get_memory_type() );
+
+    if (!internal::broadcast_shape(a->get_output_shape(), b->get_output_shape(), this->output_shape)) {
+        std::fprintf(stderr, "Error: can not broadcast the operands of product.\n");
+        assert( false );
     }
+    /* without copy the result goes into whichever operand has its shape */
+    assert( copy || a->get_output_shape() == this->output_shape || b->get_output_shape() == this->output_shape );
+
     this->mem_type = a->get_memory_type();
 
     if (copy) {
-        this->ret = new Tensor<T> (this->output_shape, {ONE, {}}, this->mem_type);
+        this->ret = new Tensor<T> (this->output_shape, {NONE, {}}, this->mem_type);
     }
 }
 
 template <typename T>
-Tensor<T> *ProductOp<T>::eval(bool recompute) {
-
-    if (!recompute && this->ret != NULL) {
-        return this->ret;
-    }
+Tensor<T> *ProductOp<T>::_eval(bool recompute) {
 
     a_tensor = a->eval(recompute);
     b_tensor = b->eval(recompute);
     
     if (!copy) {
-        if (op_type == internal::TENSOR_PROD_SCALAR) {
-            this->ret = a_tensor;
-        } else {
-            this->ret = b_tensor;
-        }
+        this->ret = (b->get_output_shape() == this->output_shape) ? b_tensor : a_tensor;
     }
 
-    switch (op_type) {
-        case internal::SCALAR_PROD_TENSOR:
-            a_tensor->get_memory_manager()->sync(true);
-            internal::scalar_tensor_product_full(alpha * a_tensor->get(0), b_tensor, this->ret); break;
-        case internal::TENSOR_PROD_SCALAR:
-            b_tensor->get_memory_manager()->sync(true);
-            internal::scalar_tensor_product_full(alpha * b_tensor->get(0), a_tensor, this->ret); break;
-        case internal::TENSOR_PROD_TENSOR:
-            internal::product_full(alpha, a_tensor, b_tensor, this->ret); break;
-        default:
-            internal::debugf("INVALID PRODUCT\n");
-    }
+    internal::broadcast_full(internal::BROADCAST_MUL, alpha, a_tensor, (T) 0, b_tensor, this->ret);
 
     return this->ret;
 }
 
 template <typename T>
 Operation<T> *ProductOp<T>::grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad) {
-    return NULL;
+    /* wrt a: alpha grad b, wrt b: alpha grad a. each summed over the axes it was broadcast along. */
+    Operation<T> *other = (var == a) ? b : a;
+
+    return reducesum_to(product(alpha, grad, other, true, false), var->get_output_shape(), this->output_shape);
 }
 template class ProductOp<int>;
 template class ProductOp<float>;
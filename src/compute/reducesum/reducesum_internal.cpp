@@ -4,11 +4,221 @@
 namespace magmadnn {
 namespace internal {
 
+/* contiguous rows shorter than this are summed directly by the pairwise mode */
+#define REDUCE_PAIRWISE_BLOCK 128
+
+/* number of independent running sums in a contiguous sum. lets the compiler use the vector units
+   without reassociating the additions itself. */
+#define REDUCE_LANES 8
+
+/* sum of n contiguous values */
+template <typename T>
+static T sum_contiguous(size_t n, const T *x, reduce_sum_mode_t mode) {
+    T lanes[REDUCE_LANES] = {0};
+    size_t i = 0;
+
+    if (mode == REDUCE_SUM_PAIRWISE && n > REDUCE_PAIRWISE_BLOCK) {
+        size_t half = ((n / 2) + REDUCE_LANES - 1) / REDUCE_LANES * REDUCE_LANES;
+        return sum_contiguous(half, x, mode) + sum_contiguous(n - half, x + half, mode);
+    }
+
+    if (mode == REDUCE_SUM_KAHAN) {
+        T comp[REDUCE_LANES] = {0};
+        T sum = (T) 0, c = (T) 0;
+
+        for (; i + REDUCE_LANES <= n; i += REDUCE_LANES) {
+            for (unsigned int k = 0; k < REDUCE_LANES; k++) {
+                T y = x[i+k] - comp[k];
+                T t = lanes[k] + y;
+                comp[k] = (t - lanes[k]) - y;
+                lanes[k] = t;
+            }
+        }
+        for (; i < n; i++) {
+            T y = x[i] - c;
+            T t = sum + y;
+            c = (t - sum) - y;
+            sum = t;
+        }
+        for (unsigned int k = 0; k < REDUCE_LANES; k++) {
+            T y = lanes[k] - (comp[k] + c);
+            T t = sum + y;
+            c = (t - sum) - y;
+            sum = t;
+        }
+        return sum;
+    }
+
+    for (; i + REDUCE_LANES <= n; i += REDUCE_LANES) {
+        for (unsigned int k = 0; k < REDUCE_LANES; k++) lanes[k] += x[i+k];
+    }
+    for (; i < n; i++) lanes[0] += x[i];
+
+    for (unsigned int k = 1; k < REDUCE_LANES; k++) lanes[0] += lanes[k];
+    return lanes[0];
+}
+
+/* out[j] = sum over rows [l0,l1) of x[l*inner + j] for j in [j0,j1). comp is scratch for the Kahan mode. */
+template <typename T>
+static void sum_rows(size_t l0, size_t l1, size_t inner, size_t j0, size_t j1, const T *x, T *out, reduce_sum_mode_t mode) {
+
+    if (mode == REDUCE_SUM_PAIRWISE && l1 - l0 > REDUCE_PAIRWISE_BLOCK) {
+        size_t mid = l0 + (l1 - l0) / 2;
+        std::vector<T> right (j1 - j0);
+
+        sum_rows(l0, mid, inner, j0, j1, x, out, mode);
+        sum_rows(mid, l1, inner, j0, j1, x, right.data() - j0, mode);
+        for (size_t j = j0; j < j1; j++) out[j] += right[j - j0];
+        return;
+    }
+
+    for (size_t j = j0; j < j1; j++) out[j] = (T) 0;
+
+    if (mode == REDUCE_SUM_KAHAN) {
+        std::vector<T> comp (j1 - j0, (T) 0);
+        T *c = comp.data() - j0;
+
+        for (size_t l = l0; l < l1; l++) {
+            const T *row = x + l * inner;
+            for (size_t j = j0; j < j1; j++) {
+                T y = row[j] - c[j];
+                T t = out[j] + y;
+                c[j] = (t - out[j]) - y;
+                out[j] = t;
+            }
+        }
+        return;
+    }
+
+    for (size_t l = l0; l < l1; l++) {
+        const T *row = x + l * inner;
+        for (size_t j = j0; j < j1; j++) out[j] += row[j];
+    }
+}
+
+template <typename T>
+void reducesum_host(size_t outer, size_t len, size_t inner, const T *x, T *out, reduce_sum_mode_t mode) {
+    size_t grain_elems = parallel::get_grain_size();
+    size_t slice = len * inner;
+
+    if (outer >= 2 * std::max((size_t) 1, grain_elems / std::max(slice, (size_t) 1)) || outer * slice < 2 * grain_elems) {
+        /* enough outer slices to go around. each is summed by one thread. */
+        parallel::parallel_for(0, outer, std::max((size_t) 1, grain_elems / std::max(slice, (size_t) 1)), [=](size_t begin, size_t end) {
+            for (size_t o = begin; o < end; o++) {
+                if (inner == 1) {
+                    out[o] = sum_contiguous(len, x + o * len, mode);
+                } else {
+                    sum_rows(0, len, inner, 0, inner, x + o * slice, out + o * inner, mode);
+                }
+            }
+        });
+    } else if (inner > 1) {
+        /* few slices, so split the kept columns instead */
+        for (size_t o = 0; o < outer; o++) {
+            const T *x_o = x + o * slice;
+            T *out_o = out + o * inner;
+
+            parallel::parallel_for(0, inner, std::max((size_t) 1, grain_elems / std::max(len, (size_t) 1)), [=](size_t begin, size_t end) {
+                sum_rows(0, len, inner, begin, end, x_o, out_o, mode);
+            });
+        }
+    } else {
+        /* few long contiguous sums. each is split into chunks whose sums are added at the end. */
+        for (size_t o = 0; o < outer; o++) {
+            const T *x_o = x + o * len;
+            size_t n_chunks = std::min(len / grain_elems, (size_t) parallel::get_num_threads());
+            size_t chunk = (len + n_chunks - 1) / n_chunks;
+            std::vector<T> partial (n_chunks, (T) 0);
+            T *partial_ptr = partial.data();
+
+            parallel::parallel_for(0, n_chunks, 1, [=](size_t begin, size_t end) {
+                for (size_t c = begin; c < end; c++) {
+                    size_t start = c * chunk;
+                    partial_ptr[c] = (start < len) ? sum_contiguous(std::min(chunk, len - start), x_o + start, mode) : (T) 0;
+                }
+            });
+            out[o] = sum_contiguous(n_chunks, partial_ptr, (mode == REDUCE_SUM_PLAIN) ? REDUCE_SUM_PLAIN : REDUCE_SUM_KAHAN);
+        }
+    }
+}
+template void reducesum_host(size_t outer, size_t len, size_t inner, const int *x, int *out, reduce_sum_mode_t mode);
+template void reducesum_host(size_t outer, size_t len, size_t inner, const float *x, float *out, reduce_sum_mode_t mode);
+template void reducesum_host(size_t outer, size_t len, size_t inner, const double *x, double *out, reduce_sum_mode_t mode);
+
+template <typename T>
+void reducesum_axes_full(Tensor<T> *x, const std::vector<unsigned int>& axes, Tensor<T> *out, reduce_sum_mode_t mode) {
+    std::vector<unsigned int> const& shape = x->get_shape();
+    std::vector<bool> reduced (shape.size(), false);
+    std::vector<size_t> sizes;
+    std::vector<bool> flags;
+
+    for (unsigned int i = 0; i < axes.size(); i++) {
+        assert( axes[i] < shape.size() );
+        reduced[axes[i]] = true;
+    }
+
+    if (out->get_memory_type() != HOST) {
+        #if defined(_HAS_CUDA_)
+        if (axes.size() == 1) { tensor_reducesum_full_device(x, axes[0], out); return; }
+        #endif
+        std::fprintf(stderr, "reduce sum over several axes is only available on the HOST.\n");
+        return;
+    }
+
+    /* merge neighbouring axes that are both reduced or both kept. axes of size 1 change nothing. */
+    for (unsigned int i = 0; i < shape.size(); i++) {
+        if (shape[i] == 1) continue;
+        if (!flags.empty() && flags.back() == reduced[i]) {
+            sizes.back() *= shape[i];
+        } else {
+            sizes.push_back(shape[i]);
+            flags.push_back(reduced[i]);
+        }
+    }
+
+    const T *src = x->get_ptr();
+    std::vector<T> buffers[2];
+    unsigned int cur = 0;
+
+    /* sum the reduced groups from the innermost out. each pass is an outer x len x inner reduction. */
+    for (int g = (int) sizes.size() - 1; g >= 0; g--) {
+        if (!flags[g]) continue;
+
+        size_t outer = 1, inner = 1;
+        for (int i = 0; i < g; i++) outer *= sizes[i];
+        for (unsigned int i = g + 1; i < sizes.size(); i++) inner *= sizes[i];
+
+        bool last = true;
+        for (int i = 0; i < g; i++) if (flags[i]) last = false;
+
+        T *dst;
+        if (last) {
+            dst = out->get_ptr();
+        } else {
+            buffers[cur].resize(outer * inner);
+            dst = buffers[cur].data();
+        }
+
+        reducesum_host(outer, sizes[g], inner, src, dst, mode);
+
+        src = dst;
+        cur = 1 - cur;
+        sizes[g] = 1;
+        if (last) return;
+    }
+
+    /* nothing to reduce */
+    std::copy(src, src + x->get_size(), out->get_ptr());
+}
+template void reducesum_axes_full(Tensor<int> *x, const std::vector<unsigned int>& axes, Tensor<int> *out, reduce_sum_mode_t mode);
+template void reducesum_axes_full(Tensor<float> *x, const std::vector<unsigned int>& axes, Tensor<float> *out, reduce_sum_mode_t mode);
+template void reducesum_axes_full(Tensor<double> *x, const std::vector<unsigned int>& axes, Tensor<double> *out, reduce_sum_mode_t mode);
+
 template <typename T>
 void tensor_reducesum_full(Tensor<T> *x, unsigned int axis, Tensor<T> *out) {
 
     if (out->get_memory_type() == HOST) {
-        internal::debugf("general tensor reduce sum not yet implemented\n");
+        reducesum_axes_full(x, {axis}, out);
     }
     #if defined(_HAS_CUDA_)
     else {
@@ -23,15 +233,18 @@ template void tensor_reducesum_full(Tensor<double> *x, unsigned int axis, Tensor
 
 
 template <> void col_reducesum_full(Tensor<int> *x, Tensor<int> *ones, Tensor<int> *out) {
-    
     unsigned int n_rows = x->get_shape(0);
     unsigned int n_cols = x->get_shape(1);
-    unsigned int size = n_rows * n_cols;
 
-    for (unsigned int i = 0; i < n_cols; i++) out->set(i, 0);
+    if (out->get_memory_type() == HOST) {
+        /* whole rows are added at a time, so the inner loop is contiguous */
+        reducesum_host(1, n_rows, n_cols, x->get_ptr(), out->get_ptr(), REDUCE_SUM_PLAIN);
+    } else {
+        for (unsigned int i = 0; i < n_cols; i++) out->set(i, 0);
 
-    for (unsigned int i = 0; i < size; i++) {
-        out->set(i % n_cols, out->get(i % n_cols) + x->get(i));
+        for (size_t i = 0; i < (size_t) n_rows * n_cols; i++) {
+            out->set(i % n_cols, out->get(i % n_cols) + x->get(i));
+        }
     }
 }
 template <> void col_reducesum_full(Tensor<float> *x, Tensor<float> *ones, Tensor<float> *out) {
@@ -77,7 +290,7 @@ template <> void col_reducesum_full(Tensor<double> *x, Tensor<double> *ones, Ten
                     x->get_shape(1),
                     ones->get_ptr(),
                     1,
-                    (float) 1,
+                    (float) 0,
                     out->get_ptr(),
                     1);
     }
@@ -102,15 +315,19 @@ template <> void col_reducesum_full(Tensor<double> *x, Tensor<double> *ones, Ten
 
 
 template <> void row_reducesum_full(Tensor<int> *x, Tensor<int> *ones, Tensor<int> *out) {
-    
     unsigned int n_rows = x->get_shape(0);
     unsigned int n_cols = x->get_shape(1);
-    unsigned int size = n_rows * n_cols;
 
-    for (unsigned int i = 0; i < n_rows; i++) out->set(i, 0);
+    if (out->get_memory_type() == HOST) {
+        /* one contiguous sum per row */
+        reducesum_host(n_rows, n_cols, 1, x->get_ptr(), out->get_ptr(), REDUCE_SUM_PLAIN);
+    } else {
+        for (unsigned int i = 0; i < n_rows; i++) out->set(i, 0);
 
-    for (unsigned int i = 0; i < size; i++) {
-        out->set(i / n_rows, out->get(i / n_rows) + x->get(i));
+        /* element i is in row i / n_cols */
+        for (size_t i = 0; i < (size_t) n_rows * n_cols; i++) {
+            out->set(i / n_cols, out->get(i / n_cols) + x->get(i));
+        }
     }
 }
 template <> void row_reducesum_full(Tensor<float> *x, Tensor<float> *ones, Tensor<float> *out) {
@@ -181,14 +398,7 @@ template <typename T>
 void reducesum_full(Tensor<T> *x, Tensor<T> *out) {
 
     if (out->get_memory_type() == HOST) {
-        T *x_ptr = x->get_ptr();
-        T *out_ptr = out->get_ptr();
-        unsigned int size = out->get_size();
-
-        out_ptr[0] = (T) 0;
-        for (unsigned int i = 0; i < size; i++) {
-            out_ptr[0] += x_ptr[i];
-        }
+        reducesum_host(1, x->get_size(), 1, x->get_ptr(), out->get_ptr(), REDUCE_SUM_PLAIN);
     }
     #if defined(_HAS_CUDA_)
     else {
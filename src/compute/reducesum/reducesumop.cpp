@@ -6,7 +6,7 @@ namespace op {
 
 template <typename T>
 ReduceSumOp<T>::ReduceSumOp(Operation<T> *x, int axis, bool copy, bool needs_grad)
-    : Operation<T>::Operation({x}, needs_grad), x(x), axis(axis), copy(copy) {
+    : Operation<T>::Operation({x}, needs_grad), x(x), ones(NULL), axis(axis), mode(internal::REDUCE_SUM_PLAIN), copy(copy) {
 
     std::vector<unsigned int> const& x_output_shape = x->get_output_shape();
     this->mem_type = x->get_memory_type();
@@ -33,8 +33,9 @@ ReduceSumOp<T>::ReduceSumOp(Operation<T> *x, int axis, bool copy, bool needs_gra
         }
     } else {
         op_type = internal::TENSOR_REDUCE;
+        axes = {(unsigned int) axis};
         this->output_shape = x_output_shape;
-        std::fprintf(stderr, "ReduceSum not available for general tensors with more than 2 axes.\n");
+        this->output_shape.erase(this->output_shape.begin() + axis);
     }
 
     if (copy) {
@@ -46,19 +47,67 @@ ReduceSumOp<T>::ReduceSumOp(Operation<T> *x, int axis, bool copy, bool needs_gra
 }
 
 template <typename T>
-Tensor<T> *ReduceSumOp<T>::eval(bool recompute) {
+ReduceSumOp<T>::ReduceSumOp(Operation<T> *x, const std::vector<unsigned int>& axes, internal::reduce_sum_mode_t mode, bool copy, bool needs_grad)
+    : Operation<T>::Operation({x}, needs_grad), x(x), ones(NULL), axis(-1), axes(axes), mode(mode), copy(copy) {
 
-    if (!recompute && this->ret != NULL) {
-        return this->ret;
+    std::vector<unsigned int> const& x_output_shape = x->get_output_shape();
+    std::vector<bool> reduced (x_output_shape.size(), false);
+
+    this->mem_type = x->get_memory_type();
+    op_type = internal::TENSOR_REDUCE;
+
+    for (unsigned int i = 0; i < axes.size(); i++) {
+        assert( axes[i] < x_output_shape.size() );
+        reduced[axes[i]] = true;
+    }
+    for (unsigned int i = 0; i < x_output_shape.size(); i++) {
+        if (!reduced[i]) this->output_shape.push_back(x_output_shape[i]);
+    }
+    if (this->output_shape.empty()) this->output_shape = {1};
+
+    if (copy) {
+        this->ret = new Tensor<T> (this->get_output_shape(), {NONE, {}}, this->mem_type);
+    } else {
+        std::fprintf(stderr, "Non-Copy ReduceSum not supported.\n");
+    }
+}
+
+template <typename T>
+ReduceSumOp<T>::ReduceSumOp(Operation<T> *x, const std::vector<unsigned int>& axes, const std::vector<unsigned int>& shape, internal::reduce_sum_mode_t mode, bool copy, bool needs_grad)
+    : Operation<T>::Operation({x}, needs_grad), x(x), ones(NULL), axis(-1), axes(axes), mode(mode), copy(copy) {
+
+    std::vector<unsigned int> const& x_output_shape = x->get_output_shape();
+    size_t kept_size = x->get_output_size(), size = 1;
+
+    this->mem_type = x->get_memory_type();
+    op_type = internal::TENSOR_REDUCE;
+
+    for (unsigned int i = 0; i < axes.size(); i++) {
+        assert( axes[i] < x_output_shape.size() );
+        kept_size /= x_output_shape[axes[i]];
+    }
+    for (unsigned int i = 0; i < shape.size(); i++) size *= shape[i];
+    assert( size == kept_size );
+
+    this->output_shape = shape;
+
+    if (copy) {
+        this->ret = new Tensor<T> (this->get_output_shape(), {NONE, {}}, this->mem_type);
+    } else {
+        std::fprintf(stderr, "Non-Copy ReduceSum not supported.\n");
     }
+}
+
+template <typename T>
+Tensor<T> *ReduceSumOp<T>::_eval(bool recompute) {
 
-    x_tensor = x->eval();
+    x_tensor = x->eval(recompute);
 
     if (!copy) { std::fprintf(stderr, "Non-Copy ReduceSum not supported.\n"); return this->ret; }
 
     switch (op_type) {
         case internal::TENSOR_REDUCE:
-            internal::tensor_reducesum_full(x_tensor, axis, this->ret); break;
+            internal::reducesum_axes_full(x_tensor, axes, this->ret, mode); break;
         case internal::COL_REDUCE:
             internal::col_reducesum_full(x_tensor, ones, this->ret); break;
         case internal::ROW_REDUCE:
@@ -96,6 +145,52 @@ template ReduceSumOp<int> *reducesum(Operation<int> *x, int axis, bool copy, boo
 template ReduceSumOp<float> *reducesum(Operation<float> *x, int axis, bool copy, bool needs_grad);
 template ReduceSumOp<double> *reducesum(Operation<double> *x, int axis, bool copy, bool needs_grad);
 
+template <typename T>
+ReduceSumOp<T> *reducesum(Operation<T> *x, const std::vector<unsigned int>& axes, internal::reduce_sum_mode_t mode, bool copy, bool needs_grad) {
+    return new ReduceSumOp<T> (x, axes, mode, copy, needs_grad);
+}
+template ReduceSumOp<int> *reducesum(Operation<int> *x, const std::vector<unsigned int>& axes, internal::reduce_sum_mode_t mode, bool copy, bool needs_grad);
+template ReduceSumOp<float> *reducesum(Operation<float> *x, const std::vector<unsigned int>& axes, internal::reduce_sum_mode_t mode, bool copy, bool needs_grad);
+template ReduceSumOp<double> *reducesum(Operation<double> *x, const std::vector<unsigned int>& axes, internal::reduce_sum_mode_t mode, bool copy, bool needs_grad);
+
+template <typename T>
+Operation<T> *reducesum_to(Operation<T> *grad, const std::vector<unsigned int>& shape, const std::vector<unsigned int>& out_shape) {
+    std::vector<unsigned int> const& grad_shape = grad->get_output_shape();
+    std::vector<unsigned int> axes, reduced_shape;
+    unsigned int n_axes = std::max(out_shape.size(), grad_shape.size());
+    T n_copies = (T) 1;
+
+    /* walk the axes lined up by the last one. missing leading axes have size 1. */
+    for (unsigned int i = 0; i < n_axes; i++) {
+        int shape_axis = (int) i - (int) (n_axes - shape.size());
+        int grad_axis = (int) i - (int) (n_axes - grad_shape.size());
+        int out_axis = (int) i - (int) (n_axes - out_shape.size());
+        unsigned int dim = (shape_axis >= 0) ? shape[shape_axis] : 1;
+        unsigned int grad_dim = (grad_axis >= 0) ? grad_shape[grad_axis] : 1;
+        unsigned int out_dim = (out_axis >= 0) ? out_shape[out_axis] : 1;
+        bool summed = (dim == 1 && grad_dim != 1);
+
+        if (summed) {
+            axes.push_back(grad_axis);
+        } else if (dim == 1 && out_dim != 1) {
+            /* grad holds the same value for each of the out_dim copies */
+            n_copies *= (T) out_dim;
+        }
+        if (shape_axis >= 0) reduced_shape.push_back((summed) ? 1 : grad_dim);
+    }
+
+    if (!axes.empty()) {
+        grad = new ReduceSumOp<T> (grad, axes, reduced_shape, internal::REDUCE_SUM_PLAIN, true, false);
+    }
+    if (n_copies != (T) 1) {
+        grad = scalarproduct(n_copies, grad, true, false);
+    }
+    return grad;
+}
+template Operation<int> *reducesum_to(Operation<int> *grad, const std::vector<unsigned int>& shape, const std::vector<unsigned int>& out_shape);
+template Operation<float> *reducesum_to(Operation<float> *grad, const std::vector<unsigned int>& shape, const std::vector<unsigned int>& out_shape);
+template Operation<double> *reducesum_to(Operation<double> *grad, const std::vector<unsigned int>& shape, const std::vector<unsigned int>& out_shape);
+
 
 }   // namespace op
 }   // namespace magmadnn
\ No newline at end of file
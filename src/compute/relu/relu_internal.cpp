@@ -15,7 +15,7 @@ template <typename T>
 magmadnn_error_t relu_full(Tensor<T> *x, Tensor<T> *out) {
     if (x->get_memory_type() == HOST) {
         T val;
-        for (unsigned int i = 0; i < x->get_size(); i++) {
+        for (size_t i = 0; i < x->get_size(); i++) {
             val = x->get(i);
             if (val < 0) out->set(i, (T) 0);
             else out->set(i, val);
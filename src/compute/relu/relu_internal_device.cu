@@ -12,11 +12,11 @@ namespace magmadnn {
 namespace internal {
 
 template <typename T>
-__global__ void kernel_relu_full_device(unsigned int size, T *arr, T *out) {
-    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-    unsigned int stride = blockDim.x * gridDim.x;
+__global__ void kernel_relu_full_device(size_t size, T *arr, T *out) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
     
-    for (unsigned int i = idx; i < size; i += stride) {
+    for (size_t i = idx; i < size; i += stride) {
         if (arr[i] < 0) out[i] = 0;
         else out[i] = arr[i];
     }
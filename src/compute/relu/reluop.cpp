@@ -23,12 +23,9 @@ ReluOp<T>::ReluOp(Operation<T> *x, bool copy, bool needs_grad)
 }
 
 template <typename T>
-Tensor<T>* ReluOp<T>::eval(bool recompute) {
-    if (!recompute && this->ret != NULL) {
-        return this->ret;
-    }
+Tensor<T>* ReluOp<T>::_eval(bool recompute) {
 
-    x_tensor = x->eval();
+    x_tensor = x->eval(recompute);
     
     if (!copy) this->ret = x_tensor;
 
@@ -9,14 +9,14 @@ void scalarproduct_full(T alpha, Tensor<T> *x, Tensor<T> *out) {
     if (x->get_memory_type() == HOST) {
 
         T *x_ptr, *out_ptr;
-        unsigned int size;
+        size_t size;
 
         x_ptr = x->get_ptr();
         out_ptr = out->get_ptr();
 
         size = x->get_size();
 
-        for (unsigned int i = 0; i < size; i++) {
+        for (size_t i = 0; i < size; i++) {
             out_ptr[i] = alpha * x_ptr[i];
         }
     }
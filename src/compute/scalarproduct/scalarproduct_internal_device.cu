@@ -5,11 +5,11 @@ namespace magmadnn {
 namespace internal {
  
 template <typename T>
-__global__ void kernel_scalarproduct_full_device(T alpha, T *arr, T *out, unsigned int arr_size) {
-    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-    unsigned int stride = blockDim.x * gridDim.x;
+__global__ void kernel_scalarproduct_full_device(T alpha, T *arr, T *out, size_t arr_size) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
 
-    for (unsigned int i = idx; i < arr_size; i += stride) {
+    for (size_t i = idx; i < arr_size; i += stride) {
         out[i] = alpha * arr[i];
     }
 }
@@ -12,36 +12,37 @@ namespace magmadnn {
 namespace op {
 
 template <typename T>
-ScalarProductOp<T>::ScalarProductOp(T alpha, Operation<T> *x, bool copy, bool needs_grad) 
-    : Operation<T>::Operation({x}, needs_grad), alpha(alpha), scalar(NULL), x(x), copy(copy) {
-    
-    this->mem_type = x->get_memory_type();
-    this->output_shape = x->get_output_shape();
-
-    if (copy) {
-        this->ret = new Tensor<T> (x->get_output_shape(), {NONE, {}}, x->get_memory_type());
-    }
+ScalarProductOp<T>::ScalarProductOp(T alpha, Operation<T> *x, bool copy, bool needs_grad, bool trans_x) 
+    : Operation<T>::Operation({x}, needs_grad), alpha(alpha), scalar(NULL), x(x), copy(copy), trans_x(trans_x) {
+    init();
 }
 
 template <typename T>
-ScalarProductOp<T>::ScalarProductOp(Operation<T> *scalar, Operation<T> *x, bool copy, bool needs_grad)
-    : Operation<T>::Operation({scalar, x}, needs_grad), alpha((T)1), scalar(scalar), x(x), copy(copy) {
+ScalarProductOp<T>::ScalarProductOp(Operation<T> *scalar, Operation<T> *x, bool copy, bool needs_grad, bool trans_x)
+    : Operation<T>::Operation({scalar, x}, needs_grad), alpha((T)1), scalar(scalar), x(x), copy(copy), trans_x(trans_x) {
 
     assert( scalar->get_output_shape().size() == 1 && scalar->get_output_shape()[0] == 1 );
+    init();
+}
+
+template <typename T>
+void ScalarProductOp<T>::init() {
     this->mem_type = x->get_memory_type();
     this->output_shape = x->get_output_shape();
 
+    if (trans_x) {
+        /* the transpose is written into ret, so it can not be x's tensor */
+        assert( this->output_shape.size() == 2 && copy );
+        std::swap(this->output_shape[0], this->output_shape[1]);
+    }
+
     if (copy) {
-        this->ret = new Tensor<T> (x->get_output_shape(), {NONE, {}}, x->get_memory_type());
+        this->ret = new Tensor<T> (this->output_shape, {NONE, {}}, this->mem_type);
     }
 }
 
 template <typename T>
-Tensor<T> *ScalarProductOp<T>::eval(bool recompute) {
-
-    if (!recompute && this->ret != NULL) {
-        return this->ret;
-    }
+Tensor<T> *ScalarProductOp<T>::_eval(bool recompute) {
 
     x_tensor = x->eval(recompute);
     
@@ -53,17 +54,23 @@ Tensor<T> *ScalarProductOp<T>::eval(bool recompute) {
 
     if (!copy) this->ret = x_tensor;
 
-    internal::scalarproduct_full(alpha, x_tensor, this->ret);
+    if (trans_x) {
+        internal::transpose_full(x_tensor, this->ret);
+        internal::scalarproduct_full(alpha, this->ret, this->ret);
+    } else {
+        internal::scalarproduct_full(alpha, x_tensor, this->ret);
+    }
 
     return this->ret;
 }
 
 template <typename T>
 Operation<T> *ScalarProductOp<T>::grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad) {
+    /* the grad of a scaled transpose is the scaled transpose of the grad */
     if (scalar != NULL) {
-        return scalarproduct(scalar, grad, false, false);
+        return scalarproduct(scalar, grad, trans_x, false, trans_x);
     } else {
-        return scalarproduct(alpha, grad, false, false);
+        return scalarproduct(alpha, grad, trans_x, false, trans_x);
     }
 }
 
@@ -82,21 +89,21 @@ template class ScalarProductOp<double>;
 
 
 template <typename T>
-ScalarProductOp<T> *scalarproduct(T alpha, Operation<T> *x, bool copy, bool needs_grad) {
-    return new ScalarProductOp<T>(alpha, x, copy, needs_grad);
+ScalarProductOp<T> *scalarproduct(T alpha, Operation<T> *x, bool copy, bool needs_grad, bool trans_x) {
+    return new ScalarProductOp<T>(alpha, x, copy, needs_grad, trans_x);
 }
-template ScalarProductOp<int> *scalarproduct(int alpha, Operation<int> *x, bool copy, bool needs_grad);
-template ScalarProductOp<float> *scalarproduct(float alpha, Operation<float> *x, bool copy, bool needs_grad);
-template ScalarProductOp<double> *scalarproduct(double alpha, Operation<double> *x, bool copy, bool needs_grad);
+template ScalarProductOp<int> *scalarproduct(int alpha, Operation<int> *x, bool copy, bool needs_grad, bool trans_x);
+template ScalarProductOp<float> *scalarproduct(float alpha, Operation<float> *x, bool copy, bool needs_grad, bool trans_x);
+template ScalarProductOp<double> *scalarproduct(double alpha, Operation<double> *x, bool copy, bool needs_grad, bool trans_x);
 
 
 template <typename T>
-ScalarProductOp<T> *scalarproduct(Operation<T> *scalar, Operation<T> *x, bool copy, bool needs_grad) {
-    return new ScalarProductOp<T>(scalar, x, copy, needs_grad);
+ScalarProductOp<T> *scalarproduct(Operation<T> *scalar, Operation<T> *x, bool copy, bool needs_grad, bool trans_x) {
+    return new ScalarProductOp<T>(scalar, x, copy, needs_grad, trans_x);
 }
-template ScalarProductOp<int> *scalarproduct(Operation<int> *scalar, Operation<int> *x, bool copy, bool needs_grad);
-template ScalarProductOp<float> *scalarproduct(Operation<float> *scalar, Operation<float> *x, bool copy, bool needs_grad);
-template ScalarProductOp<double> *scalarproduct(Operation<double> *scalar, Operation<double> *x, bool copy, bool needs_grad);
+template ScalarProductOp<int> *scalarproduct(Operation<int> *scalar, Operation<int> *x, bool copy, bool needs_grad, bool trans_x);
+template ScalarProductOp<float> *scalarproduct(Operation<float> *scalar, Operation<float> *x, bool copy, bool needs_grad, bool trans_x);
+template ScalarProductOp<double> *scalarproduct(Operation<double> *scalar, Operation<double> *x, bool copy, bool needs_grad, bool trans_x);
 
 
 }   // namespace op
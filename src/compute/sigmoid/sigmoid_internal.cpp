@@ -16,15 +16,19 @@ void sigmoid_full(Tensor<T> *x, bool fast) {
 
     if (x->get_memory_type() == HOST) {
         T *x_ptr = x->get_ptr();
+        size_t size = x->get_size();
         
         if (fast) {
             // fast sigmoid -- fast_sigmoid(x) = x / (1 + |x|)
-            for(unsigned int i = 0; i < x->get_size(); i++) 
-                x_ptr[i] = x_ptr[i] / (1 + abs(x_ptr[i]));
+            parallel::parallel_for(0, size, [=](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) 
+                    x_ptr[i] = x_ptr[i] / (1 + abs(x_ptr[i]));
+            });
         } else {
             // normal sigmoid -- sigmoid(x) = 1 / (1 + exp(-x))
-            for(unsigned int i = 0; i < x->get_size(); i++) 
-                x_ptr[i] = 1 / (1 + exp(-x_ptr[i]));
+            parallel::parallel_for(0, size, [=](size_t begin, size_t end) {
+                vsigmoid(end - begin, x_ptr + begin, x_ptr + begin);
+            });
         }
     }
     #if defined(_HAS_CUDA_)
@@ -12,21 +12,21 @@ namespace magmadnn {
 namespace internal {
 
 template <typename T>
-__global__ void kernel_fast_sigmoid_full_device(unsigned int size, T *x) {
-    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-	unsigned int stride = blockDim.x * gridDim.x;
+__global__ void kernel_fast_sigmoid_full_device(size_t size, T *x) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+	size_t stride = blockDim.x * gridDim.x;
 
-	for (unsigned int i = idx; i < size; i += stride) {
+	for (size_t i = idx; i < size; i += stride) {
         x[i] = x[i] / (1 + abs(x[i]));
 	}
 }
 
 template <typename T>
-__global__ void kernel_sigmoid_full_device(unsigned int size, T *x) {
-    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-	unsigned int stride = blockDim.x * gridDim.x;
+__global__ void kernel_sigmoid_full_device(size_t size, T *x) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+	size_t stride = blockDim.x * gridDim.x;
 
-	for (unsigned int i = idx; i < size; i += stride) {
+	for (size_t i = idx; i < size; i += stride) {
         x[i] = 1 / (1 + exp(-x[i]));
 	}
 }
@@ -35,11 +35,11 @@ __global__ void kernel_sigmoid_full_device(unsigned int size, T *x) {
 /* exp(INT_TYPE) is not defined in CUDA, so just use 1/(1+|x|) for int.
    Everything will be zero anyways. TODO: decide what to do with int sigmoid. */
 template <>
-__global__ void kernel_sigmoid_full_device(unsigned int size, int *x) {
-    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-	unsigned int stride = blockDim.x * gridDim.x;
+__global__ void kernel_sigmoid_full_device(size_t size, int *x) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+	size_t stride = blockDim.x * gridDim.x;
 
-	for (unsigned int i = idx; i < size; i += stride) {
+	for (size_t i = idx; i < size; i += stride) {
         x[i] = 1 / (1 + abs(x[i]));
 	}
 }
@@ -55,7 +55,7 @@ void sigmoid_full_device(Tensor<T> *x, bool fast) {
 
 template<> void sigmoid_full_device(Tensor<int> *x, bool fast) {
 	/* sigmoid doesn't make much sense on integer precision */
-	for (unsigned int i = 0; i < x->get_size(); i++)
+	for (size_t i = 0; i < x->get_size(); i++)
 		x->set(i, (int) exp(x->get(i)));
 }
 
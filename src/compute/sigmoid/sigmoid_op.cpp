@@ -26,11 +26,7 @@ SigmoidOp<T>::SigmoidOp(Operation<T> *x, bool copy, bool fast) :
 }
 
 template <typename T>
-Tensor<T>* SigmoidOp<T>::eval(bool recompute) {
-
-    if (!recompute && this->ret != NULL) {
-        return this->ret;
-    }
+Tensor<T>* SigmoidOp<T>::_eval(bool recompute) {
 
     x_tensor = x->eval(recompute);
 
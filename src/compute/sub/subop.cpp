@@ -0,0 +1,71 @@
+/**
+ * @file subop.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-18
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "compute/sub/subop.h"
+
+namespace magmadnn {
+namespace op {
+
+template <typename T>
+SubOp<T>::SubOp(Operation<T>* a, Operation<T>* b, bool copy, bool needs_grad) : 
+	Operation<T>::Operation({a,b}, needs_grad), a(a), b(b), copy(copy) {
+	
+	assert( a->get_memory_type() == b->get_memory_type() );
+
+	if (!internal::broadcast_shape(a->get_output_shape(), b->get_output_shape(), this->output_shape)) {
+		std::fprintf(stderr, "Error: can not broadcast the operands of sub.\n");
+		assert( false );
+	}
+	assert( copy || b->get_output_shape() == this->output_shape );
+
+	this->mem_type = a->get_memory_type();
+
+	if (copy) {
+		this->ret = new Tensor<T> (this->output_shape, {NONE, {}}, this->mem_type);
+	}
+}
+
+template <typename T>
+Tensor<T>* SubOp<T>::_eval(bool recompute) {
+
+	a_tensor = a->eval(recompute);
+	b_tensor = b->eval(recompute);
+
+	if (!copy) this->ret = b_tensor;
+
+	internal::broadcast_full(internal::BROADCAST_ADD, (T) 1, a_tensor, (T) -1, b_tensor, this->ret);
+	
+	return this->ret;
+} 
+
+template <typename T>
+Operation<T> *SubOp<T>::grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad) {
+	/* wrt a: grad, wrt b: -grad. each summed over the axes it was broadcast along. */
+	Operation<T> *summed = reducesum_to(grad, var->get_output_shape(), this->output_shape);
+
+	/* a - a is constant. this is called once for each side, so neither call may count. */
+	if (a == b) return scalarproduct((T) 0, summed, true, false);
+
+	if (var == a) return summed;
+	return negative(summed, true, false);
+}
+template class SubOp<int>;
+template class SubOp<float>;
+template class SubOp<double>;
+
+
+template <typename T>
+SubOp<T>* sub(Operation<T> *a, Operation<T> *b, bool copy, bool needs_grad) {
+    return new SubOp<T> (a, b, copy, needs_grad);
+}
+template SubOp<int>* sub(Operation<int> *a, Operation<int> *b, bool copy, bool needs_grad);
+template SubOp<float>* sub(Operation<float> *a, Operation<float> *b, bool copy, bool needs_grad);
+template SubOp<double>* sub(Operation<double> *a, Operation<double> *b, bool copy, bool needs_grad);
+
+} // namespace op
+} // namespace magmadnn
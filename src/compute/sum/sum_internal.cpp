@@ -17,7 +17,7 @@ void sum_full(std::vector<Tensor<T> *> &vals, Tensor<T> &out) {
     if (vals.at(0)->get_memory_type() == HOST) {
 
         T sum;
-        for (unsigned int idx = 0; idx < vals[0]->get_size(); idx++) {
+        for (size_t idx = 0; idx < vals[0]->get_size(); idx++) {
             sum = (T) 0;
             for (unsigned int i = 0; i < vals.size(); i++) {
                 sum += (vals[i])->get(idx);
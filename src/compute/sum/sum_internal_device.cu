@@ -12,16 +12,16 @@ namespace magmadnn {
 namespace internal {
 
 template <typename T>
-__global__ void kernel_sum_full_device(T **arrs, unsigned int n_arrs, unsigned int arr_size, T *out) {
+__global__ void kernel_sum_full_device(T **arrs, size_t n_arrs, size_t arr_size, T *out) {
 
-    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-    unsigned int stride = blockDim.x * gridDim.x;
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
     T sum;
 
-    for (int i = idx; i < arr_size; i += stride) {
+    for (size_t i = idx; i < arr_size; i += stride) {
         sum = (T) 0;
 
-        for (unsigned int j = 0; j < n_arrs; j++) {
+        for (size_t j = 0; j < n_arrs; j++) {
             sum += arrs[j][i];
         }
         out[i] = sum;
@@ -35,26 +35,27 @@ void sum_full_device(std::vector<Tensor<T> *> &vals, Tensor<T> &out) {
     T **arrs_host;
     /* device array of device pointers */
     T **arrs_device;
-    unsigned int n_arrs, arr_size;
+    size_t n_arrs, arr_size, n_blocks;
 
     n_arrs = vals.size();
     arr_size = vals[0]->get_size();
 
     /* init arrs_host to hold array of device pointers for tensors */
     arrs_host = new T*[vals.size()];
-    for (unsigned int i = 0; i < vals.size(); i++) {
+    for (size_t i = 0; i < vals.size(); i++) {
         arrs_host[i] = vals[i]->get_ptr();
     }
 
     /* init arrs_device and copy device pointers into it */
     cudaMalloc((void **) &arrs_device, vals.size() * sizeof(T *));
-    cudaMemcpy(arrs_device, arrs_host, vals.size() * sizeof(float *), cudaMemcpyHostToDevice);
+    cudaMemcpy(arrs_device, arrs_host, vals.size() * sizeof(T *), cudaMemcpyHostToDevice);
 
-    /* add up each tensor */
-    kernel_sum_full_device <<< n_arrs, arr_size >>> (arrs_device, n_arrs, arr_size, out.get_ptr());
+    /* add up each tensor. the kernel strides over the elements, so the grid is capped */
+    n_blocks = std::min((arr_size + 255) / 256, (size_t) 65535);
+    kernel_sum_full_device <<< n_blocks, 256 >>> (arrs_device, n_arrs, arr_size, out.get_ptr());
     
     /* no longer need memory */
-    delete arrs_host;
+    delete[] arrs_host;
     cudaFree(arrs_device);
 }
 template void sum_full_device(std::vector<Tensor<int> *> &vals, Tensor<int> &out);
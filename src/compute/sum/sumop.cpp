@@ -18,7 +18,7 @@ SumOp<T>::SumOp(std::vector<Operation<T> *> ops, bool copy) : Operation<T>::Oper
     }
 
     typename std::vector<Operation<T> *>::const_iterator it = ops.begin();
-    unsigned int first_size = (*it)->get_output_size();
+    size_t first_size = (*it)->get_output_size();
     for (it++; it != ops.end(); it++) {
         assert( (*it)->get_output_size() == first_size );
     }
@@ -34,16 +34,12 @@ SumOp<T>::SumOp(std::vector<Operation<T> *> ops, bool copy) : Operation<T>::Oper
 }
 
 template <typename T>
-Tensor<T> *SumOp<T>::eval(bool recompute) {
-
-    if (!recompute && this->ret != NULL) {
-        return this->ret;
-    }
+Tensor<T> *SumOp<T>::_eval(bool recompute) {
 
     std::vector<Tensor<T> *> vals (ops.size());
 
     for (unsigned int i = 0; i < ops.size(); i++) {
-        vals[i] = ops[i]->eval();
+        vals[i] = ops[i]->eval(recompute);
     }
 
     /* TODO sum into first OR last element for non-copy */
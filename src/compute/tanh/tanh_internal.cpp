@@ -16,10 +16,11 @@ void tanh_full(Tensor<T> *x) {
 
     if (x->get_memory_type() == HOST) {
         T *x_ptr = x->get_ptr();
+        size_t size = x->get_size();
         
-        for (unsigned int i = 0; i < x->get_size(); i++) {
-            x_ptr[i] = tanh(x_ptr[i]);
-        }
+        parallel::parallel_for(0, size, [=](size_t begin, size_t end) {
+            vtanh(end - begin, x_ptr + begin, x_ptr + begin);
+        });
     }
     #if defined(_HAS_CUDA_)
     else {
@@ -13,11 +13,11 @@ namespace internal {
 
 
 template <typename T>
-__global__ void kernel_tanh_full_device(unsigned int size, T *x) {
-    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-	unsigned int stride = blockDim.x * gridDim.x;
+__global__ void kernel_tanh_full_device(size_t size, T *x) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+	size_t stride = blockDim.x * gridDim.x;
 
-	for (unsigned int i = idx; i < size; i += stride) {
+	for (size_t i = idx; i < size; i += stride) {
         x[i] = tanh(x[i]);
 	}
 }
@@ -25,12 +25,12 @@ __global__ void kernel_tanh_full_device(unsigned int size, T *x) {
 /* tanh(INT_TYPE) is not defined in CUDA. TODO: determine what to do for 
    int types with tanh */
 template <>
-__global__ void kernel_tanh_full_device(unsigned int size, int *x) {
-    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-	unsigned int stride = blockDim.x * gridDim.x;
+__global__ void kernel_tanh_full_device(size_t size, int *x) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+	size_t stride = blockDim.x * gridDim.x;
 
 	/* tanh : R -> (-1,1)  which is 0 in the integers */
-	for (unsigned int i = idx; i < size; i += stride) {
+	for (size_t i = idx; i < size; i += stride) {
         x[i] = 0;
 	}
 }
@@ -41,7 +41,7 @@ void tanh_full_device(Tensor<T> *x) {
 }
 
 template<> void tanh_full_device(Tensor<int> *x) {
-	for (unsigned int i = 0; i < x->get_size(); i++)
+	for (size_t i = 0; i < x->get_size(); i++)
 		x->set(i, (int)tanh(x->get(i)));
 }
 
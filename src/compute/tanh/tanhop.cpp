@@ -24,13 +24,9 @@ TanhOp<T>::TanhOp(Operation<T> *x, bool copy) : Operation<T>::Operation({x}), x(
 }
 
 template <typename T>
-Tensor<T>* TanhOp<T>::eval(bool recompute) {
+Tensor<T>* TanhOp<T>::_eval(bool recompute) {
 
-    if (!recompute && this->ret != NULL) {
-        return this->ret;
-    }
-
-    x_tensor = x->eval();
+    x_tensor = x->eval(recompute);
 
     if (copy) {
         this->ret->copy_from(*x_tensor);
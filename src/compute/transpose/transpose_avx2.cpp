@@ -0,0 +1,68 @@
+/**
+ * @file transpose_avx2.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-11
+ *
+ * AVX2 tile transposes. Everything in this file is compiled for AVX2, so it is only called after
+ * checking that the CPU supports it.
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "compute/transpose/transpose_internal.h"
+
+#if defined(MAGMADNN_VMATH_X86)
+#pragma GCC target("avx2")
+#include <immintrin.h>
+
+namespace magmadnn {
+namespace internal {
+
+void transpose_tile_32_avx2(const void *x, unsigned int ld_x, void *out, unsigned int ld_out) {
+    const float *src = (const float *) x;
+    float *dst = (float *) out;
+    __m256 r[8], t[8];
+
+    for (unsigned int i = 0; i < 8; i++) r[i] = _mm256_loadu_ps(src + i * ld_x);
+
+    /* interleave pairs of rows, then pairs of pairs, then swap the 128-bit halves */
+    for (unsigned int i = 0; i < 8; i += 2) {
+        t[i] = _mm256_unpacklo_ps(r[i], r[i+1]);
+        t[i+1] = _mm256_unpackhi_ps(r[i], r[i+1]);
+    }
+    for (unsigned int i = 0; i < 8; i += 4) {
+        r[i] = _mm256_shuffle_ps(t[i], t[i+2], _MM_SHUFFLE(1,0,1,0));
+        r[i+1] = _mm256_shuffle_ps(t[i], t[i+2], _MM_SHUFFLE(3,2,3,2));
+        r[i+2] = _mm256_shuffle_ps(t[i+1], t[i+3], _MM_SHUFFLE(1,0,1,0));
+        r[i+3] = _mm256_shuffle_ps(t[i+1], t[i+3], _MM_SHUFFLE(3,2,3,2));
+    }
+    for (unsigned int i = 0; i < 4; i++) {
+        t[i] = _mm256_permute2f128_ps(r[i], r[i+4], 0x20);
+        t[i+4] = _mm256_permute2f128_ps(r[i], r[i+4], 0x31);
+    }
+
+    for (unsigned int i = 0; i < 8; i++) _mm256_storeu_ps(dst + i * ld_out, t[i]);
+}
+
+void transpose_tile_64_avx2(const void *x, unsigned int ld_x, void *out, unsigned int ld_out) {
+    const double *src = (const double *) x;
+    double *dst = (double *) out;
+    __m256d r[4], t[4];
+
+    for (unsigned int i = 0; i < 4; i++) r[i] = _mm256_loadu_pd(src + i * ld_x);
+
+    t[0] = _mm256_unpacklo_pd(r[0], r[1]);
+    t[1] = _mm256_unpackhi_pd(r[0], r[1]);
+    t[2] = _mm256_unpacklo_pd(r[2], r[3]);
+    t[3] = _mm256_unpackhi_pd(r[2], r[3]);
+
+    _mm256_storeu_pd(dst, _mm256_permute2f128_pd(t[0], t[2], 0x20));
+    _mm256_storeu_pd(dst + ld_out, _mm256_permute2f128_pd(t[1], t[3], 0x20));
+    _mm256_storeu_pd(dst + 2 * ld_out, _mm256_permute2f128_pd(t[0], t[2], 0x31));
+    _mm256_storeu_pd(dst + 3 * ld_out, _mm256_permute2f128_pd(t[1], t[3], 0x31));
+}
+
+}   // namespace internal
+}   // namespace magmadnn
+
+#endif
@@ -1,20 +1,71 @@
-
+/**
+ * @file transpose_internal.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-11
+ *
+ * @copyright Copyright (c) 2019
+ */
 #include "compute/transpose/transpose_internal.h"
 
 namespace magmadnn {
 namespace internal {
 
+typedef void (*transpose_tile_t)(const void *, unsigned int, void *, unsigned int);
+
+/* the in-register tile transpose for elements of the given size, and the side of its tile */
+static transpose_tile_t transpose_get_tile(unsigned int elem_size, unsigned int& tile) {
+    #if defined(MAGMADNN_VMATH_X86)
+    if (vmath_get_isa() != VMATH_GENERIC) {
+        if (elem_size == 4) { tile = 8; return transpose_tile_32_avx2; }
+        if (elem_size == 8) { tile = 4; return transpose_tile_64_avx2; }
+    }
+    #endif
+    tile = 8;
+    return NULL;
+}
+
 template <typename T>
-void transpose_full(Tensor<T> *x, Tensor<T> *out) {
-    if (out->get_memory_type() == HOST) {
-        unsigned int x_rows = x->get_shape(0);
-        unsigned int x_cols = x->get_shape(1);
+void transpose_host(unsigned int rows, unsigned int cols, const T *x, T *out) {
+    unsigned int tile;
+    transpose_tile_t tile_fn = transpose_get_tile(sizeof(T), tile);
+    unsigned int n_row_blocks = (rows + TRANSPOSE_BLOCK - 1) / TRANSPOSE_BLOCK;
+    size_t grain = std::max((size_t) 1, parallel::get_grain_size() / ((size_t) TRANSPOSE_BLOCK * std::max(cols, 1u)));
+
+    parallel::parallel_for(0, n_row_blocks, grain, [=](size_t begin, size_t end) {
+        for (size_t rb = begin; rb < end; rb++) {
+            unsigned int r0 = rb * TRANSPOSE_BLOCK, r1 = std::min(rows, r0 + TRANSPOSE_BLOCK);
+
+            for (unsigned int c0 = 0; c0 < cols; c0 += TRANSPOSE_BLOCK) {
+                unsigned int c1 = std::min(cols, c0 + TRANSPOSE_BLOCK);
 
-        for (unsigned int r = 0; r < x_rows; r++) {
-            for (unsigned int c = 0; c < x_cols; c++) {
-                out->set({(int)c, (int)r}, x->get({(int)r, (int)c}));
+                for (unsigned int r = r0; r < r1; r += tile) {
+                    for (unsigned int c = c0; c < c1; c += tile) {
+                        if (tile_fn != NULL && r + tile <= r1 && c + tile <= c1) {
+                            tile_fn(x + (size_t) r * cols + c, cols, out + (size_t) c * rows + r, rows);
+                            continue;
+                        }
+
+                        /* partial tiles at the edges */
+                        for (unsigned int i = r; i < std::min(r + tile, r1); i++) {
+                            for (unsigned int j = c; j < std::min(c + tile, c1); j++) {
+                                out[(size_t) j * rows + i] = x[(size_t) i * cols + j];
+                            }
+                        }
+                    }
+                }
             }
         }
+    });
+}
+template void transpose_host(unsigned int rows, unsigned int cols, const int *x, int *out);
+template void transpose_host(unsigned int rows, unsigned int cols, const float *x, float *out);
+template void transpose_host(unsigned int rows, unsigned int cols, const double *x, double *out);
+
+template <typename T>
+void transpose_full(Tensor<T> *x, Tensor<T> *out) {
+    if (out->get_memory_type() == HOST) {
+        transpose_host(x->get_shape(0), x->get_shape(1), x->get_ptr(), out->get_ptr());
     }
     #if defined(_HAS_CUDA_)
     else {
@@ -26,5 +77,102 @@ template void transpose_full(Tensor<int> *x, Tensor<int> *out);
 template void transpose_full(Tensor<float> *x, Tensor<float> *out);
 template void transpose_full(Tensor<double> *x, Tensor<double> *out);
 
-}   // namespace op
+
+template <typename T>
+static void permute_host(const std::vector<unsigned int>& x_shape, const std::vector<unsigned int>& perm, const T *x, T *out) {
+    unsigned int n_axes = x_shape.size();
+    std::vector<unsigned int> out_shape (n_axes);
+    std::vector<size_t> x_strides (n_axes), strides (n_axes);
+    unsigned int a_size, b_size;
+    size_t a_stride, b_stride, n_outer, n_a_blocks, grain;
+
+    /* strides[i] is the stride in x of axis i of out */
+    x_strides[n_axes-1] = 1;
+    for (int i = (int) n_axes - 2; i >= 0; i--) x_strides[i] = x_strides[i+1] * x_shape[i+1];
+    for (unsigned int i = 0; i < n_axes; i++) {
+        out_shape[i] = x_shape[perm[i]];
+        strides[i] = x_strides[perm[i]];
+    }
+
+    /* the two innermost axes of out are copied in square blocks, so that reads and writes both stay
+       within a few cache lines. the outer axes are walked one index at a time. */
+    a_size = (n_axes >= 2) ? out_shape[n_axes-2] : 1;
+    a_stride = (n_axes >= 2) ? strides[n_axes-2] : 0;
+    b_size = out_shape[n_axes-1];
+    b_stride = strides[n_axes-1];
+
+    n_outer = 1;
+    for (unsigned int i = 0; i + 2 < n_axes; i++) n_outer *= out_shape[i];
+    n_a_blocks = (a_size + TRANSPOSE_BLOCK - 1) / TRANSPOSE_BLOCK;
+    grain = std::max((size_t) 1, parallel::get_grain_size() / ((size_t) TRANSPOSE_BLOCK * std::max(b_size, 1u)));
+
+    parallel::parallel_for(0, n_outer * n_a_blocks, grain, [&, a_size, b_size, a_stride, b_stride, n_a_blocks](size_t begin, size_t end) {
+        for (size_t idx = begin; idx < end; idx++) {
+            size_t outer = idx / n_a_blocks;
+            unsigned int a0 = (idx % n_a_blocks) * TRANSPOSE_BLOCK, a1 = std::min(a_size, a0 + TRANSPOSE_BLOCK);
+            size_t x_offset = 0, rem = outer;
+
+            for (int i = (int) n_axes - 3; i >= 0; i--) {
+                x_offset += (rem % out_shape[i]) * strides[i];
+                rem /= out_shape[i];
+            }
+
+            const T *x_base = x + x_offset;
+            T *out_base = out + outer * a_size * b_size;
+
+            if (b_stride == 1) {
+                /* the innermost axis is not moved, so whole rows are contiguous */
+                for (unsigned int a = a0; a < a1; a++) std::copy(x_base + a * a_stride, x_base + a * a_stride + b_size, out_base + (size_t) a * b_size);
+                continue;
+            }
+
+            for (unsigned int b0 = 0; b0 < b_size; b0 += TRANSPOSE_BLOCK) {
+                unsigned int b1 = std::min(b_size, b0 + TRANSPOSE_BLOCK);
+
+                for (unsigned int a = a0; a < a1; a++) {
+                    for (unsigned int b = b0; b < b1; b++) {
+                        out_base[(size_t) a * b_size + b] = x_base[a * a_stride + b * b_stride];
+                    }
+                }
+            }
+        }
+    });
+}
+
+template <typename T>
+void permute_full(Tensor<T> *x, const std::vector<unsigned int>& perm, Tensor<T> *out) {
+    std::vector<unsigned int> const& x_shape = x->get_shape();
+    unsigned int n_axes = x_shape.size();
+
+    assert( perm.size() == n_axes );
+    assert( out->get_size() == x->get_size() );
+
+    if (out->get_memory_type() == HOST) {
+        /* a swap of the last two axes of contiguous matrices is a batch of plain transposes */
+        bool leading_fixed = (n_axes >= 2) && perm[n_axes-2] == n_axes-1 && perm[n_axes-1] == n_axes-2;
+        for (unsigned int i = 0; leading_fixed && i + 2 < n_axes; i++) leading_fixed = (perm[i] == i);
+
+        if (leading_fixed) {
+            unsigned int rows = x_shape[n_axes-2], cols = x_shape[n_axes-1];
+            size_t matrix_size = (size_t) rows * cols;
+            size_t n_matrices = x->get_size() / std::max(matrix_size, (size_t) 1);
+
+            for (size_t i = 0; i < n_matrices; i++) {
+                transpose_host(rows, cols, x->get_ptr() + i * matrix_size, out->get_ptr() + i * matrix_size);
+            }
+        } else {
+            permute_host(x_shape, perm, x->get_ptr(), out->get_ptr());
+        }
+    }
+    #if defined(_HAS_CUDA_)
+    else {
+        permute_full_device(x, perm, out);
+    }
+    #endif
+}
+template void permute_full(Tensor<int> *x, const std::vector<unsigned int>& perm, Tensor<int> *out);
+template void permute_full(Tensor<float> *x, const std::vector<unsigned int>& perm, Tensor<float> *out);
+template void permute_full(Tensor<double> *x, const std::vector<unsigned int>& perm, Tensor<double> *out);
+
+}   // namespace internal
 }   // namespace magmadnn
@@ -1,15 +1,58 @@
-
 #include "compute/transpose/transpose_internal.h"
 
 namespace magmadnn {
 namespace internal {
- 
+
+#define PERMUTE_MAX_AXES 8
+
+/* axis sizes of the output and the stride in x of each of them */
+struct permute_args_t {
+    unsigned int n_axes;
+    unsigned int out_shape[PERMUTE_MAX_AXES];
+    size_t strides[PERMUTE_MAX_AXES];
+};
+
 template <typename T>
-__global__ void kernel_transpose_full_device() {}
- 
+__global__ void kernel_permute_full_device(size_t size, const T *x, T *out, permute_args_t args) {
+    size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+    size_t stride = blockDim.x * gridDim.x;
+
+    for (size_t i = idx; i < size; i += stride) {
+        size_t rem = i, x_idx = 0;
+        for (int axis = (int) args.n_axes - 1; axis >= 0; axis--) {
+            x_idx += (rem % args.out_shape[axis]) * args.strides[axis];
+            rem /= args.out_shape[axis];
+        }
+        out[i] = x[x_idx];
+    }
+}
+
 template <typename T>
-void transpose_full_device(Tensor<T> *x, Tensor<T> *out) {
+void permute_full_device(Tensor<T> *x, const std::vector<unsigned int>& perm, Tensor<T> *out) {
+    std::vector<unsigned int> const& x_shape = x->get_shape();
+    size_t x_strides[PERMUTE_MAX_AXES];
+    size_t size = out->get_size();
+    permute_args_t args;
+
+    assert( x_shape.size() <= PERMUTE_MAX_AXES );
+
+    args.n_axes = x_shape.size();
+    x_strides[args.n_axes-1] = 1;
+    for (int i = (int) args.n_axes - 2; i >= 0; i--) x_strides[i] = x_strides[i+1] * x_shape[i+1];
+    for (unsigned int i = 0; i < args.n_axes; i++) {
+        args.out_shape[i] = x_shape[perm[i]];
+        args.strides[i] = x_strides[perm[i]];
+    }
 
+    kernel_permute_full_device <<< (size+255)/256, 256 >>> (size, x->get_ptr(), out->get_ptr(), args);
+}
+template void permute_full_device(Tensor<int> *x, const std::vector<unsigned int>& perm, Tensor<int> *out);
+template void permute_full_device(Tensor<float> *x, const std::vector<unsigned int>& perm, Tensor<float> *out);
+template void permute_full_device(Tensor<double> *x, const std::vector<unsigned int>& perm, Tensor<double> *out);
+
+template <typename T>
+void transpose_full_device(Tensor<T> *x, Tensor<T> *out) {
+    permute_full_device(x, {1, 0}, out);
 }
 template void transpose_full_device(Tensor<int> *x, Tensor<int> *out);
 template void transpose_full_device(Tensor<float> *x, Tensor<float> *out);
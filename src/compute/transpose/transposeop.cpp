@@ -6,36 +6,91 @@ namespace op {
 
 template <typename T>
 TransposeOp<T>::TransposeOp(Operation<T> *x, bool copy, bool needs_grad)
-: Operation<T>::Operation({x}, needs_grad), x(x), copy(copy) {
+: Operation<T>::Operation({x}, needs_grad), x(x), copy(copy), view_of(NULL) {
 
     assert( OP_IS_MATRIX(x) );
 
     this->output_shape = {x->get_output_shape(1), x->get_output_shape(0)};
     this->mem_type = x->get_memory_type();
+    this->perm = {1, 0};
 
+    /* without copy the output is a view of x, made once x's tensor is known */
     if (copy) {
         this->ret = new Tensor<T> (this->output_shape, {NONE, {}}, this->mem_type);
-    } else {
-        std::fprintf(stderr, "Cannot transpose into same tensor.\n");
     }
 }
 
 template <typename T>
-Tensor<T> *TransposeOp<T>::eval(bool recompute) {
-    if (!recompute && this->ret != NULL) {
+TransposeOp<T>::TransposeOp(Operation<T> *x, const std::vector<unsigned int>& perm, bool copy, bool needs_grad)
+: Operation<T>::Operation({x}, needs_grad), x(x), perm(perm), copy(copy), view_of(NULL) {
+
+    std::vector<unsigned int> const& x_shape = x->get_output_shape();
+    std::vector<bool> seen (x_shape.size(), false);
+
+    /* perm must be a permutation of the axes */
+    assert( perm.size() == x_shape.size() );
+    for (unsigned int i = 0; i < perm.size(); i++) {
+        assert( perm[i] < x_shape.size() && !seen[perm[i]] );
+        seen[perm[i]] = true;
+    }
+
+    this->output_shape.resize(perm.size());
+    for (unsigned int i = 0; i < perm.size(); i++) this->output_shape[i] = x_shape[perm[i]];
+    this->mem_type = x->get_memory_type();
+
+    /* without copy the output is a view of x, made once x's tensor is known */
+    if (copy) {
+        this->ret = new Tensor<T> (this->output_shape, {NONE, {}}, this->mem_type);
+    }
+}
+
+template <typename T>
+TransposeOp<T>::~TransposeOp() {
+    if (!copy) delete this->ret;
+}
+
+template <typename T>
+Tensor<T> *TransposeOp<T>::_eval(bool recompute) {
+
+    if (!copy) {
+        x_tensor = x->eval_view(recompute);
+
+        if (x_tensor != view_of) {
+            delete this->ret;
+            this->ret = x_tensor->permute(perm);
+            view_of = x_tensor;
+        }
         return this->ret;
     }
 
     x_tensor = x->eval(recompute);
 
-    internal::transpose_full(x_tensor, this->ret);
+    if (perm.size() == 2) {
+        internal::transpose_full(x_tensor, this->ret);
+    } else {
+        internal::permute_full(x_tensor, perm, this->ret);
+    }
 
     return this->ret;
 }
 
 template <typename T>
 Operation<T> *TransposeOp<T>::grad(Operation<T> *consumer, Operation<T> *var, Operation<T> *grad) {
-    return transpose(grad, true, false);
+    /* the grad is permuted back by the inverse permutation */
+    std::vector<unsigned int> inverse (perm.size());
+    for (unsigned int i = 0; i < perm.size(); i++) inverse[perm[i]] = i;
+
+    return transpose(grad, inverse, true, false);
+}
+
+template <typename T>
+std::string TransposeOp<T>::to_string() {
+    std::string axes;
+
+    if (perm.size() == 2) return x->to_string() + ".T";
+
+    for (unsigned int i = 0; i < perm.size(); i++) axes += ((i != 0) ? "," : "") + std::to_string(perm[i]);
+    return "PERMUTE( " + x->to_string() + ", {" + axes + "} )";
 }
 
 template class TransposeOp<int>;
@@ -51,6 +106,14 @@ template TransposeOp<int> *transpose(Operation<int> *x, bool copy, bool needs_gr
 template TransposeOp<float> *transpose(Operation<float> *x, bool copy, bool needs_grad);
 template TransposeOp<double> *transpose(Operation<double> *x, bool copy, bool needs_grad);
 
+template <typename T>
+TransposeOp<T> *transpose(Operation<T> *x, const std::vector<unsigned int>& perm, bool copy, bool needs_grad) {
+    return new TransposeOp<T>(x, perm, copy, needs_grad);
+}
+template TransposeOp<int> *transpose(Operation<int> *x, const std::vector<unsigned int>& perm, bool copy, bool needs_grad);
+template TransposeOp<float> *transpose(Operation<float> *x, const std::vector<unsigned int>& perm, bool copy, bool needs_grad);
+template TransposeOp<double> *transpose(Operation<double> *x, const std::vector<unsigned int>& perm, bool copy, bool needs_grad);
+
 
 }   // namespace op
 }   // namespace magmadnn
@@ -17,11 +17,13 @@ Variable<T>::Variable(std::string name, std::vector<unsigned int> shape, tensor_
     val = new Tensor<T> (shape, filler, mem_type);
     delete_tensor = true;
 
+    this->ret = val;
     this->output_shape = val->get_shape();
     this->mem_type = val->get_memory_type();
 }
 template <typename T>
 Variable<T>::Variable(std::string name, Tensor<T> *val) : Operation<T>::Operation(), name(name), val(val) {
+    this->ret = val;
     this->output_shape = val->get_shape();
     this->mem_type = val->get_memory_type();
     delete_tensor = false;
@@ -33,7 +35,7 @@ Variable<T>::~Variable() {
 }
 
 template <typename T>
-Tensor<T>* Variable<T>::eval(bool recompute) {
+Tensor<T>* Variable<T>::_eval(bool recompute) {
     return val;
 }
 
@@ -0,0 +1,140 @@
+/**
+ * @file vmath_avx2.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-07
+ *
+ * AVX2 and FMA versions of the vmath kernels. Everything in this file is compiled for AVX2, so
+ * it is only called after checking that the CPU supports it.
+ *
+ * @copyright Copyright (c) 2019
+ */
+#if (defined(__GNUC__) && !defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#pragma GCC target("avx2,fma")
+
+#include <immintrin.h>
+#include "compute/vmath/vmath_kernels.h"
+
+namespace magmadnn {
+namespace internal {
+namespace vmath {
+
+namespace {
+
+struct avx2_ps {
+    typedef float scalar;
+    typedef __m256 reg;
+    typedef __m256 mask;
+    enum { width = 8 };
+
+    static inline reg set1(float a) { return _mm256_set1_ps(a); }
+    static inline reg load(const float *p) { return _mm256_loadu_ps(p); }
+    static inline void store(float *p, reg a) { _mm256_storeu_ps(p, a); }
+    static inline reg load_aligned(const float *p) { return _mm256_load_ps(p); }
+    static inline void store_aligned(float *p, reg a) { _mm256_store_ps(p, a); }
+    static inline reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+    static inline reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+    static inline reg div(reg a, reg b) { return _mm256_div_ps(a, b); }
+    static inline reg sqrt(reg a) { return _mm256_sqrt_ps(a); }
+    static inline reg fma(reg a, reg b, reg c) { return _mm256_fmadd_ps(a, b, c); }
+    static inline reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+    static inline reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+    static inline reg abs(reg a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static inline reg round(reg a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static inline mask lt(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static inline mask gt(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static inline mask eq(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static inline mask isnan(reg a) { return _mm256_cmp_ps(a, a, _CMP_UNORD_Q); }
+    static inline reg select(mask m, reg a, reg b) { return _mm256_blendv_ps(b, a, m); }
+
+    static inline reg copysign(reg a, reg b) {
+        const reg sign = _mm256_set1_ps(-0.0f);
+        return _mm256_or_ps(_mm256_andnot_ps(sign, a), _mm256_and_ps(sign, b));
+    }
+
+    static inline reg pow2(reg n) {
+        __m256i e = _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+        return _mm256_castsi256_ps(_mm256_slli_epi32(e, 23));
+    }
+
+    static inline reg frexp(reg x, reg& e) {
+        __m256i xi = _mm256_castps_si256(x);
+        __m256i ei = _mm256_sub_epi32(_mm256_srli_epi32(xi, 23), _mm256_set1_epi32(126));
+        e = _mm256_cvtepi32_ps(ei);
+        xi = _mm256_and_si256(xi, _mm256_set1_epi32(0x807fffff));
+        return _mm256_castsi256_ps(_mm256_or_si256(xi, _mm256_set1_epi32(0x3f000000)));
+    }
+};
+
+struct avx2_pd {
+    typedef double scalar;
+    typedef __m256d reg;
+    typedef __m256d mask;
+    enum { width = 4 };
+
+    static inline reg set1(double a) { return _mm256_set1_pd(a); }
+    static inline reg load(const double *p) { return _mm256_loadu_pd(p); }
+    static inline void store(double *p, reg a) { _mm256_storeu_pd(p, a); }
+    static inline reg load_aligned(const double *p) { return _mm256_load_pd(p); }
+    static inline void store_aligned(double *p, reg a) { _mm256_store_pd(p, a); }
+    static inline reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+    static inline reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+    static inline reg div(reg a, reg b) { return _mm256_div_pd(a, b); }
+    static inline reg sqrt(reg a) { return _mm256_sqrt_pd(a); }
+    static inline reg fma(reg a, reg b, reg c) { return _mm256_fmadd_pd(a, b, c); }
+    static inline reg min(reg a, reg b) { return _mm256_min_pd(a, b); }
+    static inline reg max(reg a, reg b) { return _mm256_max_pd(a, b); }
+    static inline reg abs(reg a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static inline reg round(reg a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static inline mask lt(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static inline mask gt(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static inline mask eq(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static inline mask isnan(reg a) { return _mm256_cmp_pd(a, a, _CMP_UNORD_Q); }
+    static inline reg select(mask m, reg a, reg b) { return _mm256_blendv_pd(b, a, m); }
+
+    static inline reg copysign(reg a, reg b) {
+        const reg sign = _mm256_set1_pd(-0.0);
+        return _mm256_or_pd(_mm256_andnot_pd(sign, a), _mm256_and_pd(sign, b));
+    }
+
+    /* there is no 64 bit conversion in AVX2, so the integer is taken from the low bits of n + 1.5*2^52 */
+    static inline reg pow2(reg n) {
+        __m256i e = _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(6755399441055744.0 + 1023.0)));
+        return _mm256_castsi256_pd(_mm256_slli_epi64(e, 52));
+    }
+
+    static inline reg frexp(reg x, reg& e) {
+        const reg two52 = _mm256_set1_pd(4503599627370496.0);
+        __m256i xi = _mm256_castpd_si256(x);
+        __m256i ei = _mm256_or_si256(_mm256_srli_epi64(xi, 52), _mm256_castpd_si256(two52));
+        e = _mm256_sub_pd(_mm256_sub_pd(_mm256_castsi256_pd(ei), two52), _mm256_set1_pd(1022.0));
+        xi = _mm256_and_si256(xi, _mm256_set1_epi64x(0x800fffffffffffffLL));
+        return _mm256_castsi256_pd(_mm256_or_si256(xi, _mm256_set1_epi64x(0x3fe0000000000000LL)));
+    }
+};
+
+}   // namespace
+
+void exp_avx2(size_t n, const float *x, float *out) { map<avx2_ps, exp_ps<avx2_ps> >(n, x, out); }
+void exp_avx2(size_t n, const double *x, double *out) { map<avx2_pd, exp_pd<avx2_pd> >(n, x, out); }
+void log_avx2(size_t n, const float *x, float *out) { map<avx2_ps, log_ps<avx2_ps> >(n, x, out); }
+void log_avx2(size_t n, const double *x, double *out) { map<avx2_pd, log_pd<avx2_pd> >(n, x, out); }
+void tanh_avx2(size_t n, const float *x, float *out) { map<avx2_ps, tanh_ps<avx2_ps> >(n, x, out); }
+void tanh_avx2(size_t n, const double *x, double *out) { map<avx2_pd, tanh_pd<avx2_pd> >(n, x, out); }
+void sigmoid_avx2(size_t n, const float *x, float *out) { map<avx2_ps, sigmoid_ps<avx2_ps> >(n, x, out); }
+void sigmoid_avx2(size_t n, const double *x, double *out) { map<avx2_pd, sigmoid_pd<avx2_pd> >(n, x, out); }
+
+void adam_avx2(size_t n, float *var, const float *grad, float *m, float *v, float step, float beta1, float beta2, float epsilon) {
+    adam<avx2_ps>(n, var, grad, m, v, step, beta1, beta2, epsilon);
+}
+void adam_avx2(size_t n, double *var, const double *grad, double *m, double *v, double step, double beta1, double beta2, double epsilon) {
+    adam<avx2_pd>(n, var, grad, m, v, step, beta1, beta2, epsilon);
+}
+
+}   // namespace vmath
+}   // namespace internal
+}   // namespace magmadnn
+
+#endif
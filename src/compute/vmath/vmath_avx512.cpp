@@ -0,0 +1,145 @@
+/**
+ * @file vmath_avx512.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-07
+ *
+ * AVX-512F versions of the vmath kernels. Everything in this file is compiled for AVX-512F, so
+ * it is only called after checking that the CPU supports it.
+ *
+ * @copyright Copyright (c) 2019
+ */
+#if (defined(__GNUC__) && !defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#pragma GCC target("avx512f")
+
+/* the AVX-512 intrinsics start from _mm512_undefined_*, which gcc reports as uninitialized */
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include <immintrin.h>
+#include "compute/vmath/vmath_kernels.h"
+
+namespace magmadnn {
+namespace internal {
+namespace vmath {
+
+namespace {
+
+struct avx512_ps {
+    typedef float scalar;
+    typedef __m512 reg;
+    typedef __mmask16 mask;
+    enum { width = 16 };
+
+    static inline reg set1(float a) { return _mm512_set1_ps(a); }
+    static inline reg load(const float *p) { return _mm512_loadu_ps(p); }
+    static inline void store(float *p, reg a) { _mm512_storeu_ps(p, a); }
+    static inline reg load_aligned(const float *p) { return _mm512_load_ps(p); }
+    static inline void store_aligned(float *p, reg a) { _mm512_store_ps(p, a); }
+    static inline reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+    static inline reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+    static inline reg div(reg a, reg b) { return _mm512_div_ps(a, b); }
+    static inline reg sqrt(reg a) { return _mm512_sqrt_ps(a); }
+    static inline reg fma(reg a, reg b, reg c) { return _mm512_fmadd_ps(a, b, c); }
+    static inline reg min(reg a, reg b) { return _mm512_min_ps(a, b); }
+    static inline reg max(reg a, reg b) { return _mm512_max_ps(a, b); }
+    static inline reg abs(reg a) { return _mm512_abs_ps(a); }
+    static inline reg round(reg a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static inline mask lt(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static inline mask gt(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+    static inline mask eq(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+    static inline mask isnan(reg a) { return _mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q); }
+    static inline reg select(mask m, reg a, reg b) { return _mm512_mask_blend_ps(m, b, a); }
+
+    static inline reg copysign(reg a, reg b) {
+        const __m512i sign = _mm512_set1_epi32(0x80000000);
+        __m512i mag = _mm512_andnot_si512(sign, _mm512_castps_si512(a));
+        return _mm512_castsi512_ps(_mm512_or_si512(mag, _mm512_and_si512(sign, _mm512_castps_si512(b))));
+    }
+
+    static inline reg pow2(reg n) {
+        __m512i e = _mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127));
+        return _mm512_castsi512_ps(_mm512_slli_epi32(e, 23));
+    }
+
+    static inline reg frexp(reg x, reg& e) {
+        __m512i xi = _mm512_castps_si512(x);
+        __m512i ei = _mm512_sub_epi32(_mm512_srli_epi32(xi, 23), _mm512_set1_epi32(126));
+        e = _mm512_cvtepi32_ps(ei);
+        xi = _mm512_and_si512(xi, _mm512_set1_epi32(0x807fffff));
+        return _mm512_castsi512_ps(_mm512_or_si512(xi, _mm512_set1_epi32(0x3f000000)));
+    }
+};
+
+struct avx512_pd {
+    typedef double scalar;
+    typedef __m512d reg;
+    typedef __mmask8 mask;
+    enum { width = 8 };
+
+    static inline reg set1(double a) { return _mm512_set1_pd(a); }
+    static inline reg load(const double *p) { return _mm512_loadu_pd(p); }
+    static inline void store(double *p, reg a) { _mm512_storeu_pd(p, a); }
+    static inline reg load_aligned(const double *p) { return _mm512_load_pd(p); }
+    static inline void store_aligned(double *p, reg a) { _mm512_store_pd(p, a); }
+    static inline reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+    static inline reg sub(reg a, reg b) { return _mm512_sub_pd(a, b); }
+    static inline reg mul(reg a, reg b) { return _mm512_mul_pd(a, b); }
+    static inline reg div(reg a, reg b) { return _mm512_div_pd(a, b); }
+    static inline reg sqrt(reg a) { return _mm512_sqrt_pd(a); }
+    static inline reg fma(reg a, reg b, reg c) { return _mm512_fmadd_pd(a, b, c); }
+    static inline reg min(reg a, reg b) { return _mm512_min_pd(a, b); }
+    static inline reg max(reg a, reg b) { return _mm512_max_pd(a, b); }
+    static inline reg abs(reg a) { return _mm512_abs_pd(a); }
+    static inline reg round(reg a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static inline mask lt(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static inline mask gt(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    static inline mask eq(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    static inline mask isnan(reg a) { return _mm512_cmp_pd_mask(a, a, _CMP_UNORD_Q); }
+    static inline reg select(mask m, reg a, reg b) { return _mm512_mask_blend_pd(m, b, a); }
+
+    static inline reg copysign(reg a, reg b) {
+        const __m512i sign = _mm512_set1_epi64(0x8000000000000000LL);
+        __m512i mag = _mm512_andnot_si512(sign, _mm512_castpd_si512(a));
+        return _mm512_castsi512_pd(_mm512_or_si512(mag, _mm512_and_si512(sign, _mm512_castpd_si512(b))));
+    }
+
+    /* 64 bit conversions need AVX-512DQ, so the integer is taken from the low bits of n + 1.5*2^52 */
+    static inline reg pow2(reg n) {
+        __m512i e = _mm512_castpd_si512(_mm512_add_pd(n, _mm512_set1_pd(6755399441055744.0 + 1023.0)));
+        return _mm512_castsi512_pd(_mm512_slli_epi64(e, 52));
+    }
+
+    static inline reg frexp(reg x, reg& e) {
+        const reg two52 = _mm512_set1_pd(4503599627370496.0);
+        __m512i xi = _mm512_castpd_si512(x);
+        __m512i ei = _mm512_or_si512(_mm512_srli_epi64(xi, 52), _mm512_castpd_si512(two52));
+        e = _mm512_sub_pd(_mm512_sub_pd(_mm512_castsi512_pd(ei), two52), _mm512_set1_pd(1022.0));
+        xi = _mm512_and_si512(xi, _mm512_set1_epi64(0x800fffffffffffffLL));
+        return _mm512_castsi512_pd(_mm512_or_si512(xi, _mm512_set1_epi64(0x3fe0000000000000LL)));
+    }
+};
+
+}   // namespace
+
+void exp_avx512(size_t n, const float *x, float *out) { map<avx512_ps, exp_ps<avx512_ps> >(n, x, out); }
+void exp_avx512(size_t n, const double *x, double *out) { map<avx512_pd, exp_pd<avx512_pd> >(n, x, out); }
+void log_avx512(size_t n, const float *x, float *out) { map<avx512_ps, log_ps<avx512_ps> >(n, x, out); }
+void log_avx512(size_t n, const double *x, double *out) { map<avx512_pd, log_pd<avx512_pd> >(n, x, out); }
+void tanh_avx512(size_t n, const float *x, float *out) { map<avx512_ps, tanh_ps<avx512_ps> >(n, x, out); }
+void tanh_avx512(size_t n, const double *x, double *out) { map<avx512_pd, tanh_pd<avx512_pd> >(n, x, out); }
+void sigmoid_avx512(size_t n, const float *x, float *out) { map<avx512_ps, sigmoid_ps<avx512_ps> >(n, x, out); }
+void sigmoid_avx512(size_t n, const double *x, double *out) { map<avx512_pd, sigmoid_pd<avx512_pd> >(n, x, out); }
+
+void adam_avx512(size_t n, float *var, const float *grad, float *m, float *v, float step, float beta1, float beta2, float epsilon) {
+    adam<avx512_ps>(n, var, grad, m, v, step, beta1, beta2, epsilon);
+}
+void adam_avx512(size_t n, double *var, const double *grad, double *m, double *v, double step, double beta1, double beta2, double epsilon) {
+    adam<avx512_pd>(n, var, grad, m, v, step, beta1, beta2, epsilon);
+}
+
+}   // namespace vmath
+}   // namespace internal
+}   // namespace magmadnn
+
+#endif
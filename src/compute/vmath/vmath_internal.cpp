@@ -0,0 +1,243 @@
+/**
+ * @file vmath_internal.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-07
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "compute/vmath/vmath_internal.h"
+
+#include <cstring>
+#include <cstdint>
+
+namespace magmadnn {
+namespace internal {
+
+namespace vmath {
+namespace {
+
+/* the portable versions work on one element at a time */
+struct generic_ps {
+    typedef float scalar;
+    typedef float reg;
+    typedef bool mask;
+    enum { width = 1 };
+
+    static inline reg set1(float a) { return a; }
+    static inline reg load(const float *p) { return *p; }
+    static inline void store(float *p, reg a) { *p = a; }
+    static inline reg load_aligned(const float *p) { return *p; }
+    static inline void store_aligned(float *p, reg a) { *p = a; }
+    static inline reg add(reg a, reg b) { return a + b; }
+    static inline reg sub(reg a, reg b) { return a - b; }
+    static inline reg mul(reg a, reg b) { return a * b; }
+    static inline reg div(reg a, reg b) { return a / b; }
+    static inline reg sqrt(reg a) { return std::sqrt(a); }
+    static inline reg fma(reg a, reg b, reg c) { return a * b + c; }
+    static inline reg min(reg a, reg b) { return (a < b) ? a : b; }
+    static inline reg max(reg a, reg b) { return (a > b) ? a : b; }
+    static inline reg abs(reg a) { return std::fabs(a); }
+    static inline reg round(reg a) { return std::nearbyint(a); }
+    static inline mask lt(reg a, reg b) { return a < b; }
+    static inline mask gt(reg a, reg b) { return a > b; }
+    static inline mask eq(reg a, reg b) { return a == b; }
+    static inline mask isnan(reg a) { return a != a; }
+    static inline reg select(mask m, reg a, reg b) { return (m) ? a : b; }
+    static inline reg copysign(reg a, reg b) { return std::copysign(a, b); }
+
+    static inline reg pow2(reg n) {
+        uint32_t bits = ((uint32_t) ((int32_t) n + 127)) << 23;
+        float r;
+        std::memcpy(&r, &bits, sizeof(r));
+        return r;
+    }
+
+    static inline reg frexp(reg x, reg& e) {
+        uint32_t bits;
+        float m;
+        std::memcpy(&bits, &x, sizeof(bits));
+        e = (float) ((int32_t) (bits >> 23) - 126);
+        bits = (bits & 0x807fffffu) | 0x3f000000u;
+        std::memcpy(&m, &bits, sizeof(m));
+        return m;
+    }
+};
+
+struct generic_pd {
+    typedef double scalar;
+    typedef double reg;
+    typedef bool mask;
+    enum { width = 1 };
+
+    static inline reg set1(double a) { return a; }
+    static inline reg load(const double *p) { return *p; }
+    static inline void store(double *p, reg a) { *p = a; }
+    static inline reg load_aligned(const double *p) { return *p; }
+    static inline void store_aligned(double *p, reg a) { *p = a; }
+    static inline reg add(reg a, reg b) { return a + b; }
+    static inline reg sub(reg a, reg b) { return a - b; }
+    static inline reg mul(reg a, reg b) { return a * b; }
+    static inline reg div(reg a, reg b) { return a / b; }
+    static inline reg sqrt(reg a) { return std::sqrt(a); }
+    static inline reg fma(reg a, reg b, reg c) { return a * b + c; }
+    static inline reg min(reg a, reg b) { return (a < b) ? a : b; }
+    static inline reg max(reg a, reg b) { return (a > b) ? a : b; }
+    static inline reg abs(reg a) { return std::fabs(a); }
+    static inline reg round(reg a) { return std::nearbyint(a); }
+    static inline mask lt(reg a, reg b) { return a < b; }
+    static inline mask gt(reg a, reg b) { return a > b; }
+    static inline mask eq(reg a, reg b) { return a == b; }
+    static inline mask isnan(reg a) { return a != a; }
+    static inline reg select(mask m, reg a, reg b) { return (m) ? a : b; }
+    static inline reg copysign(reg a, reg b) { return std::copysign(a, b); }
+
+    static inline reg pow2(reg n) {
+        uint64_t bits = ((uint64_t) ((int64_t) n + 1023)) << 52;
+        double r;
+        std::memcpy(&r, &bits, sizeof(r));
+        return r;
+    }
+
+    static inline reg frexp(reg x, reg& e) {
+        uint64_t bits;
+        double m;
+        std::memcpy(&bits, &x, sizeof(bits));
+        e = (double) ((int64_t) (bits >> 52) - 1022);
+        bits = (bits & 0x800fffffffffffffull) | 0x3fe0000000000000ull;
+        std::memcpy(&m, &bits, sizeof(m));
+        return m;
+    }
+};
+
+void exp_generic(size_t n, const float *x, float *out) { map<generic_ps, exp_ps<generic_ps> >(n, x, out); }
+void exp_generic(size_t n, const double *x, double *out) { map<generic_pd, exp_pd<generic_pd> >(n, x, out); }
+void log_generic(size_t n, const float *x, float *out) { map<generic_ps, log_ps<generic_ps> >(n, x, out); }
+void log_generic(size_t n, const double *x, double *out) { map<generic_pd, log_pd<generic_pd> >(n, x, out); }
+void tanh_generic(size_t n, const float *x, float *out) { map<generic_ps, tanh_ps<generic_ps> >(n, x, out); }
+void tanh_generic(size_t n, const double *x, double *out) { map<generic_pd, tanh_pd<generic_pd> >(n, x, out); }
+void sigmoid_generic(size_t n, const float *x, float *out) { map<generic_ps, sigmoid_ps<generic_ps> >(n, x, out); }
+void sigmoid_generic(size_t n, const double *x, double *out) { map<generic_pd, sigmoid_pd<generic_pd> >(n, x, out); }
+
+void adam_generic(size_t n, float *var, const float *grad, float *m, float *v, float step, float beta1, float beta2, float epsilon) {
+    adam<generic_ps>(n, var, grad, m, v, step, beta1, beta2, epsilon);
+}
+void adam_generic(size_t n, double *var, const double *grad, double *m, double *v, double step, double beta1, double beta2, double epsilon) {
+    adam<generic_pd>(n, var, grad, m, v, step, beta1, beta2, epsilon);
+}
+
+}   // namespace
+}   // namespace vmath
+
+
+/* the functions for each instruction set */
+template <typename T>
+struct vmath_table_t {
+    void (*exp)(size_t, const T *, T *);
+    void (*log)(size_t, const T *, T *);
+    void (*tanh)(size_t, const T *, T *);
+    void (*sigmoid)(size_t, const T *, T *);
+    void (*adam)(size_t, T *, const T *, T *, T *, T, T, T, T);
+};
+
+static vmath_isa_t best_isa() {
+    if (vmath_isa_supported(VMATH_AVX512)) return VMATH_AVX512;
+    if (vmath_isa_supported(VMATH_AVX2)) return VMATH_AVX2;
+    return VMATH_GENERIC;
+}
+
+static vmath_isa_t& current_isa() {
+    static vmath_isa_t isa = best_isa();
+    return isa;
+}
+
+template <typename T>
+static vmath_table_t<T> make_table(vmath_isa_t isa) {
+    vmath_table_t<T> t;
+
+    t.exp = vmath::exp_generic;
+    t.log = vmath::log_generic;
+    t.tanh = vmath::tanh_generic;
+    t.sigmoid = vmath::sigmoid_generic;
+    t.adam = vmath::adam_generic;
+
+    #if defined(MAGMADNN_VMATH_X86)
+    if (isa == VMATH_AVX512) {
+        t.exp = vmath::exp_avx512;
+        t.log = vmath::log_avx512;
+        t.tanh = vmath::tanh_avx512;
+        t.sigmoid = vmath::sigmoid_avx512;
+        t.adam = vmath::adam_avx512;
+    } else if (isa == VMATH_AVX2) {
+        t.exp = vmath::exp_avx2;
+        t.log = vmath::log_avx2;
+        t.tanh = vmath::tanh_avx2;
+        t.sigmoid = vmath::sigmoid_avx2;
+        t.adam = vmath::adam_avx2;
+    }
+    #endif
+
+    return t;
+}
+
+template <typename T>
+static vmath_table_t<T>& table() {
+    static vmath_table_t<T> t = make_table<T>(current_isa());
+    return t;
+}
+
+bool vmath_isa_supported(vmath_isa_t isa) {
+    switch (isa) {
+        case VMATH_GENERIC:
+            return true;
+        #if defined(MAGMADNN_VMATH_X86)
+        case VMATH_AVX2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case VMATH_AVX512:
+            return __builtin_cpu_supports("avx512f");
+        #endif
+        default:
+            return false;
+    }
+}
+
+vmath_isa_t vmath_get_isa() {
+    return current_isa();
+}
+
+bool vmath_set_isa(vmath_isa_t isa) {
+    if (!vmath_isa_supported(isa)) return false;
+
+    current_isa() = isa;
+    table<float>() = make_table<float>(isa);
+    table<double>() = make_table<double>(isa);
+    return true;
+}
+
+const char *vmath_isa_name(vmath_isa_t isa) {
+    switch (isa) {
+        case VMATH_GENERIC: return "generic";
+        case VMATH_AVX2: return "avx2";
+        case VMATH_AVX512: return "avx512";
+        default: return "unknown";
+    }
+}
+
+void vexp(size_t n, const float *x, float *out) { table<float>().exp(n, x, out); }
+void vexp(size_t n, const double *x, double *out) { table<double>().exp(n, x, out); }
+void vlog(size_t n, const float *x, float *out) { table<float>().log(n, x, out); }
+void vlog(size_t n, const double *x, double *out) { table<double>().log(n, x, out); }
+void vtanh(size_t n, const float *x, float *out) { table<float>().tanh(n, x, out); }
+void vtanh(size_t n, const double *x, double *out) { table<double>().tanh(n, x, out); }
+void vsigmoid(size_t n, const float *x, float *out) { table<float>().sigmoid(n, x, out); }
+void vsigmoid(size_t n, const double *x, double *out) { table<double>().sigmoid(n, x, out); }
+
+void vadam(size_t n, float *var, const float *grad, float *m, float *v, float step, float beta1, float beta2, float epsilon) {
+    table<float>().adam(n, var, grad, m, v, step, beta1, beta2, epsilon);
+}
+void vadam(size_t n, double *var, const double *grad, double *m, double *v, double step, double beta1, double beta2, double epsilon) {
+    table<double>().adam(n, var, grad, m, v, step, beta1, beta2, epsilon);
+}
+
+}   // namespace internal
+}   // namespace magmadnn
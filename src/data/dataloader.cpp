@@ -0,0 +1,185 @@
+/**
+ * @file dataloader.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-19
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "data/dataloader.h"
+
+namespace magmadnn {
+namespace data {
+
+/* one value per feature from a list that is empty, has one value, or has one per feature */
+static std::vector<double> per_feature(const std::vector<double>& values, size_t n_features, double fallback) {
+    if (values.empty()) return std::vector<double> (n_features, fallback);
+    if (values.size() == 1) return std::vector<double> (n_features, values[0]);
+
+    assert( values.size() == n_features );
+    return values;
+}
+
+template <typename T>
+template <typename S>
+DataLoader<T>::DataLoader(Tensor<S> *x, Tensor<S> *y, const dataloader_params_t& params, memory_t mem_type)
+    : params(params), mem_type(mem_type), next_batch(0), fill_buf(0), fill_requested(true), filled(false), stop(false) {
+
+    assert( x->get_memory_type() == HOST && x->is_contiguous() );
+    assert( y->get_memory_type() == HOST && y->is_contiguous() );
+
+    this->n_samples = x->get_shape(0);
+    if (y->get_shape(0) != this->n_samples || params.batch_size == 0 || params.batch_size > this->n_samples) {
+        std::fprintf(stderr, "Error: x and y must have the same number of rows, and at least batch_size.\n");
+        assert( false );
+    }
+    this->n_batches = this->n_samples / params.batch_size;
+
+    this->x_row_size = x->get_size() / this->n_samples;
+    this->y_row_size = y->get_size() / this->n_samples;
+
+    /* the loader only reads x and y, and only on the producer thread */
+    const S *x_ptr = x->get_ptr();
+    const S *y_ptr = y->get_ptr();
+    size_t x_row_size = this->x_row_size, y_row_size = this->y_row_size;
+    this->read_row = [x_ptr, y_ptr, x_row_size, y_row_size](unsigned int src_row, T *x_dst, T *y_dst) {
+        const S *x_src = x_ptr + ((size_t) src_row) * x_row_size;
+        const S *y_src = y_ptr + ((size_t) src_row) * y_row_size;
+        for (size_t j = 0; j < x_row_size; j++) x_dst[j] = (T) x_src[j];
+        for (size_t j = 0; j < y_row_size; j++) y_dst[j] = (T) y_src[j];
+    };
+
+    if (!params.mean.empty() || !params.stddev.empty()) {
+        this->mean = per_feature(params.mean, this->x_row_size, 0.0);
+        this->inv_stddev = per_feature(params.stddev, this->x_row_size, 1.0);
+        for (size_t j = 0; j < this->x_row_size; j++) this->inv_stddev[j] = 1.0 / this->inv_stddev[j];
+    }
+
+    std::vector<unsigned int> x_shape = x->get_shape(), y_shape = y->get_shape();
+    x_shape[0] = params.batch_size;
+    y_shape[0] = params.batch_size;
+
+    for (unsigned int i = 0; i < 2; i++) {
+        this->x_buf[i] = new Tensor<T> (x_shape, {NONE, {}}, mem_type);
+        this->y_buf[i] = new Tensor<T> (y_shape, {NONE, {}}, mem_type);
+    }
+    if (mem_type != HOST) {
+        this->x_stage = new Tensor<T> (x_shape, {NONE, {}}, HOST);
+        this->y_stage = new Tensor<T> (y_shape, {NONE, {}}, HOST);
+    } else {
+        this->x_stage = NULL;
+        this->y_stage = NULL;
+    }
+
+    this->order.resize(this->n_samples);
+    std::iota(this->order.begin(), this->order.end(), 0);
+
+    this->producer = std::thread(&DataLoader<T>::producer_loop, this);
+}
+
+template <typename T>
+DataLoader<T>::~DataLoader() {
+    {
+        std::lock_guard<std::mutex> guard (this->lock);
+        this->stop = true;
+    }
+    this->cond.notify_all();
+    this->producer.join();
+
+    for (unsigned int i = 0; i < 2; i++) {
+        delete this->x_buf[i];
+        delete this->y_buf[i];
+    }
+    if (this->x_stage != NULL) delete this->x_stage;
+    if (this->y_stage != NULL) delete this->y_stage;
+}
+
+template <typename T>
+void DataLoader<T>::next(Tensor<T> *&x_batch, Tensor<T> *&y_batch) {
+    std::unique_lock<std::mutex> guard (this->lock);
+    this->cond.wait(guard, [this] { return this->filled; });
+
+    x_batch = this->x_buf[this->fill_buf];
+    y_batch = this->y_buf[this->fill_buf];
+
+    /* the other buffer was handed out by the last call, which the caller is done with now */
+    this->fill_buf ^= 1;
+    this->filled = false;
+    this->fill_requested = true;
+
+    guard.unlock();
+    this->cond.notify_all();
+}
+
+template <typename T>
+void DataLoader<T>::producer_loop() {
+    while (true) {
+        unsigned int buf;
+        {
+            std::unique_lock<std::mutex> guard (this->lock);
+            this->cond.wait(guard, [this] { return this->fill_requested || this->stop; });
+            if (this->stop) return;
+            buf = this->fill_buf;
+        }
+
+        /* next() does not touch buffer buf or the producer's state until filled is set */
+        fill(buf);
+
+        {
+            std::lock_guard<std::mutex> guard (this->lock);
+            this->fill_requested = false;
+            this->filled = true;
+        }
+        this->cond.notify_all();
+    }
+}
+
+template <typename T>
+void DataLoader<T>::fill(unsigned int buf) {
+    unsigned int batch_size = this->params.batch_size;
+
+    if (this->next_batch == 0 && this->params.shuffle) {
+        std::shuffle(this->order.begin(), this->order.end(), this->shuffle_engine);
+    }
+
+    Tensor<T> *x_dst = (this->mem_type == HOST) ? this->x_buf[buf] : this->x_stage;
+    Tensor<T> *y_dst = (this->mem_type == HOST) ? this->y_buf[buf] : this->y_stage;
+    T *x_ptr = x_dst->get_ptr();
+    T *y_ptr = y_dst->get_ptr();
+    const unsigned int *rows = &this->order[((size_t) this->next_batch) * batch_size];
+
+    for (unsigned int i = 0; i < batch_size; i++) {
+        T *x_row = x_ptr + ((size_t) i) * this->x_row_size;
+        this->read_row(rows[i], x_row, y_ptr + ((size_t) i) * this->y_row_size);
+
+        if (!this->mean.empty()) {
+            for (size_t j = 0; j < this->x_row_size; j++) {
+                x_row[j] = (T) ((x_row[j] - this->mean[j]) * this->inv_stddev[j]);
+            }
+        }
+    }
+
+    if (this->mem_type != HOST) {
+        this->x_buf[buf]->copy_from(*this->x_stage);
+        this->y_buf[buf]->copy_from(*this->y_stage);
+    }
+
+    this->next_batch = (this->next_batch + 1) % this->n_batches;
+}
+
+template class DataLoader<int>;
+template class DataLoader<float>;
+template class DataLoader<double>;
+
+template DataLoader<int>::DataLoader(Tensor<int> *x, Tensor<int> *y, const dataloader_params_t& params, memory_t mem_type);
+template DataLoader<int>::DataLoader(Tensor<float> *x, Tensor<float> *y, const dataloader_params_t& params, memory_t mem_type);
+template DataLoader<int>::DataLoader(Tensor<double> *x, Tensor<double> *y, const dataloader_params_t& params, memory_t mem_type);
+template DataLoader<float>::DataLoader(Tensor<int> *x, Tensor<int> *y, const dataloader_params_t& params, memory_t mem_type);
+template DataLoader<float>::DataLoader(Tensor<float> *x, Tensor<float> *y, const dataloader_params_t& params, memory_t mem_type);
+template DataLoader<float>::DataLoader(Tensor<double> *x, Tensor<double> *y, const dataloader_params_t& params, memory_t mem_type);
+template DataLoader<double>::DataLoader(Tensor<int> *x, Tensor<int> *y, const dataloader_params_t& params, memory_t mem_type);
+template DataLoader<double>::DataLoader(Tensor<float> *x, Tensor<float> *y, const dataloader_params_t& params, memory_t mem_type);
+template DataLoader<double>::DataLoader(Tensor<double> *x, Tensor<double> *y, const dataloader_params_t& params, memory_t mem_type);
+
+}   // namespace data
+}   // namespace magmadnn
@@ -31,21 +31,26 @@ std::vector<op::Operation<T> *> ActivationLayer<T>::get_weights() {
 }
 
 template <typename T>
-void ActivationLayer<T>::init() {
-    this->name = "Activation";
-    
+op::Operation<T> *ActivationLayer<T>::forward(op::Operation<T> *input) {
     switch (this->activation_func) {
         case SIGMOID:
-            this->output = op::sigmoid(this->input, false, true); break;
+            return op::sigmoid(input, false, true);
         case TANH:
-            this->output = op::tanh(this->input, false); break;
+            return op::tanh(input, false);
         case RELU:
             fprintf(stderr, "RELU not implemented yet.\n");
         default:
-            this->output = op::sigmoid(this->input, false, true); break;
+            return op::sigmoid(input, false, true);
     }
 }
 
+template <typename T>
+void ActivationLayer<T>::init() {
+    this->name = "Activation";
+    
+    this->output = forward(this->input);
+}
+
 template class ActivationLayer <int>;
 template class ActivationLayer <float>;
 template class ActivationLayer <double>;
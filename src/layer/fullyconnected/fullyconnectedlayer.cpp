@@ -13,7 +13,16 @@ namespace layer {
 
 template <typename T>
 FullyConnectedLayer<T>::FullyConnectedLayer(op::Operation<T> *input, unsigned int hidden_units, bool use_bias) 
-    : Layer<T>::Layer(input->get_output_shape(), input), hidden_units(hidden_units), use_bias(use_bias) {
+    : Layer<T>::Layer(input->get_output_shape(), input), hidden_units(hidden_units), use_bias(use_bias), fused(false),
+    activation_func(SIGMOID) {
+    
+    init();
+}
+
+template <typename T>
+FullyConnectedLayer<T>::FullyConnectedLayer(op::Operation<T> *input, unsigned int hidden_units, activation_t activation_func, bool use_bias) 
+    : Layer<T>::Layer(input->get_output_shape(), input), hidden_units(hidden_units), use_bias(use_bias), fused(true),
+    activation_func(activation_func) {
     
     init();
 }
@@ -26,6 +35,7 @@ FullyConnectedLayer<T>::~FullyConnectedLayer() {
 
 template <typename T>
 std::vector<op::Operation<T> *> FullyConnectedLayer<T>::get_weights() {
+    if (use_bias) return {this->weights, this->bias};
     return {this->weights};
 }
 
@@ -43,9 +53,41 @@ void FullyConnectedLayer<T>::init() {
     this->bias_tensor = new Tensor<T> ({1, this->hidden_units}, {GLOROT, {(T)0.0, (T)0.5}}, this->input->get_memory_type());
     this->bias = op::var("__"+this->name+"_layer_bias", this->bias_tensor);
 
-    /*  output = (weights) * (input) + (bias) 
-        this creates a new tensor and puts it into a new var, which is stored in output. */
-    this->output = op::matmul(this->input, this->weights);
+    this->output = build(this->input, this->weights, this->bias);
+}
+
+template <typename T>
+op::Operation<T> *FullyConnectedLayer<T>::forward(op::Operation<T> *input) {
+    /* variables of their own on the same tensors, so the training graph gets no new consumers */
+    op::Operation<T> *weights = op::var("__"+this->name+"_layer_weights", this->weights_tensor);
+    op::Operation<T> *bias = (use_bias) ? op::var("__"+this->name+"_layer_bias", this->bias_tensor) : (op::Operation<T> *) NULL;
+
+    return build(input, weights, bias);
+}
+
+template <typename T>
+op::Operation<T> *FullyConnectedLayer<T>::build(op::Operation<T> *input, op::Operation<T> *weights, op::Operation<T> *bias) {
+    if (fused) {
+        /* output = act( (input) * (weights) + (bias) ) in one operation */
+        internal::fc_activation_t act;
+        switch (this->activation_func) {
+            case TANH:
+                act = internal::FC_TANH; break;
+            case RELU:
+                act = internal::FC_RELU; break;
+            case SIGMOID:
+            default:
+                act = internal::FC_SIGMOID; break;
+        }
+
+        return op::fullyconnected(input, weights, (use_bias) ? bias : (op::Operation<T> *) NULL, act);
+    }
+
+    /*  output = (input) * (weights) + (bias)
+        the 1 x hidden_units bias is broadcast over the rows of the batch. */
+    op::Operation<T> *output = op::matmul(input, weights);
+    if (use_bias) output = op::add(output, bias);
+    return output;
 }
 template class FullyConnectedLayer <int>;
 template class FullyConnectedLayer <float>;
@@ -59,5 +101,13 @@ template FullyConnectedLayer<int>* fullyconnected(op::Operation<int>*, unsigned
 template FullyConnectedLayer<float>* fullyconnected(op::Operation<float>*, unsigned int, bool);
 template FullyConnectedLayer<double>* fullyconnected(op::Operation<double>*, unsigned int, bool);
 
+template <typename T>
+FullyConnectedLayer<T>* fullyconnected(op::Operation<T> *input, unsigned int hidden_units, activation_t activation_func, bool use_bias) {
+    return new FullyConnectedLayer<T> (input, hidden_units, activation_func, use_bias);
+}
+template FullyConnectedLayer<int>* fullyconnected(op::Operation<int>*, unsigned int, activation_t, bool);
+template FullyConnectedLayer<float>* fullyconnected(op::Operation<float>*, unsigned int, activation_t, bool);
+template FullyConnectedLayer<double>* fullyconnected(op::Operation<double>*, unsigned int, activation_t, bool);
+
 }   // layer
 }   // magmadnn
\ No newline at end of file
@@ -21,6 +21,11 @@ std::vector<op::Operation<T> *> InputLayer<T>::get_weights() {
     return {};
 }
 
+template <typename T>
+op::Operation<T> *InputLayer<T>::forward(op::Operation<T> *input) {
+    return input;
+}
+
 template <typename T>
 void InputLayer<T>::init() {
     this->output = this->input;
@@ -28,6 +28,11 @@ OutputLayer<T>::~OutputLayer() {
 
 }
 
+template <typename T>
+op::Operation<T> *OutputLayer<T>::forward(op::Operation<T> *input) {
+    return input;
+}
+
 template <typename T>
 void OutputLayer<T>::init() {
     this->name = "OutputLayer";
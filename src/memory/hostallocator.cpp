@@ -0,0 +1,361 @@
+/**
+ * @file hostallocator.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-13
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "memory/hostallocator.h"
+
+/* 4 classes per power of two from 64 bytes up to 2^64 */
+#define HOST_ALLOCATOR_N_CLASSES 233
+
+namespace magmadnn {
+
+/* stored in front of every block. It takes a whole alignment unit so the block stays aligned. */
+struct block_header_t {
+    size_t block_size;
+    size_t mapped_bytes;    /* length of the mapping for huge page blocks, 0 for malloc'd blocks */
+    unsigned int size_class;
+};
+
+/* maps live allocator ids to allocators. Never destroyed, so threads that exit after main can
+   still use it. */
+static std::mutex registry_lock;
+static std::map<uint64_t, HostAllocator *> *registry = new std::map<uint64_t, HostAllocator *>;
+static uint64_t next_id = 0;
+
+/* the free lists this thread uses in each allocator. When the thread exits they are handed back
+   to their allocators, with their blocks, for the next thread to use. */
+struct host_allocator_thread_state_t {
+    std::vector<std::pair<uint64_t, HostAllocator::free_lists_t *> > lists;
+
+    ~host_allocator_thread_state_t();
+};
+static thread_local host_allocator_thread_state_t thread_state;
+static thread_local bool thread_exiting = false;
+
+host_allocator_thread_state_t::~host_allocator_thread_state_t() {
+    std::lock_guard<std::mutex> guard (registry_lock);
+
+    thread_exiting = true;
+    for (unsigned int i = 0; i < lists.size(); i++) {
+        std::map<uint64_t, HostAllocator *>::iterator it = registry->find(lists[i].first);
+        if (it != registry->end()) it->second->retire_thread_lists(lists[i].second);
+    }
+}
+
+static unsigned int get_size_class(size_t bytes, size_t &block) {
+    unsigned int e;
+    size_t step, k;
+
+    if (bytes <= HOST_ALLOCATOR_ALIGNMENT) {
+        block = HOST_ALLOCATOR_ALIGNMENT;
+        return 0;
+    }
+
+    /* 2^e < bytes <= 2^(e+1). The classes between are 5/4, 6/4, 7/4 and 8/4 of 2^e. */
+    e = 63 - __builtin_clzll((unsigned long long) (bytes - 1));
+    step = ((size_t) 1) << (e - 2);
+    k = (bytes + step - 1) / step;
+
+    block = k * step;
+    return 1 + (e - 6) * 4 + (unsigned int) (k - 5);
+}
+
+size_t HostAllocator::get_block_size(size_t bytes) {
+    size_t block;
+    get_size_class(bytes, block);
+    return block;
+}
+
+
+HostAllocator::HostAllocator(size_t max_cached_bytes)
+    : max_cached_bytes(max_cached_bytes), huge_pages(HUGE_PAGES_TRANSPARENT),
+    huge_page_threshold(HOST_ALLOCATOR_DEFAULT_HUGE_PAGE_THRESHOLD), bytes_in_use(0), peak_bytes_in_use(0),
+    bytes_cached(0), n_allocations(0), n_cache_hits(0), bytes_huge_pages(0) {
+
+    shared.blocks.resize(HOST_ALLOCATOR_N_CLASSES);
+    shared.bytes = 0;
+
+    std::lock_guard<std::mutex> guard (registry_lock);
+    id = next_id++;
+    (*registry)[id] = this;
+}
+
+HostAllocator::~HostAllocator() {
+    {
+        std::lock_guard<std::mutex> guard (registry_lock);
+        registry->erase(id);
+    }
+
+    release();
+    for (unsigned int i = 0; i < thread_lists.size(); i++) delete thread_lists[i];
+    for (unsigned int i = 0; i < spare_lists.size(); i++) delete spare_lists[i];
+}
+
+void *HostAllocator::allocate(size_t bytes) {
+    size_t block;
+    unsigned int size_class = get_size_class(bytes, block);
+    void *ptr = NULL;
+    size_t in_use, peak;
+
+    n_allocations++;
+
+    if (bytes_cached.load() != 0) {
+        if (block <= HOST_ALLOCATOR_THREAD_MAX_BLOCK) {
+            free_lists_t *lists = get_thread_lists();
+            if (lists != NULL) ptr = pop(lists, size_class);
+        }
+        if (ptr == NULL) ptr = pop(&shared, size_class);
+    }
+
+    if (ptr != NULL) {
+        n_cache_hits++;
+        bytes_cached -= block;
+    } else {
+        ptr = allocate_block(block, size_class);
+        if (ptr == NULL) return NULL;
+    }
+
+    in_use = (bytes_in_use += block);
+    peak = peak_bytes_in_use.load();
+    while (in_use > peak && !peak_bytes_in_use.compare_exchange_weak(peak, in_use)) {}
+
+    return ptr;
+}
+
+void HostAllocator::deallocate(void *ptr) {
+    block_header_t *header;
+    size_t block;
+    unsigned int size_class;
+
+    if (ptr == NULL) return;
+
+    header = (block_header_t *) ((char *) ptr - HOST_ALLOCATOR_ALIGNMENT);
+    block = header->block_size;
+    size_class = header->size_class;
+
+    bytes_in_use -= block;
+
+    if (bytes_cached.load() + block <= max_cached_bytes.load()) {
+        /* small blocks go to this thread's lists while they have room */
+        if (block <= HOST_ALLOCATOR_THREAD_MAX_BLOCK) {
+            free_lists_t *lists = get_thread_lists();
+
+            if (lists != NULL) {
+                std::lock_guard<std::mutex> guard (lists->lock);
+
+                if (lists->bytes + block <= HOST_ALLOCATOR_THREAD_MAX_BYTES) {
+                    lists->blocks[size_class].push_back(ptr);
+                    lists->bytes += block;
+                    bytes_cached += block;
+                    return;
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> guard (shared.lock);
+        shared.blocks[size_class].push_back(ptr);
+        shared.bytes += block;
+        bytes_cached += block;
+        return;
+    }
+
+    free_block(ptr);
+}
+
+void HostAllocator::release() {
+    {
+        std::lock_guard<std::mutex> guard (threads_lock);
+
+        for (unsigned int i = 0; i < thread_lists.size(); i++) free_all(thread_lists[i]);
+        for (unsigned int i = 0; i < spare_lists.size(); i++) free_all(spare_lists[i]);
+    }
+    free_all(&shared);
+}
+
+host_allocator_stats_t HostAllocator::get_stats() const {
+    host_allocator_stats_t stats;
+
+    stats.bytes_in_use = bytes_in_use.load();
+    stats.peak_bytes_in_use = peak_bytes_in_use.load();
+    stats.bytes_cached = bytes_cached.load();
+    stats.n_allocations = n_allocations.load();
+    stats.n_cache_hits = n_cache_hits.load();
+    stats.hit_rate = (stats.n_allocations != 0) ? ((double) stats.n_cache_hits) / stats.n_allocations : 0.0;
+    stats.bytes_huge_pages = bytes_huge_pages.load();
+
+    return stats;
+}
+
+void HostAllocator::reset_stats() {
+    n_allocations = 0;
+    n_cache_hits = 0;
+    peak_bytes_in_use = bytes_in_use.load();
+}
+
+void *HostAllocator::pop(free_lists_t *lists, unsigned int size_class) {
+    std::lock_guard<std::mutex> guard (lists->lock);
+    std::vector<void *>& blocks = lists->blocks[size_class];
+    void *ptr;
+
+    if (blocks.empty()) return NULL;
+
+    ptr = blocks.back();
+    blocks.pop_back();
+    lists->bytes -= ((block_header_t *) ((char *) ptr - HOST_ALLOCATOR_ALIGNMENT))->block_size;
+    return ptr;
+}
+
+#if defined(__linux__)
+/* maps bytes on a huge page boundary, or returns NULL */
+static void *map_huge_pages(size_t bytes, host_huge_pages_t mode, size_t &mapped_bytes) {
+    const size_t page = HOST_ALLOCATOR_HUGE_PAGE_SIZE;
+    size_t len = (bytes + page - 1) / page * page;
+    char *raw, *aligned;
+
+    #if defined(MAP_HUGETLB)
+    if (mode == HUGE_PAGES_EXPLICIT) {
+        void *p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            mapped_bytes = len;
+            return p;
+        }
+        /* no reserved huge pages, try transparent ones */
+    }
+    #endif
+
+    /* map a page extra and trim it, so the mapping starts on a huge page */
+    raw = (char *) mmap(NULL, len + page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == (char *) MAP_FAILED) return NULL;
+
+    aligned = (char *) (((uintptr_t) raw + page - 1) / page * page);
+    if (aligned != raw) munmap(raw, aligned - raw);
+    if (aligned + len != raw + len + page) munmap(aligned + len, (raw + len + page) - (aligned + len));
+
+    #if defined(MADV_HUGEPAGE)
+    madvise(aligned, len, MADV_HUGEPAGE);
+    #endif
+
+    mapped_bytes = len;
+    return aligned;
+}
+#endif
+
+void *HostAllocator::allocate_block(size_t block, unsigned int size_class) {
+    block_header_t *header = NULL;
+    size_t mapped_bytes = 0;
+    host_huge_pages_t mode = huge_pages.load();
+    size_t threshold = huge_page_threshold.load();
+
+    #if defined(__linux__)
+    if (mode != HUGE_PAGES_NONE && threshold != 0 && block >= threshold) {
+        header = (block_header_t *) map_huge_pages(HOST_ALLOCATOR_ALIGNMENT + block, mode, mapped_bytes);
+        if (header != NULL) bytes_huge_pages += block;
+    }
+    #endif
+
+    if (header == NULL) {
+        void *raw;
+
+        if (posix_memalign(&raw, HOST_ALLOCATOR_ALIGNMENT, HOST_ALLOCATOR_ALIGNMENT + block) != 0) return NULL;
+        header = (block_header_t *) raw;
+        mapped_bytes = 0;
+    }
+
+    header->block_size = block;
+    header->mapped_bytes = mapped_bytes;
+    header->size_class = size_class;
+    return (char *) header + HOST_ALLOCATOR_ALIGNMENT;
+}
+
+void HostAllocator::free_block(void *ptr) {
+    block_header_t *header = (block_header_t *) ((char *) ptr - HOST_ALLOCATOR_ALIGNMENT);
+
+    #if defined(__linux__)
+    if (header->mapped_bytes != 0) {
+        bytes_huge_pages -= header->block_size;
+        munmap(header, header->mapped_bytes);
+        return;
+    }
+    #endif
+
+    std::free(header);
+}
+
+HostAllocator::free_lists_t *HostAllocator::get_thread_lists() {
+    free_lists_t *lists;
+
+    if (thread_exiting) return NULL;
+
+    for (unsigned int i = 0; i < thread_state.lists.size(); i++) {
+        if (thread_state.lists[i].first == id) return thread_state.lists[i].second;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard (threads_lock);
+
+        if (!spare_lists.empty()) {
+            lists = spare_lists.back();
+            spare_lists.pop_back();
+        } else {
+            lists = new free_lists_t;
+            lists->blocks.resize(HOST_ALLOCATOR_N_CLASSES);
+            lists->bytes = 0;
+        }
+        thread_lists.push_back(lists);
+    }
+
+    thread_state.lists.push_back(std::make_pair(id, lists));
+    return lists;
+}
+
+void HostAllocator::retire_thread_lists(free_lists_t *lists) {
+    std::lock_guard<std::mutex> guard (threads_lock);
+
+    for (unsigned int i = 0; i < thread_lists.size(); i++) {
+        if (thread_lists[i] == lists) {
+            thread_lists.erase(thread_lists.begin() + i);
+            spare_lists.push_back(lists);
+            return;
+        }
+    }
+}
+
+void HostAllocator::free_all(free_lists_t *lists) {
+    std::lock_guard<std::mutex> guard (lists->lock);
+
+    for (unsigned int c = 0; c < lists->blocks.size(); c++) {
+        for (unsigned int i = 0; i < lists->blocks[c].size(); i++) {
+            free_block(lists->blocks[c][i]);
+        }
+        lists->blocks[c].clear();
+    }
+    bytes_cached -= lists->bytes;
+    lists->bytes = 0;
+}
+
+
+HostAllocator *get_default_host_allocator() {
+    /* never deleted, so tensors that outlive main can still free their memory */
+    static HostAllocator *allocator = NULL;
+    static std::once_flag created;
+
+    std::call_once(created, []() {
+        const char *env = std::getenv("MAGMADNN_HOST_CACHE");
+        bool caching = (env == NULL || std::atoi(env) != 0);
+
+        allocator = new HostAllocator((caching) ? HOST_ALLOCATOR_DEFAULT_MAX_CACHED : 0);
+
+        env = std::getenv("MAGMADNN_HUGE_PAGE_THRESHOLD");
+        if (env != NULL) {
+            size_t threshold = (size_t) std::strtoull(env, NULL, 10);
+            allocator->set_huge_pages((threshold != 0) ? HUGE_PAGES_TRANSPARENT : HUGE_PAGES_NONE, threshold);
+        }
+    });
+    return allocator;
+}
+
+}   // namespace magmadnn
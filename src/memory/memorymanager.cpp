@@ -11,7 +11,7 @@
 namespace magmadnn {
 
 template <typename T>
-MemoryManager<T>::MemoryManager(unsigned int size, memory_t mem_type, device_t device_id) : 
+MemoryManager<T>::MemoryManager(size_t size, memory_t mem_type, device_t device_id) : 
     mem_type(mem_type), size(size) {
 
 		set_device(device_id);
@@ -35,7 +35,8 @@ MemoryManager<T>::MemoryManager(unsigned int size, memory_t mem_type, device_t d
 
 template <typename T>
 void MemoryManager<T>::init_host() {
-    host_ptr = (T *) std::malloc(size * sizeof(T));
+    host_ptr = (T *) get_default_host_allocator()->allocate(size * sizeof(T));
+    owns_host_ptr = true;
 }
 
 #if defined(_HAS_CUDA_)
@@ -46,7 +47,8 @@ void MemoryManager<T>::init_device() {
 
 template <typename T>
 void MemoryManager<T>::init_managed() {
-    host_ptr = (T *) std::malloc(size * sizeof(T));
+    host_ptr = (T *) get_default_host_allocator()->allocate(size * sizeof(T));
+    owns_host_ptr = true;
     cudaMalloc((void**) &device_ptr, size * sizeof(T));
 }
 
@@ -56,25 +58,74 @@ void MemoryManager<T>::init_cuda_managed() {
 }
 #endif
 
+template <typename T>
+MemoryManager<T>::MemoryManager(MemoryManager<T>&& other) noexcept {
+    take(other);
+}
+
+template <typename T>
+MemoryManager<T>& MemoryManager<T>::operator=(MemoryManager<T>&& other) noexcept {
+    if (this != &other) {
+        free_memory();
+        take(other);
+    }
+    return *this;
+}
+
 template <typename T>
 MemoryManager<T>::~MemoryManager<T>() {
+    free_memory();
+}
+
+template <typename T>
+void MemoryManager<T>::free_memory() {
     switch (mem_type) {
         case HOST:
-            std::free(host_ptr); break;
+            if (owns_host_ptr) get_default_host_allocator()->deallocate(host_ptr);
+            break;
         #if defined(_HAS_CUDA_)
         case DEVICE:
             cudaFree(device_ptr); break;
         case MANAGED:
-            std::free(host_ptr); break;
+            get_default_host_allocator()->deallocate(host_ptr);
             cudaFree(device_ptr); break;
         case CUDA_MANAGED:
-            cudaFree(device_ptr); break;
+            cudaFree(cuda_managed_ptr); break;
         #endif
     }
+
+    this->host_ptr = NULL;
+    #if defined(_HAS_CUDA_)
+    this->device_ptr = NULL;
+    this->cuda_managed_ptr = NULL;
+    #endif
+    this->size = 0;
 }
 
 template <typename T>
-magmadnn_error_t MemoryManager<T>::copy_from(const MemoryManager<T>& src, unsigned int begin_idx, unsigned int copy_size) {
+void MemoryManager<T>::take(MemoryManager<T>& other) {
+    this->mem_type = other.mem_type;
+    this->device_id = other.device_id;
+    this->size = other.size;
+    this->host_ptr = other.host_ptr;
+    this->owns_host_ptr = other.owns_host_ptr;
+    #if defined(_HAS_CUDA_)
+    this->device_ptr = other.device_ptr;
+    this->cuda_managed_ptr = other.cuda_managed_ptr;
+    #endif
+
+    /* other keeps its memory type, but has nothing to free */
+    other.size = 0;
+    other.host_ptr = NULL;
+    other.owns_host_ptr = false;
+    #if defined(_HAS_CUDA_)
+    other.device_ptr = NULL;
+    other.cuda_managed_ptr = NULL;
+    #endif
+}
+
+template <typename T>
+magmadnn_error_t MemoryManager<T>::copy_from(const MemoryManager<T>& src, size_t begin_idx, size_t copy_size) {
     assert( this->size == src.size );
     
     if (copy_size == 0) return (magmadnn_error_t) 0;
@@ -101,12 +152,12 @@ magmadnn_error_t MemoryManager<T>::copy_from(const MemoryManager<T>& src) {
 }
 
 template <typename T>
-magmadnn_error_t MemoryManager<T>::copy_from(const MemoryManager<T>& src, unsigned int copy_size) {
+magmadnn_error_t MemoryManager<T>::copy_from(const MemoryManager<T>& src, size_t copy_size) {
     return copy_from(src, 0, copy_size);
 }
 
 template <typename T>
-magmadnn_error_t MemoryManager<T>::copy_from_host(T *src, unsigned int begin_idx, unsigned int copy_size) {
+magmadnn_error_t MemoryManager<T>::copy_from_host(T *src, size_t begin_idx, size_t copy_size) {
 
     switch (mem_type) {
         case HOST:
@@ -135,7 +186,7 @@ magmadnn_error_t MemoryManager<T>::copy_from_host(T *src, unsigned int begin_idx
 
 #if defined(_HAS_CUDA_)
 template <typename T>
-magmadnn_error_t MemoryManager<T>::copy_from_device(T *src, unsigned int begin_idx, unsigned int copy_size) {
+magmadnn_error_t MemoryManager<T>::copy_from_device(T *src, size_t begin_idx, size_t copy_size) {
 
 	magmadnn_error_t err = (magmadnn_error_t) 0;
 
@@ -162,7 +213,7 @@ magmadnn_error_t MemoryManager<T>::copy_from_device(T *src, unsigned int begin_i
 }
 
 template <typename T>
-magmadnn_error_t MemoryManager<T>::copy_from_managed(T *host_src, T *device_src, unsigned int begin_idx, unsigned int copy_size) {
+magmadnn_error_t MemoryManager<T>::copy_from_managed(T *host_src, T *device_src, size_t begin_idx, size_t copy_size) {
 
     switch (mem_type) {
         case HOST:
@@ -187,7 +238,7 @@ magmadnn_error_t MemoryManager<T>::copy_from_managed(T *host_src, T *device_src,
 }
 
 template <typename T>
-magmadnn_error_t MemoryManager<T>::copy_from_cudamanaged(T *src, unsigned int begin_idx, unsigned int copy_size) {
+magmadnn_error_t MemoryManager<T>::copy_from_cudamanaged(T *src, size_t begin_idx, size_t copy_size) {
 
     switch (mem_type) {
         case HOST:
@@ -236,7 +287,7 @@ magmadnn_error_t MemoryManager<T>::sync(bool gpu_was_modified) {
 }
 
 template <typename T>
-T MemoryManager<T>::get(unsigned int idx) const {
+T MemoryManager<T>::get(size_t idx) const {
     assert( idx < size );
 
     switch (mem_type) {
@@ -256,7 +307,7 @@ T MemoryManager<T>::get(unsigned int idx) const {
 }
 
 template <typename T>
-void MemoryManager<T>::set(unsigned int idx, T val) {
+void MemoryManager<T>::set(size_t idx, T val) {
     assert( idx < size );
 
     // note: don't sync on managed type memories
@@ -294,6 +345,21 @@ magmadnn_error_t MemoryManager<T>::set_device(device_t device_id) {
 	return (magmadnn_error_t) 0;
 }
 
+template <typename T>
+magmadnn_error_t MemoryManager<T>::bind_host_ptr(T *ptr) {
+    if (mem_type != HOST) return (magmadnn_error_t) 1;
+
+    if (owns_host_ptr) get_default_host_allocator()->deallocate(host_ptr);
+
+    if (ptr == NULL) {
+        init_host();
+    } else {
+        host_ptr = ptr;
+        owns_host_ptr = false;
+    }
+    return (magmadnn_error_t) 0;
+}
+
 template <typename T>
 T* MemoryManager<T>::get_host_ptr() {
     return host_ptr;
@@ -0,0 +1,178 @@
+/**
+ * @file frozennetwork.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-20
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "model/frozennetwork/frozennetwork.h"
+
+namespace magmadnn {
+namespace model {
+
+/* a copy of t in the same memory, or NULL if t is NULL */
+template <typename T>
+static Tensor<T> *copy_tensor(Tensor<T> *t) {
+    if (t == NULL) return NULL;
+
+    Tensor<T> *copy = new Tensor<T> (t->get_shape(), {NONE, {}}, t->get_memory_type());
+    copy->copy_from(*t);
+    return copy;
+}
+
+/* the activation a fused FullyConnectedLayer applies */
+static internal::fc_activation_t fc_layer_activation(layer::activation_t act) {
+    switch (act) {
+        case layer::TANH: return internal::FC_TANH;
+        case layer::RELU: return internal::FC_RELU;
+        case layer::SIGMOID:
+        default: return internal::FC_SIGMOID;
+    }
+}
+
+/* the activation an ActivationLayer applies. it computes a sigmoid for RELU (see ActivationLayer::forward). */
+static internal::fc_activation_t activation_layer_activation(layer::activation_t act) {
+    switch (act) {
+        case layer::TANH: return internal::FC_TANH;
+        case layer::SIGMOID:
+        case layer::RELU:
+        default: return internal::FC_SIGMOID;
+    }
+}
+
+template <typename T>
+FrozenNetwork<T>::FrozenNetwork(const std::vector<layer::Layer<T> *>& layers) {
+    op::Operation<T> *network_input = layers.front()->out();
+
+    for (unsigned int i = 0; i < layers.size(); i++) {
+        layer::Layer<T> *cur = layers[i];
+        layer::FullyConnectedLayer<T> *fc;
+        layer::ActivationLayer<T> *activation;
+
+        if (dynamic_cast<layer::InputLayer<T> *>(cur) != NULL || dynamic_cast<layer::OutputLayer<T> *>(cur) != NULL) {
+            continue;
+        } else if ((fc = dynamic_cast<layer::FullyConnectedLayer<T> *>(cur)) != NULL) {
+            internal::fc_activation_t act = (fc->is_fused()) ? fc_layer_activation(fc->get_activation()) : internal::FC_NONE;
+            add_fullyconnected(copy_tensor(fc->get_weights_tensor()), copy_tensor(fc->get_bias_tensor()), act);
+        } else if ((activation = dynamic_cast<layer::ActivationLayer<T> *>(cur)) != NULL) {
+            add_activation(activation_layer_activation(activation->get_activation()));
+        } else {
+            std::fprintf(stderr, "Error: FrozenNetwork does not support layer %u.\n", i);
+            assert( false );
+        }
+    }
+
+    this->inference = new InferenceGraphs<T> (network_input->get_output_shape(), network_input->get_memory_type(),
+        [this](op::Operation<T> *input) { return this->build(input); });
+}
+
+template <typename T>
+FrozenNetwork<T>::~FrozenNetwork() {
+    /* the graphs read the weights, so they go first */
+    delete this->inference;
+
+    for (unsigned int i = 0; i < this->stages.size(); i++) {
+        if (this->stages[i].weights != NULL) delete this->stages[i].weights;
+        if (this->stages[i].bias != NULL) delete this->stages[i].bias;
+    }
+}
+
+template <typename T>
+Tensor<T> *FrozenNetwork<T>::predict(Tensor<T> *samples) {
+    return this->inference->run(samples);
+}
+
+template <typename T>
+unsigned int FrozenNetwork<T>::predict_class(Tensor<T> *sample) {
+    std::vector<unsigned int> classes;
+
+    if (this->predict_classes(sample, classes) != 0) return 0;
+    return classes[0];
+}
+
+template <typename T>
+magmadnn_error_t FrozenNetwork<T>::predict_classes(Tensor<T> *samples, std::vector<unsigned int>& classes_out) {
+    return this->inference->run_classes(samples, classes_out);
+}
+
+template <typename T>
+void FrozenNetwork<T>::add_fullyconnected(Tensor<T> *weights, Tensor<T> *bias, internal::fc_activation_t act) {
+    if (this->stages.empty() || this->stages.back().weights == NULL || this->stages.back().act != internal::FC_NONE) {
+        this->stages.push_back({weights, bias, act});
+        return;
+    }
+
+    /* nothing between the last stage and this one, so fold them:
+        (x W1 + b1) W2 + b2 = x (W1 W2) + (b1 W2 + b2) */
+    stage_t& prev = this->stages.back();
+    Tensor<T> *folded_weights, *folded_bias;
+    op::GraphArena arena;
+    {
+        op::GraphArenaScope scope (arena);
+        op::Operation<T> *w = op::var("w", weights);
+
+        folded_weights = copy_tensor(op::matmul(op::var("w_prev", prev.weights), w, false)->eval());
+
+        if (prev.bias != NULL) {
+            op::Operation<T> *b = (bias != NULL) ? op::var("b", bias) : NULL;
+            folded_bias = copy_tensor(op::fullyconnected(op::var("b_prev", prev.bias), w, b, internal::FC_NONE, false)->eval());
+            if (bias != NULL) delete bias;
+        } else {
+            folded_bias = bias;
+        }
+    }
+
+    delete prev.weights;
+    if (prev.bias != NULL) delete prev.bias;
+    delete weights;
+
+    prev.weights = folded_weights;
+    prev.bias = folded_bias;
+    prev.act = act;
+}
+
+template <typename T>
+void FrozenNetwork<T>::add_activation(internal::fc_activation_t act) {
+    if (!this->stages.empty() && this->stages.back().weights != NULL && this->stages.back().act == internal::FC_NONE) {
+        this->stages.back().act = act;
+        return;
+    }
+    this->stages.push_back({NULL, NULL, act});
+}
+
+template <typename T>
+op::Operation<T> *FrozenNetwork<T>::build(op::Operation<T> *input) {
+    op::Operation<T> *output = input;
+
+    for (unsigned int i = 0; i < this->stages.size(); i++) {
+        const stage_t& stage = this->stages[i];
+
+        if (stage.weights != NULL) {
+            op::Operation<T> *b = (stage.bias != NULL) ? op::var("b", stage.bias) : NULL;
+            output = op::fullyconnected(output, op::var("w", stage.weights), b, stage.act, false);
+            continue;
+        }
+
+        /* the input may be the caller's samples, so the activation writes to a tensor of its own */
+        switch (stage.act) {
+            case internal::FC_SIGMOID:
+                output = new op::SigmoidOp<T> (output, true, false); break;
+            case internal::FC_TANH:
+                output = op::tanh(output, true); break;
+            case internal::FC_RELU:
+                output = op::relu(output, true, false); break;
+            case internal::FC_NONE:
+            default:
+                break;
+        }
+    }
+    return output;
+}
+
+template class FrozenNetwork<int>;
+template class FrozenNetwork<float>;
+template class FrozenNetwork<double>;
+
+}   // namespace model
+}   // namespace magmadnn
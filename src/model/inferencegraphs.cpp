@@ -0,0 +1,113 @@
+/**
+ * @file inferencegraphs.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-20
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "model/inferencegraphs.h"
+
+namespace magmadnn {
+namespace model {
+
+template <typename T>
+InferenceGraphs<T>::InferenceGraphs(const std::vector<unsigned int>& input_shape, memory_t mem_type, build_func_t build)
+    : input_shape(input_shape), mem_type(mem_type), build(build) {}
+
+template <typename T>
+InferenceGraphs<T>::~InferenceGraphs() {
+    typename std::map<unsigned int, graph_t>::iterator it;
+
+    for (it = this->graphs.begin(); it != this->graphs.end(); it++) {
+        delete it->second.executor;
+        delete it->second.arena;
+    }
+}
+
+template <typename T>
+Tensor<T> *InferenceGraphs<T>::run(Tensor<T> *samples) {
+    std::vector<unsigned int> shape = samples->get_shape();
+
+    /* a single sample gets a batch axis */
+    bool single = (shape.size() + 1 == this->input_shape.size());
+    if (single) shape.insert(shape.begin(), 1);
+
+    if (shape.size() != this->input_shape.size() || !std::equal(shape.begin()+1, shape.end(), this->input_shape.begin()+1)) {
+        std::fprintf(stderr, "Error: the samples do not have the shape of the network input.\n");
+        return NULL;
+    }
+
+    graph_t *graph = this->get_graph(shape[0]);
+    Tensor<T> *input_tensor = graph->input->get_return_ptr();
+
+    if (samples->get_memory_type() == this->mem_type && samples->is_contiguous()) {
+        /* read the samples in place */
+        Tensor<T> *rows = (single) ? samples->reshape(shape) : samples->slice(0, shape[0]);
+        *input_tensor = std::move(*rows);
+        delete rows;
+    } else {
+        /* the input may still be a view of an earlier run's samples, which must not be written to */
+        if (input_tensor->is_view()) *input_tensor = Tensor<T> (shape, {NONE, {}}, this->mem_type);
+        input_tensor->copy_from(*samples);
+    }
+
+    graph->executor->invalidate(graph->input);
+    if (graph->executor->run() != 0) return NULL;
+
+    return graph->output->get_return_ptr();
+}
+
+template <typename T>
+magmadnn_error_t InferenceGraphs<T>::run_classes(Tensor<T> *samples, std::vector<unsigned int>& classes_out) {
+    Tensor<T> *output = this->run(samples);
+
+    if (output == NULL) return (magmadnn_error_t) 1;
+
+    output->get_memory_manager()->sync();
+
+    unsigned int n_rows = output->get_shape(0);
+    size_t n_cols = output->get_size() / n_rows;
+
+    classes_out.resize(n_rows);
+    for (unsigned int i = 0; i < n_rows; i++) {
+        size_t best = 0;
+        T best_val = output->get(i * n_cols);
+        for (size_t j = 1; j < n_cols; j++) {
+            T val = output->get(i * n_cols + j);
+            if (val > best_val) { best = j; best_val = val; }
+        }
+        classes_out[i] = best;
+    }
+    return (magmadnn_error_t) 0;
+}
+
+template <typename T>
+typename InferenceGraphs<T>::graph_t *InferenceGraphs<T>::get_graph(unsigned int batch_size) {
+    typename std::map<unsigned int, graph_t>::iterator it = this->graphs.find(batch_size);
+    if (it != this->graphs.end()) return &it->second;
+
+    graph_t graph;
+    std::vector<unsigned int> shape = this->input_shape;
+    shape[0] = batch_size;
+
+    graph.arena = new op::GraphArena;
+    {
+        op::GraphArenaScope scope (*graph.arena);
+
+        graph.input = op::var<T>("x", shape, {NONE, {}}, this->mem_type);
+        graph.output = this->build(graph.input);
+    }
+
+    /* the intermediate activations share one planned slab, allocated once for this batch size */
+    graph.executor = new op::GraphExecutor<T> ({graph.output}, true);
+
+    return &(this->graphs[batch_size] = graph);
+}
+
+template class InferenceGraphs<int>;
+template class InferenceGraphs<float>;
+template class InferenceGraphs<double>;
+
+}   // namespace model
+}   // namespace magmadnn
@@ -27,23 +27,127 @@ NeuralNetwork<T>::NeuralNetwork(std::vector<layer::Layer<T> *> layers, optimizer
 
 }
 
+template <typename T>
+NeuralNetwork<T>::~NeuralNetwork() {
+    if (this->_inference != NULL) delete this->_inference;
+}
+
+/* points dst at the rows [begin, end) of src. when they are in the same memory dst becomes a view of
+   src, otherwise the rows are copied into dst. */
+template <typename T>
+static magmadnn_error_t set_batch(Tensor<T> *dst, Tensor<T>& src, unsigned int begin, unsigned int end) {
+    if (dst->get_memory_type() == src.get_memory_type()) {
+        Tensor<T> *rows = src.slice(begin, end);
+        *dst = std::move(*rows);
+        delete rows;
+        return (magmadnn_error_t) 0;
+    }
+
+    size_t row_size = src.get_size() / src.get_shape(0);
+    return dst->copy_from(src, begin * row_size, (end - begin) * row_size);
+}
+
+/* the number of rows of output whose largest entry is where truth's is */
+template <typename T>
+static unsigned int count_correct(Tensor<T> *output, Tensor<T> *truth) {
+    unsigned int n_rows = output->get_shape(0);
+    unsigned int n_cols = (output->get_shape().size() > 1) ? output->get_shape(1) : 1;
+    unsigned int n_correct = 0;
+
+    for (int i = 0; i < (int) n_rows; i++) {
+        int out_max = 0, truth_max = 0;
+        for (int j = 1; j < (int) n_cols; j++) {
+            if (output->get({i,j}) > output->get({i,out_max})) out_max = j;
+            if (truth->get({i,j}) > truth->get({i,truth_max})) truth_max = j;
+        }
+        if (out_max == truth_max) n_correct++;
+    }
+    return n_correct;
+}
+
 template <typename T>
 magmadnn_error_t NeuralNetwork<T>::fit(Tensor<T> *x, Tensor<T> *y, metric_t& metric_out, bool verbose) {
+    /* the graph was built for a fixed number of rows, which is the size of every mini-batch */
+    unsigned int batch_size = this->layers.front()->out()->get_output_shape()[0];
+    unsigned int n_samples = x->get_shape(0);
+
+    if (this->model_params.batch_size != batch_size) {
+        std::fprintf(stderr, "Error: batch_size (%u) does not match the input layer (%u rows).\n", this->model_params.batch_size, batch_size);
+        return (magmadnn_error_t) 1;
+    }
+    if (y->get_shape(0) != n_samples || n_samples < batch_size) {
+        std::fprintf(stderr, "Error: x and y must have the same number of rows, and at least batch_size.\n");
+        return (magmadnn_error_t) 1;
+    }
+
+    /* the input layer's tensor may be x itself, so x and y are read through shares that keep all of
+       their rows */
+    Tensor<T> x_all = x->share();
+    Tensor<T> y_all = y->share();
+    bool shuffle = this->model_params.shuffle;
+    std::default_random_engine& engine = this->shuffle_engine;
+
+    /* the order mini-batches are visited in */
+    std::vector<unsigned int> batch_order (n_samples / batch_size);
+    std::iota(batch_order.begin(), batch_order.end(), 0);
+
+    std::vector<unsigned int> truth_shape = y->get_shape();
+    truth_shape[0] = batch_size;
+
+    return this->train(batch_order.size(), truth_shape,
+        [&](unsigned int batch, Tensor<T> *input_tensor, Tensor<T> *ground_truth_tensor) {
+            if (batch == 0 && shuffle) std::shuffle(batch_order.begin(), batch_order.end(), engine);
+
+            unsigned int begin = batch_order[batch] * batch_size;
+            magmadnn_error_t err = set_batch(input_tensor, x_all, begin, begin + batch_size);
+            if (err != 0) return err;
+            return set_batch(ground_truth_tensor, y_all, begin, begin + batch_size);
+        }, metric_out, verbose);
+}
+
+template <typename T>
+magmadnn_error_t NeuralNetwork<T>::fit(data::DataLoader<T> *loader, metric_t& metric_out, bool verbose) {
+    unsigned int batch_size = this->layers.front()->out()->get_output_shape()[0];
+
+    if (loader->get_batch_size() != batch_size) {
+        std::fprintf(stderr, "Error: the loader's batch size (%u) does not match the input layer (%u rows).\n", loader->get_batch_size(), batch_size);
+        return (magmadnn_error_t) 1;
+    }
+
+    /* the loader fills one pair of buffers while the network trains on the other. the input layer
+       and ground truth are pointed at the buffers it hands out. */
+    return this->train(loader->get_n_batches(), loader->get_y_shape(),
+        [loader, batch_size](unsigned int batch, Tensor<T> *input_tensor, Tensor<T> *ground_truth_tensor) {
+            Tensor<T> *x_batch, *y_batch;
+            loader->next(x_batch, y_batch);
+
+            magmadnn_error_t err = set_batch(input_tensor, *x_batch, 0, batch_size);
+            if (err != 0) return err;
+            return set_batch(ground_truth_tensor, *y_batch, 0, batch_size);
+        }, metric_out, verbose);
+}
+
+template <typename T>
+magmadnn_error_t NeuralNetwork<T>::train(unsigned int n_batches, const std::vector<unsigned int>& truth_shape, const batch_func_t& next_batch,
+    metric_t& metric_out, bool verbose) {
     /* init */
     optimizer::Optimizer<T> *optim;
+    op::Operation<T> *network_input;
     op::Operation<T> *network_output;
     op::Operation<T> *ground_truth;
-    Tensor<T> *input_tensor;
+    Tensor<T> *input_tensor, *ground_truth_tensor;
 
-    /* get the network output from the last layer */
+    /* get the network input and output from the first and last layers */
+    network_input = this->layers.front()->out();
     network_output = this->layers.back()->out();
 
-    /* ground truth is given to use by y */
-    ground_truth = op::var("y", y);
+    /* the input layer's tensor is pointed at each mini-batch in turn and put back afterwards */
+    input_tensor = network_input->eval();
+    Tensor<T> input_saved = input_tensor->share();
 
-    /* input tensor is input layer eval */
-    /* TODO : this is rather bootleg~ish. there should be an easier way to do this. */
-    input_tensor = this->layers.front()->out()->eval();
+    /* ground truth is the current mini-batch of labels */
+    ground_truth = op::var<T>("y", truth_shape, {NONE, {}}, network_output->get_memory_type());
+    ground_truth_tensor = ground_truth->get_return_ptr();
 
     switch (this->loss_func) {
         case optimizer::CROSS_ENTROPY:
@@ -58,58 +162,121 @@ magmadnn_error_t NeuralNetwork<T>::fit(Tensor<T> *x, Tensor<T> *y, metric_t& met
         case optimizer::SGD:
             optim = new optimizer::GradientDescent<T> (this->_obj, this->default_learning_rate); break;
         case optimizer::ADAM:
-            std::fprintf(stderr, "Adam not yet implemented.\n");
-            return (magmadnn_error_t) 2;
+            optim = new optimizer::Adam<T> (this->_obj, this->default_adam_learning_rate); break;
         default:
             std::fprintf(stderr, "Unknown optimizer!\n");
             return (magmadnn_error_t) 2;
     }
 
     /* Neural Network training Routine.
-        1. Copy x tensor into input layer
+        1. Point the input layer and ground truth at the next mini-batch
         2. Forward propagate layer
         3. Call minimize on the optimizer
-        4. Go back to 1
+        4. Go back to 1 until every mini-batch was seen, then start the next epoch
     */
 
     magmadnn_error_t err = (magmadnn_error_t) 0;
-    double accuracy = 1.0;
+    double accuracy = 0.0;
     double loss = 0.0;
     double training_time = 0.0;
-    unsigned int n_iter = this->model_params.n_epochs;
-    Tensor<T> *loss_tensor;
+    unsigned int n_epochs = this->model_params.n_epochs;
+    unsigned int batch_size = input_tensor->get_shape(0);
+    unsigned int n_correct;
+    Tensor<T> *loss_tensor, *output_tensor;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
     /* main training routine */
-    for (unsigned int i = 0; i < n_iter; i++) {
-        /* copy x into input layer */
-        err = input_tensor->copy_from(*x);
+    for (unsigned int epoch = 0; epoch < n_epochs; epoch++) {
+        loss = 0.0;
+        n_correct = 0;
 
-        /* minimize using gradients */
-        optim->minimize(this->_vars);
+        for (unsigned int i = 0; i < n_batches; i++) {
+            err = next_batch(i, input_tensor, ground_truth_tensor);
+            if (err != 0) break;
 
-        /* get the loss from the loss func (_obj) */
-        loss_tensor = this->_obj->eval(false);
-        loss_tensor->get_memory_manager()->sync();
-        loss = loss_tensor->get(0);
+            optim->invalidate(network_input);
+            optim->invalidate(ground_truth);
+
+            /* minimize using gradients */
+            optim->minimize(this->_vars);
+
+            /* get the loss from the loss func (_obj) and the network's predictions. minimize evaluated
+               both before updating the weights. */
+            loss_tensor = this->_obj->get_return_ptr();
+            loss_tensor->get_memory_manager()->sync();
+            loss += loss_tensor->get(0);
+
+            output_tensor = network_output->get_return_ptr();
+            output_tensor->get_memory_manager()->sync();
+            n_correct += count_correct(output_tensor, ground_truth_tensor);
+        }
+        if (err != 0) break;
+
+        loss /= n_batches;
+        accuracy = ((double) n_correct) / (n_batches * batch_size);
+
+        if (verbose) {
+            std::printf("Epoch %u/%u: loss = %.5g, accuracy = %.5g\n", epoch+1, n_epochs, loss, accuracy);
+        }
     }
 
+    training_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    /* give the input layer back its own tensor */
+    *input_tensor = std::move(input_saved);
+    delete optim;
+
     /* update metrics */
     metric_out.accuracy = accuracy;
     metric_out.loss = loss;
     metric_out.training_time = training_time;
+    metric_out.steps_per_epoch = n_batches;
+    metric_out.samples_per_second = (training_time > 0.0) ? ((double) n_epochs * n_batches * batch_size) / training_time : 0.0;
+    this->_last_training_metric = metric_out;
 
     return err;
 }
 
 template <typename T>
-Tensor<T> *NeuralNetwork<T>::predict(Tensor<T> *sample) {
-    return NULL;
+Tensor<T> *NeuralNetwork<T>::predict(Tensor<T> *samples) {
+    return this->get_inference()->run(samples);
 }
 
 template <typename T>
 unsigned int NeuralNetwork<T>::predict_class(Tensor<T> *sample) {
+    std::vector<unsigned int> classes;
+
+    if (this->predict_classes(sample, classes) != 0) return 0;
+    return classes[0];
+}
+
+template <typename T>
+magmadnn_error_t NeuralNetwork<T>::predict_classes(Tensor<T> *samples, std::vector<unsigned int>& classes_out) {
+    return this->get_inference()->run_classes(samples, classes_out);
+}
+
+template <typename T>
+FrozenNetwork<T> *NeuralNetwork<T>::freeze() {
+    return new FrozenNetwork<T> (this->layers);
+}
+
+template <typename T>
+InferenceGraphs<T> *NeuralNetwork<T>::get_inference() {
+    if (this->_inference != NULL) return this->_inference;
+
+    op::Operation<T> *network_input = this->layers.front()->out();
+    std::vector<layer::Layer<T> *> layers = this->layers;
+
+    /* each layer applied to the previous one's output, reading the weights the training graph updates */
+    this->_inference = new InferenceGraphs<T> (network_input->get_output_shape(), network_input->get_memory_type(),
+        [layers](op::Operation<T> *input) {
+            op::Operation<T> *output = input;
+            for (unsigned int i = 0; i < layers.size(); i++) output = layers[i]->forward(output);
+            return output;
+        });
 
-    return 0;
+    return this->_inference;
 }
 
 template class NeuralNetwork<int>;
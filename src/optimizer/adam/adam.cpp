@@ -0,0 +1,93 @@
+/**
+ * @file adam.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-21
+ * 
+ * @copyright Copyright (c) 2019
+ */
+#include "optimizer/adam/adam.h"
+
+namespace magmadnn {
+namespace optimizer {
+
+template <typename T>
+Adam<T>::Adam(op::Operation<T> *_obj_func, T learning_rate, T beta1, T beta2, T epsilon, bool parallel)
+    : GradientDescent<T>::GradientDescent(_obj_func, learning_rate, parallel), beta1(beta1), beta2(beta2), epsilon(epsilon),
+      n_steps(0), moments(NULL) {
+    /* set the name of this Optimizer */
+    this->_name = "AdamOptimizer";
+}
+
+template <typename T>
+Adam<T>::~Adam() {
+    this->reset_moments();
+}
+
+template <typename T>
+void Adam<T>::reset_moments() {
+    if (this->moments != NULL) delete this->moments;
+    this->moments = NULL;
+
+    for (unsigned int i = 0; i < this->_broadcast_grads.size(); i++) {
+        if (this->_broadcast_grads[i] != NULL) delete this->_broadcast_grads[i];
+    }
+    this->_broadcast_grads.clear();
+    this->_moments_wrt.clear();
+
+    this->n_steps = 0;
+}
+
+template <typename T>
+void Adam<T>::apply_gradients(const std::vector<op::Operation<T> *>& wrt) {
+    std::vector<Tensor<T> *> vars (wrt.size()), grads (wrt.size());
+
+    if (wrt != this->_moments_wrt) {
+        size_t total = 0;
+
+        this->reset_moments();
+        for (unsigned int i = 0; i < wrt.size(); i++) total += wrt[i]->get_output_size();
+
+        /* each half of the moments is rows x cols, so every axis fits in an unsigned int however many
+           parameters there are. the end of a half past total is not used. */
+        size_t cols = std::max((size_t) 1, std::min(total, (size_t) UINT_MAX));
+        size_t rows = (total + cols - 1) / cols;
+
+        this->moments = new Tensor<T> ({2, (unsigned int) rows, (unsigned int) cols}, {ZERO, {}}, wrt.front()->get_memory_type());
+        this->_broadcast_grads.assign(wrt.size(), NULL);
+        this->_moments_wrt = wrt;
+    }
+
+    for (unsigned int i = 0; i < wrt.size(); i++) {
+        vars[i] = wrt[i]->eval(false);
+        grads[i] = this->table.get(wrt[i])->eval(false);
+
+        if (grads[i]->get_size() != vars[i]->get_size()) {
+            /* the grad is repeated along the axes var was broadcast on */
+            if (this->_broadcast_grads[i] == NULL) {
+                this->_broadcast_grads[i] = new Tensor<T> (vars[i]->get_shape(), {ZERO, {}}, vars[i]->get_memory_type());
+            }
+            internal::broadcast_full(internal::BROADCAST_ADD, (T) 0, this->_broadcast_grads[i], (T) 1, grads[i], this->_broadcast_grads[i]);
+            grads[i] = this->_broadcast_grads[i];
+        }
+    }
+
+    this->n_steps++;
+
+    /* the bias correction of both moments is folded into the step size */
+    double correction = std::sqrt(1.0 - std::pow((double) this->beta2, (double) this->n_steps)) / (1.0 - std::pow((double) this->beta1, (double) this->n_steps));
+    T step = (T) (this->learning_rate * correction);
+
+    magmadnn_error_t err = internal::adam_update_internal(vars, grads, this->moments, step, this->beta1, this->beta2, this->epsilon);
+    if (err != 0) {
+        std::fprintf(stderr, "Error: the Adam update failed (%d). The variables were not changed.\n", (int) err);
+        this->n_steps--;
+    }
+}
+
+template class Adam<int>;
+template class Adam<float>;
+template class Adam<double>;
+
+}   // namespace optimizer
+}   // namespace magmadnn
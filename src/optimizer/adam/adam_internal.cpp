@@ -0,0 +1,73 @@
+/**
+ * @file adam_internal.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-21
+ * 
+ * @copyright Copyright (c) 2019
+ */
+#include "optimizer/adam/adam_internal.h"
+
+namespace magmadnn {
+namespace internal {
+
+template <typename T>
+magmadnn_error_t adam_update_internal(const std::vector<Tensor<T> *>& vars, const std::vector<Tensor<T> *>& grads, Tensor<T> *moments,
+    T step, T beta1, T beta2, T epsilon) {
+    magmadnn_error_t err = (magmadnn_error_t) 2;
+
+    /* where each variable starts in the moments */
+    std::vector<size_t> offsets (vars.size() + 1, 0);
+    for (unsigned int i = 0; i < vars.size(); i++) {
+        if (grads[i]->get_size() != vars[i]->get_size()) return (magmadnn_error_t) 1;
+        offsets[i+1] = offsets[i] + vars[i]->get_size();
+    }
+    size_t total = offsets.back();
+
+    size_t half = moments->get_size() / 2;
+
+    if (moments->get_size() % 2 != 0 || half < total) return (magmadnn_error_t) 1;
+    if (total == 0) return (magmadnn_error_t) 0;
+
+    if (moments->get_memory_type() == HOST) {
+        std::vector<T *> var_ptrs (vars.size()), grad_ptrs (vars.size());
+        for (unsigned int i = 0; i < vars.size(); i++) {
+            var_ptrs[i] = vars[i]->get_ptr();
+            grad_ptrs[i] = grads[i]->get_ptr();
+        }
+        T *m = moments->get_ptr();
+        T *v = m + half;
+
+        /* the variables are split up as one range, so small ones share a thread and large ones are spread over all of them */
+        parallel::parallel_for(0, total, [&](size_t begin, size_t end) {
+            size_t k = std::upper_bound(offsets.begin(), offsets.end(), begin) - offsets.begin() - 1;
+
+            while (begin < end) {
+                size_t stop = std::min(end, offsets[k+1]);
+                size_t local = begin - offsets[k];
+
+                vadam(stop - begin, var_ptrs[k] + local, grad_ptrs[k] + local, m + begin, v + begin, step, beta1, beta2, epsilon);
+
+                begin = stop;
+                k++;
+            }
+        });
+        err = (magmadnn_error_t) 0;
+    }
+    #if defined(_HAS_CUDA_)
+    else {
+        err = adam_update_internal_device(vars, grads, moments, step, beta1, beta2, epsilon);
+    }
+    #endif
+
+    return err;
+}
+template magmadnn_error_t adam_update_internal(const std::vector<Tensor<int> *>& vars, const std::vector<Tensor<int> *>& grads, Tensor<int> *moments,
+    int step, int beta1, int beta2, int epsilon);
+template magmadnn_error_t adam_update_internal(const std::vector<Tensor<float> *>& vars, const std::vector<Tensor<float> *>& grads, Tensor<float> *moments,
+    float step, float beta1, float beta2, float epsilon);
+template magmadnn_error_t adam_update_internal(const std::vector<Tensor<double> *>& vars, const std::vector<Tensor<double> *>& grads, Tensor<double> *moments,
+    double step, double beta1, double beta2, double epsilon);
+
+}   // namespace internal
+}   // namespace magmadnn
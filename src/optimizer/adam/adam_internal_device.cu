@@ -0,0 +1,53 @@
+/**
+ * @file adam_internal_device.cu
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-21
+ * 
+ * @copyright Copyright (c) 2019
+ */
+#include "optimizer/adam/adam_internal.h"
+
+namespace magmadnn {
+namespace internal {
+
+template <typename T>
+__global__ void kernel_adam_update_internal_device(T *var, T *grad, T *m, T *v, T step, T beta1, T beta2, T epsilon, size_t size) {
+    size_t idx = blockDim.x * blockIdx.x + threadIdx.x;
+    size_t stride = gridDim.x * blockDim.x;
+
+    for (size_t i = idx; i < size; i += stride) {
+        T g = grad[i];
+        m[i] = beta1 * m[i] + (1 - beta1) * g;
+        v[i] = beta2 * v[i] + (1 - beta2) * g * g;
+        var[i] -= step * m[i] / (sqrt(v[i]) + epsilon);
+    }
+}
+
+template <typename T>
+magmadnn_error_t adam_update_internal_device(const std::vector<Tensor<T> *>& vars, const std::vector<Tensor<T> *>& grads, Tensor<T> *moments,
+    T step, T beta1, T beta2, T epsilon) {
+    size_t half = moments->get_size() / 2;
+    size_t offset = 0;
+    T *m = moments->get_ptr();
+    T *v = m + half;
+
+    /* the launches all go on the default stream, so they run back to back without syncing */
+    for (unsigned int i = 0; i < vars.size(); i++) {
+        size_t size = vars[i]->get_size();
+        kernel_adam_update_internal_device <<< (size + 255) / 256, 256 >>> (vars[i]->get_ptr(), grads[i]->get_ptr(),
+            m + offset, v + offset, step, beta1, beta2, epsilon, size);
+        offset += size;
+    }
+
+    return (magmadnn_error_t) 0;
+}
+template magmadnn_error_t adam_update_internal_device(const std::vector<Tensor<int> *>& vars, const std::vector<Tensor<int> *>& grads, Tensor<int> *moments,
+    int step, int beta1, int beta2, int epsilon);
+template magmadnn_error_t adam_update_internal_device(const std::vector<Tensor<float> *>& vars, const std::vector<Tensor<float> *>& grads, Tensor<float> *moments,
+    float step, float beta1, float beta2, float epsilon);
+template magmadnn_error_t adam_update_internal_device(const std::vector<Tensor<double> *>& vars, const std::vector<Tensor<double> *>& grads, Tensor<double> *moments,
+    double step, double beta1, double beta2, double epsilon);
+
+}   // namespace internal
+}   // namespace magmadnn
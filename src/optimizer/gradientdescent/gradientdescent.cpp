@@ -12,32 +12,93 @@ namespace magmadnn {
 namespace optimizer {
 
 template <typename T>
-GradientDescent<T>::GradientDescent(op::Operation<T> *_obj_func, T learning_rate) : Optimizer<T>::Optimizer(_obj_func), learning_rate(learning_rate) {
+GradientDescent<T>::GradientDescent(op::Operation<T> *_obj_func, T learning_rate, bool parallel)
+    : Optimizer<T>::Optimizer(_obj_func), learning_rate(learning_rate), parallel(parallel), _executor(NULL) {
     /* set the name of this Optimizer */
     this->_name = "GradientDescentOptimizer";
 }
 
+template <typename T>
+GradientDescent<T>::~GradientDescent() {
+    if (this->_executor != NULL) delete this->_executor;
+}
+
 template <typename T>
 void GradientDescent<T>::minimize(const std::vector<op::Operation<T> *>& wrt) {
     typename std::vector<op::Operation<T> *>::const_iterator vit;
 
-    op::get_grad_table(wrt, this->_obj_func, this->table);
-    
+    /* only (re)build the gradient graph if the variables changed since the last step */
+    if (wrt != this->_table_wrt) {
+        std::vector<op::Operation<T> *> outputs (1, this->_obj_func);
+
+        /* the old gradient graph goes all at once */
+        this->reset_grad_table();
+
+        {
+            op::GraphArenaScope scope (this->_arena);
+            op::get_grad_table(wrt, this->_obj_func, this->table);
+        }
+        this->_table_wrt = wrt;
+
+        for (vit = wrt.begin(); vit != wrt.end(); vit++) outputs.push_back(table.get(*vit));
+
+        if (this->parallel) {
+            this->_executor = new op::ParallelExecutor<T> (outputs);
+        } else {
+            this->_executor = new op::GraphExecutor<T> (outputs);
+        }
+    }
+
+    /* compute everything that is stale */
+    this->_executor->run();
+
+    this->apply_gradients(wrt);
+
+    /* only the parts of the graph that depend on the updated variables need to be recomputed */
     for (vit = wrt.begin(); vit != wrt.end(); vit++) {
-        this->update((*vit), table.get(*vit));
+        this->_executor->invalidate(*vit);
     }
 }
 
+template <typename T>
+void GradientDescent<T>::invalidate(op::Operation<T> *var) {
+    if (this->_executor != NULL) {
+        this->_executor->invalidate(var);
+    } else {
+        var->invalidate();
+    }
+}
+
+template <typename T>
+void GradientDescent<T>::reset_grad_table() {
+    this->table.clear();
+    this->_table_wrt.clear();
+
+    if (this->_executor != NULL) delete this->_executor;
+    this->_executor = NULL;
+
+    this->_arena.clear();
+}
+
 template <typename T>
 void GradientDescent<T>::update(op::Operation<T> *var, op::Operation<T> *grad) {
     Tensor<T> *var_tensor, *grad_tensor;
 
-    var_tensor = var->eval(true);
-    grad_tensor = grad->eval(true);
+    var_tensor = var->eval(false);
+    grad_tensor = grad->eval(false);
 
     internal::gradientdescent_update_internal(var_tensor, grad_tensor, this->learning_rate);
 }
 
+template <typename T>
+void GradientDescent<T>::apply_gradients(const std::vector<op::Operation<T> *>& wrt) {
+    typename std::vector<op::Operation<T> *>::const_iterator vit;
+
+    for (vit = wrt.begin(); vit != wrt.end(); vit++) {
+        this->update((*vit), this->table.get(*vit));
+    }
+}
+
 template class GradientDescent<int>;
 template class GradientDescent<float>;
 template class GradientDescent<double>;
@@ -15,14 +15,22 @@ template <typename T>
 magmadnn_error_t gradientdescent_update_internal(Tensor<T> *var, Tensor<T> *grad, T learning_rate) {
     magmadnn_error_t err = (magmadnn_error_t) 2;
 
+    if (grad->get_size() != var->get_size()) {
+        /* the grad is repeated along the axes var was broadcast on */
+        internal::broadcast_full(internal::BROADCAST_ADD, (T) 1, var, -learning_rate, grad, var);
+        return (magmadnn_error_t) 0;
+    }
+
     if (var->get_memory_type() == HOST) {
         T *var_ptr = var->get_ptr();
         T *grad_ptr = grad->get_ptr();
-        unsigned int size = var->get_size();
+        size_t size = var->get_size();
 
-        for (unsigned int i = 0; i < size; i++) {
-            var_ptr[i] -= learning_rate * grad_ptr[i];
-        }
+        parallel::parallel_for(0, size, [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                var_ptr[i] -= learning_rate * grad_ptr[i];
+            }
+        });
         err = (magmadnn_error_t) 0;
     }
     #if defined(_HAS_CUDA_)
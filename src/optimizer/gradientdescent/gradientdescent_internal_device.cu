@@ -12,11 +12,11 @@ namespace magmadnn {
 namespace internal {
  
 template <typename T>
-__global__ void kernel_gradientdescent_update_internal_device(T *var, T *grad, T learning_rate, unsigned int size) {
-    unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
-    unsigned int stride = gridDim.x * blockDim.x;
+__global__ void kernel_gradientdescent_update_internal_device(T *var, T *grad, T learning_rate, size_t size) {
+    size_t idx = blockDim.x * blockIdx.x + threadIdx.x;
+    size_t stride = gridDim.x * blockDim.x;
 
-    for (unsigned int i = idx; i < size; i += stride) {
+    for (size_t i = idx; i < size; i += stride) {
         var[i] -= learning_rate * grad[i];
     }
 }
@@ -25,7 +25,7 @@ template <typename T>
 magmadnn_error_t gradientdescent_update_internal_device(Tensor<T> *var, Tensor<T> *grad, T learning_rate) {
     magmadnn_error_t err = (magmadnn_error_t) 0;
  
-    unsigned int size = var->get_size();
+    size_t size = var->get_size();
     kernel_gradientdescent_update_internal_device <<< 1, size >>> (var->get_ptr(), grad->get_ptr(), learning_rate, size);
  
     return (magmadnn_error_t) err;
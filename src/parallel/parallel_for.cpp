@@ -0,0 +1,61 @@
+/**
+ * @file parallel_for.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-06
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "parallel/parallel_for.h"
+
+namespace magmadnn {
+namespace parallel {
+
+/* below this many elements an elementwise kernel isn't worth splitting */
+const size_t DEFAULT_GRAIN_SIZE = 16384;
+
+static std::atomic<size_t> grain = ATOMIC_VAR_INIT(DEFAULT_GRAIN_SIZE);
+
+void parallel_for(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body) {
+    parallel_for(begin, end, get_grain_size(), body);
+}
+
+void parallel_for(size_t begin, size_t end, size_t grain_size, const std::function<void(size_t, size_t)>& body) {
+    size_t size, n_chunks, chunk;
+    ThreadPool *pool;
+    TaskGroup group;
+
+    if (end <= begin) return;
+
+    size = end - begin;
+    n_chunks = size / std::max(grain_size, (size_t) 1);
+
+    if (n_chunks < 2 || get_num_threads() < 2) {
+        body(begin, end);
+        return;
+    }
+
+    pool = get_default_thread_pool();
+    n_chunks = std::min(n_chunks, (size_t) pool->get_n_threads());
+    chunk = (size + n_chunks - 1) / n_chunks;
+
+    /* the calling thread takes the first chunk itself */
+    for (size_t start = begin + chunk; start < end; start += chunk) {
+        size_t stop = std::min(end, start + chunk);
+        pool->submit(group, [&body, start, stop]() { body(start, stop); });
+    }
+    body(begin, std::min(end, begin + chunk));
+
+    pool->wait(group);
+}
+
+void set_grain_size(size_t grain_size) {
+    grain = (grain_size != 0) ? grain_size : DEFAULT_GRAIN_SIZE;
+}
+
+size_t get_grain_size() {
+    return grain;
+}
+
+}   // namespace parallel
+}   // namespace magmadnn
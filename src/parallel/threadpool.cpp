@@ -0,0 +1,171 @@
+/**
+ * @file threadpool.cpp
+ * @author Daniel Nichols
+ * @version 0.1
+ * @date 2019-06-05
+ *
+ * @copyright Copyright (c) 2019
+ */
+#include "parallel/threadpool.h"
+
+namespace magmadnn {
+namespace parallel {
+
+/* the pool the current thread works for and its queue in that pool */
+static thread_local ThreadPool *current_pool = NULL;
+static thread_local int current_idx = -1;
+
+ThreadPool::ThreadPool(unsigned int n_workers) : n_queued(0), stop(false) {
+    for (unsigned int i = 0; i < n_workers + 1; i++) queues.push_back(new queue_t);
+
+    for (unsigned int i = 0; i < n_workers; i++) {
+        workers.push_back(std::thread(&ThreadPool::worker_loop, this, i));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard (sleep_lock);
+        stop = true;
+    }
+    sleep_cond.notify_all();
+
+    for (unsigned int i = 0; i < workers.size(); i++) workers[i].join();
+    for (unsigned int i = 0; i < queues.size(); i++) delete queues[i];
+}
+
+void ThreadPool::submit(TaskGroup& group, const std::function<void()>& task) {
+    task_t t;
+    int idx;
+
+    t.func = task;
+    t.group = &group;
+    group.pending++;
+
+    /* workers push to their own queue, everyone else to the shared one */
+    idx = (current_pool == this) ? current_idx : (int) queues.size() - 1;
+
+    {
+        std::lock_guard<std::mutex> guard (sleep_lock);
+        n_queued++;
+    }
+    {
+        std::lock_guard<std::mutex> guard (queues[idx]->lock);
+        queues[idx]->tasks.push_back(t);
+    }
+    sleep_cond.notify_one();
+}
+
+void ThreadPool::wait(TaskGroup& group) {
+    int idx = (current_pool == this) ? current_idx : -1;
+
+    while (!group.done()) {
+        if (!try_run(idx)) std::this_thread::yield();
+    }
+}
+
+void ThreadPool::worker_loop(unsigned int idx) {
+    current_pool = this;
+    current_idx = idx;
+
+    while (true) {
+        if (try_run(idx)) continue;
+
+        std::unique_lock<std::mutex> guard (sleep_lock);
+        sleep_cond.wait(guard, [this]() { return stop.load() || n_queued.load() != 0; });
+        if (stop && n_queued == 0) return;
+    }
+}
+
+bool ThreadPool::try_run(int idx) {
+    task_t task;
+
+    if (!pop(idx, task)) return false;
+
+    run(task);
+    return true;
+}
+
+bool ThreadPool::pop(int idx, task_t& task) {
+    unsigned int n = queues.size();
+    unsigned int start = (idx >= 0) ? idx : 0;
+
+    if (n_queued.load() == 0) return false;
+
+    /* newest task from our own queue first, since its inputs are likely still in cache */
+    if (idx >= 0) {
+        std::lock_guard<std::mutex> guard (queues[idx]->lock);
+        if (!queues[idx]->tasks.empty()) {
+            task = queues[idx]->tasks.back();
+            queues[idx]->tasks.pop_back();
+            n_queued--;
+            return true;
+        }
+    }
+
+    /* otherwise steal the oldest task from someone else */
+    for (unsigned int i = 1; i <= n; i++) {
+        unsigned int victim = (start + i) % n;
+        std::lock_guard<std::mutex> guard (queues[victim]->lock);
+        if (!queues[victim]->tasks.empty()) {
+            task = queues[victim]->tasks.front();
+            queues[victim]->tasks.pop_front();
+            n_queued--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::run(task_t& task) {
+    task.func();
+    task.group->pending--;
+}
+
+/* the default pool is created on first use and replaced when the thread count changes. once it
+   exists it is read through default_pool without taking the lock. */
+static std::mutex default_pool_lock;
+static std::unique_ptr<ThreadPool> default_pool_owner;
+static std::atomic<ThreadPool *> default_pool (NULL);
+static std::atomic<unsigned int> n_default_threads (0);
+
+ThreadPool *get_default_thread_pool() {
+    ThreadPool *pool = default_pool.load(std::memory_order_acquire);
+    if (pool != NULL) return pool;
+
+    std::lock_guard<std::mutex> guard (default_pool_lock);
+
+    pool = default_pool.load(std::memory_order_relaxed);
+    if (pool == NULL) {
+        default_pool_owner.reset(new ThreadPool(get_num_threads() - 1));
+        pool = default_pool_owner.get();
+        default_pool.store(pool, std::memory_order_release);
+    }
+    return pool;
+}
+
+void set_num_threads(unsigned int n_threads) {
+    std::lock_guard<std::mutex> guard (default_pool_lock);
+
+    n_default_threads.store(n_threads);
+    default_pool.store(NULL, std::memory_order_release);
+    default_pool_owner.reset();
+}
+
+unsigned int get_num_threads() {
+    const char *env;
+    int n;
+
+    unsigned int n_set = n_default_threads.load();
+    if (n_set != 0) return n_set;
+
+    env = std::getenv("MAGMADNN_NUM_THREADS");
+    if (env != NULL && (n = std::atoi(env)) > 0) return n;
+
+    n = std::thread::hardware_concurrency();
+    return (n > 0) ? n : 1;
+}
+
+}   // namespace parallel
+}   // namespace magmadnn
@@ -14,11 +14,11 @@ namespace magmadnn {
 namespace internal {
 
 template <typename T>
-__global__ void kernel_fill_constant(T* arr, unsigned int size, T val) {
-	unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-	unsigned int stride = blockDim.x * gridDim.x;
+__global__ void kernel_fill_constant(T* arr, size_t size, T val) {
+	size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+	size_t stride = blockDim.x * gridDim.x;
 
-	for (unsigned int i = idx; i < size; i += stride) {
+	for (size_t i = idx; i < size; i += stride) {
 		arr[i] = val;
 	}
 }
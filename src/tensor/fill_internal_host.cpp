@@ -26,23 +26,23 @@ void fill_uniform(MemoryManager<T> &m, const std::vector<T>& params) {
 
     switch (m.get_memory_type()) {
         case HOST:
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.get_host_ptr()[i] = uniform_distribution(random_generator);
             break;
 
         #if defined(_HAS_CUDA_)
         case DEVICE:
             // TODO replace with kernel call
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.set(i, uniform_distribution(random_generator));
             break;
         case MANAGED:
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.get_host_ptr()[i] = uniform_distribution(random_generator);
             m.sync(false);
             break;
         case CUDA_MANAGED:
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.get_cuda_managed_ptr()[i] = uniform_distribution(random_generator);
             m.sync(false);
             break;
@@ -62,23 +62,23 @@ template <> void fill_uniform(MemoryManager<int>& m, const std::vector<int>& par
 
     switch (m.get_memory_type()) {
         case HOST:
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.get_host_ptr()[i] = uniform_distribution(random_generator);
             break;
 
         #if defined(_HAS_CUDA_)
         case DEVICE:
             // TODO replace with kernel call
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.set(i, uniform_distribution(random_generator));
             break;
         case MANAGED:
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.get_host_ptr()[i] = uniform_distribution(random_generator);
             m.sync(false);
             break;
         case CUDA_MANAGED:
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.get_host_ptr()[i] = uniform_distribution(random_generator);
             m.sync(false);
             break;
@@ -103,23 +103,23 @@ void fill_glorot(MemoryManager<T> &m, const std::vector<T>& params) {
 
     switch (m.get_memory_type()) {
         case HOST:
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.get_host_ptr()[i] = normal_dist(random_generator);
             break;
             
         #if defined(_HAS_CUDA_)
         case DEVICE:
             // TODO replace with kernel call
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.set(i, normal_dist(random_generator));
             break;
         case MANAGED:
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.get_host_ptr()[i] = normal_dist(random_generator);
             m.sync(false);
             break;
         case CUDA_MANAGED:
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.get_cuda_managed_ptr()[i] = normal_dist(random_generator);
             m.sync(false);
             break;
@@ -139,23 +139,23 @@ template <> void fill_glorot(MemoryManager<int>& m, const std::vector<int>& para
 
     switch (m.get_memory_type()) {
         case HOST:
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.get_host_ptr()[i] = normal_dist(random_generator);
             break;
             
         #if defined(_HAS_CUDA_)
         case DEVICE:
             // TODO replace with kernel call
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.set(i, normal_dist(random_generator));
             break;
         case MANAGED:
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.get_host_ptr()[i] = normal_dist(random_generator);
             m.sync(false);
             break;
         case CUDA_MANAGED:
-            for (unsigned int i = 0; i < m.get_size(); i++)
+            for (size_t i = 0; i < m.get_size(); i++)
                 m.get_cuda_managed_ptr()[i] = normal_dist(random_generator);
             m.sync(false);
             break;
@@ -169,8 +169,8 @@ template void fill_glorot(MemoryManager<double>&, const std::vector<double>&);
 template <typename T>
 void fill_diagonal(MemoryManager<T> &m, const std::vector<T>& params) {
     bool use_constant_value;
-    unsigned int root;
-    unsigned int m_size, params_size;
+    size_t root;
+    size_t m_size, params_size;
     T val;
 
     // must have some params
@@ -182,14 +182,16 @@ void fill_diagonal(MemoryManager<T> &m, const std::vector<T>& params) {
     // make sure it's square memory
     assert( m_size == root * root );
 
-    assert( params_size >= (unsigned int) root || params_size == 1 );
+    assert( params_size >= root || params_size == 1 );
     if (params_size == 1)
         use_constant_value = true;
     else
         use_constant_value = false;
-    
 
-    for (unsigned int i = 0; i < m_size; i++) {
+    /* the allocator recycles blocks, so the off-diagonal has to be cleared too */
+    fill_constant(m, {(T) 0});
+
+    for (size_t i = 0; i < m_size; i++) {
         /* if we're on a diagonal element */
         if ( i % (root+1) == 0 ) {
             if (use_constant_value)
@@ -215,7 +217,7 @@ void fill_constant(MemoryManager<T> &m, const std::vector<T>& params) {
 
     switch (m.get_memory_type()) {
         case HOST:
-            for (int i = 0; i < (int) m.get_size(); i++) m.get_host_ptr()[i] = val;
+            for (size_t i = 0; i < m.get_size(); i++) m.get_host_ptr()[i] = val;
             break;
             
         #if defined(_HAS_CUDA_)
@@ -224,11 +226,11 @@ void fill_constant(MemoryManager<T> &m, const std::vector<T>& params) {
             break;
         case MANAGED:
 	        fill_constant_device(m, val);	// fill device
-	        for (int i = 0; i < (int) m.get_size(); i++) m.get_host_ptr()[i] = val; // fill host
+	        for (size_t i = 0; i < m.get_size(); i++) m.get_host_ptr()[i] = val; // fill host
             break;
         case CUDA_MANAGED:
 	        // fill host and sync
-	        for (int i = 0; i < (int) m.get_size(); i++) m.get_cuda_managed_ptr()[i] = val;
+	        for (size_t i = 0; i < m.get_size(); i++) m.get_cuda_managed_ptr()[i] = val;
             m.sync(false);
             break;
         #endif
@@ -42,10 +42,58 @@ Tensor<T>::Tensor(std::vector<unsigned int> shape, tensor_filler_t<T> filler, me
 }
 
 template <typename T>
-Tensor<T>::~Tensor() { 
-    delete mem_manager;
+Tensor<T>::Tensor(const std::shared_ptr<MemoryManager<T> >& storage, const std::vector<unsigned int>& shape,
+    const std::vector<size_t>& strides, size_t offset, bool viewing, memory_t mem_type, device_t device_id)
+    : storage(storage), mem_manager(storage.get()), viewing(viewing), shape(shape), strides(strides), offset(offset),
+    mem_type(mem_type), device_id(device_id) {
+
+    assert( shape.size() != 0 );
+    assert( strides.size() == shape.size() );
+
+    this->size = 1;
+    for (unsigned int i = 0; i < shape.size(); i++) {
+        this->size *= shape[i];
+    }
+}
+
+template <typename T>
+Tensor<T>::Tensor(Tensor<T>&& other) noexcept
+    : storage(std::move(other.storage)), mem_manager(other.mem_manager), viewing(other.viewing),
+    shape(std::move(other.shape)), strides(std::move(other.strides)), offset(other.offset), size(other.size),
+    mem_type(other.mem_type), device_id(other.device_id) {
+
+    other.mem_manager = NULL;
+    other.shape.clear();
+    other.strides.clear();
+    other.offset = 0;
+    other.size = 0;
+}
+
+template <typename T>
+Tensor<T>& Tensor<T>::operator=(Tensor<T>&& other) noexcept {
+    if (this == &other) return *this;
+
+    this->storage = std::move(other.storage);
+    this->mem_manager = other.mem_manager;
+    this->viewing = other.viewing;
+    this->shape = std::move(other.shape);
+    this->strides = std::move(other.strides);
+    this->offset = other.offset;
+    this->size = other.size;
+    this->mem_type = other.mem_type;
+    this->device_id = other.device_id;
+
+    other.mem_manager = NULL;
+    other.shape.clear();
+    other.strides.clear();
+    other.offset = 0;
+    other.size = 0;
+    return *this;
 }
 
+template <typename T>
+Tensor<T>::~Tensor() {}
+
 
 template <typename T>
 void Tensor<T>::init(std::vector<unsigned int>& shape, tensor_filler_t<T> filler, memory_t mem_type, device_t device_id) {
@@ -63,19 +111,126 @@ void Tensor<T>::init(std::vector<unsigned int>& shape, tensor_filler_t<T> filler
         this->size *= shape[i];
     }
 
+    // row-major strides
+    this->strides.resize(shape.size());
+    this->offset = 0;
+    size_t jump = 1;
+    for (int i = ((int) shape.size()) - 1; i >= 0; i--) {
+        this->strides[i] = jump;
+        jump *= shape[i];
+    }
+
     // create memory manager
-    this->mem_manager = new MemoryManager<T> (size, mem_type, device_id);
+    this->storage = std::make_shared<MemoryManager<T> > (size, mem_type, device_id);
+    this->mem_manager = this->storage.get();
+    this->viewing = false;
 
     internal::fill_memory(*mem_manager, filler);
 }
 
 
 template <typename T>
-magmadnn_error_t Tensor<T>::copy_from(const Tensor<T>& src, unsigned int begin_idx, unsigned int size) {
-    assert( this->size == src.get_size() );
-    assert( begin_idx+size <= this->size );
+Tensor<T> *Tensor<T>::slice(unsigned int begin, unsigned int end) {
+    std::vector<unsigned int> view_shape = this->shape;
 
-    return this->mem_manager->copy_from(*src.get_memory_manager(), begin_idx, size);
+    assert( begin <= end && end <= this->shape[0] );
+
+    view_shape[0] = end - begin;
+    return view(view_shape, this->strides, this->offset + begin * this->strides[0]);
+}
+
+template <typename T>
+Tensor<T> *Tensor<T>::reshape(const std::vector<unsigned int>& shape) {
+    std::vector<size_t> view_strides (shape.size());
+    size_t new_size = 1;
+
+    assert( is_contiguous() );
+
+    for (int i = ((int) shape.size()) - 1; i >= 0; i--) {
+        view_strides[i] = new_size;
+        new_size *= shape[i];
+    }
+    assert( new_size == this->size );
+
+    return view(shape, view_strides, this->offset);
+}
+
+template <typename T>
+Tensor<T> *Tensor<T>::permute(const std::vector<unsigned int>& perm) {
+    std::vector<unsigned int> view_shape (perm.size());
+    std::vector<size_t> view_strides (perm.size());
+    std::vector<bool> seen (perm.size(), false);
+
+    assert( perm.size() == this->shape.size() );
+
+    for (unsigned int i = 0; i < perm.size(); i++) {
+        assert( perm[i] < perm.size() && !seen[perm[i]] );
+        seen[perm[i]] = true;
+
+        view_shape[i] = this->shape[perm[i]];
+        view_strides[i] = this->strides[perm[i]];
+    }
+
+    return view(view_shape, view_strides, this->offset);
+}
+
+template <typename T>
+Tensor<T> *Tensor<T>::transpose() {
+    assert( this->shape.size() == 2 );
+    return permute({1, 0});
+}
+
+template <typename T>
+Tensor<T> *Tensor<T>::view(const std::vector<unsigned int>& shape, const std::vector<size_t>& strides, size_t offset) {
+    size_t last = offset;
+
+    /* the last element has to be inside the memory */
+    for (unsigned int i = 0; i < shape.size(); i++) {
+        if (shape[i] == 0) { last = offset; break; }
+        last += (shape[i] - 1) * strides[i];
+    }
+    assert( last < this->mem_manager->get_size() || this->size == 0 );
+
+    return new Tensor<T> (this->storage, shape, strides, offset, true, this->mem_type, this->device_id);
+}
+
+template <typename T>
+Tensor<T> Tensor<T>::share() {
+    return Tensor<T> (this->storage, this->shape, this->strides, this->offset, this->viewing, this->mem_type, this->device_id);
+}
+
+
+template <typename T>
+magmadnn_error_t Tensor<T>::copy_from(const Tensor<T>& src, size_t begin_idx, size_t size) {
+    assert( begin_idx+size <= src.get_size() );
+    assert( size <= this->size );
+
+    if (size == 0) return (magmadnn_error_t) 0;
+
+    /* whole tensors that own their memory are copied by the memory managers, which handle every memory type */
+    if (!is_view() && !src.is_view() && this->size == src.get_size()) {
+        return this->mem_manager->copy_from(*src.get_memory_manager(), begin_idx, size);
+    }
+
+    if (this->mem_type == HOST && src.get_memory_type() == HOST) {
+        const T *src_ptr = src.get_memory_manager()->get_host_ptr() + src.get_offset();
+        T *dst_ptr = this->get_ptr();
+
+        if (is_contiguous() && src.is_contiguous()) {
+            std::copy(src_ptr + begin_idx, src_ptr + begin_idx + size, dst_ptr);
+            return (magmadnn_error_t) 0;
+        }
+        if (begin_idx == 0 && size == this->size && this->shape == src.get_shape()) {
+            internal::strided_copy_host(this->shape, src_ptr, src.get_strides(), dst_ptr, this->strides);
+            return (magmadnn_error_t) 0;
+        }
+    }
+
+    /* gather one element at a time */
+    for (size_t i = 0; i < size; i++) {
+        set(i, src.get(begin_idx + i));
+    }
+    return (magmadnn_error_t) 0;
 }
 
 template <typename T>
@@ -90,8 +245,8 @@ T Tensor<T>::get(const std::vector<int>& idx) const {
 }
 
 template <typename T>
-T Tensor<T>::get(unsigned int flattened_idx) const {
-    return mem_manager->get( flattened_idx );
+T Tensor<T>::get(size_t flattened_idx) const {
+    return mem_manager->get( get_memory_index(flattened_idx) );
 }
 
 template <typename T>
@@ -100,8 +255,8 @@ void Tensor<T>::set(const std::vector<int>& idx, T val) {
 }
 
 template <typename T>
-void Tensor<T>::set(unsigned int flattened_idx, T val) {
-    mem_manager->set( flattened_idx, val );
+void Tensor<T>::set(size_t flattened_idx, T val) {
+    mem_manager->set( get_memory_index(flattened_idx), val );
 }
 
 template <typename T>
@@ -111,17 +266,55 @@ unsigned int Tensor<T>::get_shape(unsigned int idx) const {
 }
 
 template <typename T>
-unsigned int Tensor<T>::get_flattened_index(const std::vector<int>& idx) const {
-    unsigned int jump_size = 1; // the total amout to jump to get to next axis
-    unsigned int flattened_idx = 0;
+size_t Tensor<T>::get_stride(unsigned int idx) const {
+    assert( idx < this->strides.size() );
+    return this->strides[idx];
+}
+
+template <typename T>
+bool Tensor<T>::is_contiguous() const {
+    size_t jump_size = 1;
+
+    for (int i = ((int) shape.size()) - 1; i >= 0; i--) {
+        if (shape[i] != 1 && strides[i] != jump_size) return false;
+        jump_size *= shape[i];
+    }
+    return true;
+}
+
+template <typename T>
+size_t Tensor<T>::get_flattened_index(const std::vector<int>& idx) const {
+    size_t jump_size = 1; // the total amout to jump to get to next axis
+    size_t flattened_idx = 0;
+
+    /* a full index uses the strides, so it works for views */
+    if (idx.size() == shape.size()) {
+        flattened_idx = offset;
+        for (unsigned int i = 0; i < idx.size(); i++) flattened_idx += idx[i] * strides[i];
+        return flattened_idx;
+    }
 
     for (int i = ((int)idx.size()) - 1; i >= 0; i--) {
         flattened_idx += idx[i] * jump_size;
         jump_size *= shape[i];
     }
-    return flattened_idx;
+    return offset + flattened_idx;
  }
 
+template <typename T>
+size_t Tensor<T>::get_memory_index(size_t flattened_idx) const {
+    size_t mem_idx = offset;
+
+    if (is_view() && !is_contiguous()) {
+        for (int i = ((int) shape.size()) - 1; i >= 0; i--) {
+            mem_idx += (flattened_idx % shape[i]) * strides[i];
+            flattened_idx /= shape[i];
+        }
+        return mem_idx;
+    }
+    return mem_idx + flattened_idx;
+}
+
 
 
 /* COMPILE FOR INT, FLOAT, AND DOUBLE */
@@ -35,5 +35,44 @@ template void fill_memory(MemoryManager<int>&, tensor_filler_t<int>);
 template void fill_memory(MemoryManager<float>&, tensor_filler_t<float>);
 template void fill_memory(MemoryManager<double>&, tensor_filler_t<double>);
 
+
+template <typename T>
+void strided_copy_host(const std::vector<unsigned int>& shape, const T *src, const std::vector<size_t>& src_strides,
+    T *dst, const std::vector<size_t>& dst_strides) {
+    unsigned int n_dims = shape.size();
+    size_t inner = shape[n_dims-1];
+    size_t src_inner = src_strides[n_dims-1], dst_inner = dst_strides[n_dims-1];
+    size_t n_rows = 1;
+
+    for (unsigned int d = 0; d + 1 < n_dims; d++) n_rows *= shape[d];
+    if (inner == 0 || n_rows == 0) return;
+
+    parallel::parallel_for(0, n_rows, std::max((size_t) 1, parallel::get_grain_size() / inner), [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; r++) {
+            size_t rem = r, src_off = 0, dst_off = 0;
+
+            /* split the row number into the indices of the outer axes */
+            for (int d = ((int) n_dims) - 2; d >= 0; d--) {
+                unsigned int idx = rem % shape[d];
+                rem /= shape[d];
+                src_off += idx * src_strides[d];
+                dst_off += idx * dst_strides[d];
+            }
+
+            const T *s = src + src_off;
+            T *o = dst + dst_off;
+
+            if (src_inner == 1 && dst_inner == 1) {
+                std::copy(s, s + inner, o);
+            } else {
+                for (size_t j = 0; j < inner; j++) o[j * dst_inner] = s[j * src_inner];
+            }
+        }
+    });
+}
+template void strided_copy_host(const std::vector<unsigned int>&, const int*, const std::vector<size_t>&, int*, const std::vector<size_t>&);
+template void strided_copy_host(const std::vector<unsigned int>&, const float*, const std::vector<size_t>&, float*, const std::vector<size_t>&);
+template void strided_copy_host(const std::vector<unsigned int>&, const double*, const std::vector<size_t>&, double*, const std::vector<size_t>&);
+
 } // namespace internal
 } // namespace magmadnn
@@ -71,9 +71,9 @@ namespace io {
         }
 
         T val;
-        unsigned int size = t.get_size();
+        size_t size = t.get_size();
         
-        for (unsigned int i = 0; i < size; i++) {
+        for (size_t i = 0; i < size; i++) {
             val = t.get(i);
             if (!(file_stream << val << delim)) {
                 /* for some reason errored while writing value */
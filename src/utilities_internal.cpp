@@ -81,5 +81,44 @@ template void print_compute_graph(op::Operation<int> *node, bool debug);
 template void print_compute_graph(op::Operation<float> *node, bool debug);
 template void print_compute_graph(op::Operation<double> *node, bool debug);
 
+template <typename T>
+void topological_sort(const std::vector<op::Operation<T> *>& outputs, std::vector<op::Operation<T> *>& order) {
+    std::set<op::Operation<T> *> visited;
+    /* explicit stack of (node, index of next input to visit) so deep graphs can't overflow the call stack */
+    std::vector<std::pair<op::Operation<T> *, unsigned int> > stack;
+    typename std::vector<op::Operation<T> *>::const_iterator vit;
+
+    order.clear();
+
+    for (vit = outputs.begin(); vit != outputs.end(); vit++) {
+        if (*vit == NULL || visited.find(*vit) != visited.end()) continue;
+
+        visited.insert(*vit);
+        stack.push_back(std::make_pair(*vit, 0u));
+
+        while (!stack.empty()) {
+            op::Operation<T> *cur = stack.back().first;
+            std::vector<op::Operation<T> *> const& inputs = cur->get_inputs();
+
+            if (stack.back().second < inputs.size()) {
+                op::Operation<T> *next = inputs[stack.back().second];
+                stack.back().second++;
+
+                if (next != NULL && visited.find(next) == visited.end()) {
+                    visited.insert(next);
+                    stack.push_back(std::make_pair(next, 0u));
+                }
+            } else {
+                /* all inputs have been placed */
+                order.push_back(cur);
+                stack.pop_back();
+            }
+        }
+    }
+}
+template void topological_sort(const std::vector<op::Operation<int> *>&, std::vector<op::Operation<int> *>&);
+template void topological_sort(const std::vector<op::Operation<float> *>&, std::vector<op::Operation<float> *>&);
+template void topological_sort(const std::vector<op::Operation<double> *>&, std::vector<op::Operation<double> *>&);
+
 }   // namespace internal
 }   // namespace magmadnn
\ No newline at end of file
@@ -12,26 +12,56 @@
 using namespace magmadnn;
 
 void test_add(memory_t mem_type, unsigned int size);
+void test_broadcast(memory_t mem_type, unsigned int size);
 void test_sum(memory_t mem_type, unsigned int size);
+void test_shared_inputs(memory_t mem_type, unsigned int size);
+void test_graph_arena(memory_t mem_type, unsigned int size);
 void test_matmul(memory_t mem_type, unsigned int size);
+void test_matmul_int(memory_t mem_type, unsigned int size);
+void test_transpose(memory_t mem_type, unsigned int size);
+void test_permute(memory_t mem_type, unsigned int size);
+void test_lazy_transpose(memory_t mem_type, unsigned int size);
 void test_scalarproduct(memory_t mem_type, unsigned int size);
 void test_sumreduce(memory_t mem_type, unsigned int);
+void test_sumreduce_axes(memory_t mem_type, unsigned int size);
+void test_sumreduce_int(memory_t mem_type, unsigned int size);
+void test_sumreduce_accuracy(memory_t mem_type, unsigned int size);
 void test_affine(memory_t mem_type, unsigned int size);
 void test_sigmoid(memory_t mem_type, unsigned int size);
 void test_tanh(memory_t mem_type, unsigned int size);
+void test_memory_plan(memory_t mem_type, unsigned int size);
+void test_graph_executor(memory_t mem_type, unsigned int size);
+void test_parallel_executor(memory_t mem_type, unsigned int size);
+void test_parallel_for(memory_t mem_type, unsigned int size);
+void test_vmath(memory_t mem_type, unsigned int size);
 
 int main(int argc, char **argv) {
 	magmadnn_init();
 
 	// test add
 	test_for_all_mem_types(test_add, 50);
+	test_for_all_mem_types(test_broadcast, 7);
 	test_for_all_mem_types(test_sum, 6);
+	test_for_all_mem_types(test_shared_inputs, 10);
+	test_for_all_mem_types(test_graph_arena, 10);
 	test_for_all_mem_types(test_matmul, 50);
+	test_for_all_mem_types(test_matmul_int, 50);
+	test_for_all_mem_types(test_transpose, 300);
+	test_for_all_mem_types(test_permute, 5);
+	test_for_all_mem_types(test_lazy_transpose, 20);
 	test_for_all_mem_types(test_scalarproduct, 10);
 	test_for_all_mem_types(test_sumreduce, 10);
+	test_for_all_mem_types(test_sumreduce_axes, 6);
+	test_for_all_mem_types(test_sumreduce_int, 50);
+	test_for_all_mem_types(test_sumreduce_accuracy, 1 << 22);
 	test_for_all_mem_types(test_affine, 50);
 	test_for_all_mem_types(test_sigmoid, 50);
 	test_for_all_mem_types(test_tanh, 50);
+	test_for_all_mem_types(test_memory_plan, 30);
+	test_for_all_mem_types(test_graph_executor, 20);
+	test_for_all_mem_types(test_parallel_executor, 40);
+	test_for_all_mem_types(test_parallel_for, 200);
+	test_for_all_mem_types(test_vmath, 100000);
     
 	magmadnn_finalize();
     return 0;
@@ -77,6 +107,65 @@ void test_add(memory_t mem_type, unsigned int size) {
 	show_success();
 }
 
+/* where the element at out_idx of the broadcast result is read from in a tensor of shape */
+size_t broadcast_src_idx(size_t out_idx, const std::vector<unsigned int>& out_shape, const std::vector<unsigned int>& shape) {
+	size_t idx = 0, stride = 1;
+	for (int i = (int) out_shape.size() - 1, j = (int) shape.size() - 1; j >= 0; i--, j--) {
+		size_t axis_idx = out_idx % out_shape[i];
+		out_idx /= out_shape[i];
+		if (shape[j] != 1) idx += axis_idx * stride;
+		stride *= shape[j];
+	}
+	return idx;
+}
+
+void check_broadcast(memory_t mem_type, const std::vector<unsigned int>& a_shape, const std::vector<unsigned int>& b_shape, const std::vector<unsigned int>& out_shape) {
+	Tensor<float> *a = new Tensor<float> (a_shape, {UNIFORM, {-1.0f, 1.0f}}, mem_type);
+	Tensor<float> *b = new Tensor<float> (b_shape, {UNIFORM, {1.0f, 2.0f}}, mem_type);
+	Tensor<float> *a_host = new Tensor<float> (a_shape, {NONE, {}}, HOST);
+	Tensor<float> *b_host = new Tensor<float> (b_shape, {NONE, {}}, HOST);
+	a_host->copy_from(*a);
+	b_host->copy_from(*b);
+
+	op::Variable<float> *a_var = op::var("a", a);
+	op::Variable<float> *b_var = op::var("b", b);
+
+	op::Operation<float> *ops[4] = { op::add(a_var, b_var), op::sub(a_var, b_var), op::product(a_var, b_var), op::div(a_var, b_var, true, true) };
+
+	for (unsigned int k = 0; k < 4; k++) {
+		assert( ops[k]->get_output_shape() == out_shape );
+
+		Tensor<float> *out = ops[k]->eval();
+		sync(out);
+
+		for (size_t i = 0; i < out->get_size(); i++) {
+			float x = a_host->get(broadcast_src_idx(i, out_shape, a_shape));
+			float y = b_host->get(broadcast_src_idx(i, out_shape, b_shape));
+			float expected = (k == 0) ? x + y : (k == 1) ? x - y : (k == 2) ? x * y : x / y;
+			assert( fequal(out->get(i), expected) );
+		}
+	}
+
+	delete a_host;
+	delete b_host;
+	delete a;
+	delete b;
+}
+
+void test_broadcast(memory_t mem_type, unsigned int size) {
+	printf("Testing %s broadcast...  ", get_memory_type_name(mem_type));
+
+	check_broadcast(mem_type, {size, size+1}, {size, size+1}, {size, size+1});
+	check_broadcast(mem_type, {size, size+1}, {1, size+1}, {size, size+1});
+	check_broadcast(mem_type, {size+1}, {size, size+1}, {size, size+1});
+	check_broadcast(mem_type, {size, 1}, {1, size+1}, {size, size+1});
+	check_broadcast(mem_type, {size, size+1}, {1}, {size, size+1});
+	check_broadcast(mem_type, {size, 1, size+2}, {size+1, 1}, {size, size+1, size+2});
+	check_broadcast(mem_type, {1, size, 1, 3}, {size+1, 1, size+2, 3}, {size+1, size, size+2, 3});
+
+	show_success();
+}
+
 void test_sum(memory_t mem_type, unsigned int size) {
 	float val0 = 1.5, val1 = 2.0, val2 = -1.2, val3 = 3.275;
 	float total = val0 + val1 + val2 + val3;
@@ -109,6 +198,90 @@ void test_sum(memory_t mem_type, unsigned int size) {
 	show_success();
 }
 
+void test_shared_inputs(memory_t mem_type, unsigned int size) {
+	printf("Testing %s shared inputs...  ", get_memory_type_name(mem_type));
+
+	/* x is used three times and x+x twice, so deleting the root must free each of them once */
+	op::Variable<float> *x = op::var<float>("x", {size, size}, {CONSTANT, {2.0f}}, mem_type);
+	op::Operation<float> *twice = op::add(x, x);
+	op::Operation<float> *fin = op::add(op::add(twice, x), twice);
+
+	assert( x->get_n_owners() == 3 && twice->get_n_owners() == 2 );
+
+	Tensor<float> *out = fin->eval();
+	sync(out);
+	for (unsigned int i = 0; i < out->get_size(); i++) assert( out->get(i) == 10.0f );
+
+	/* an operation that dies while its input lives removes itself from the input's consumers */
+	op::Operation<float> *y = op::var<float>("y", {size, size}, {CONSTANT, {1.0f}}, mem_type);
+	op::Operation<float> *extra = op::add(x, y);
+	assert( x->get_n_owners() == 4 && x->get_consumers().size() == 4 );
+	delete extra;
+	assert( x->get_n_owners() == 3 && x->get_consumers().size() == 3 );
+
+	delete fin;
+
+	show_success();
+}
+
+void test_graph_arena(memory_t mem_type, unsigned int size) {
+	printf("Testing %s graph arena...  ", get_memory_type_name(mem_type));
+
+	op::Variable<float> *x = op::var<float>("x", {size, size}, {CONSTANT, {1.0f}}, mem_type);
+	op::GraphArena arena (4096);
+	size_t reserved = 0;
+
+	for (unsigned int step = 0; step < 3; step++) {
+		op::Operation<float> *fin = x;
+
+		{
+			op::GraphArenaScope scope (arena);
+
+			/* shared nodes are fine, the arena destroys each once */
+			for (unsigned int i = 0; i < 100; i++) fin = op::add(fin, x);
+			fin = op::add(fin, fin);
+		}
+		assert( op::GraphArena::get_current() == NULL );
+		assert( arena.get_n_nodes() == 101 && fin->get_arena() == &arena );
+
+		/* nodes are packed together */
+		assert( arena.get_bytes_used() <= arena.get_bytes_reserved() );
+		assert( arena.get_bytes_reserved() < 101 * 2 * sizeof(op::AddOp<float>) + 4096 );
+
+		Tensor<float> *out = fin->eval();
+		sync(out);
+		for (unsigned int i = 0; i < size; i++) assert( out->get(i) == 202.0f );
+
+		arena.clear();
+		assert( arena.get_n_nodes() == 0 && arena.get_bytes_used() == 0 );
+		assert( x->get_consumers().empty() );
+
+		/* rebuilding reuses the chunks */
+		if (step == 0) reserved = arena.get_bytes_reserved();
+		assert( arena.get_bytes_reserved() == reserved );
+	}
+
+	/* heap operations can consume arena nodes, and outside a scope nothing goes in the arena */
+	op::Operation<float> *twice;
+	{
+		op::GraphArenaScope scope (arena);
+		twice = op::add(x, x);
+	}
+	op::Operation<float> *heap = op::add(twice, op::var<float>("y", {size, size}, {CONSTANT, {1.0f}}, mem_type));
+	assert( heap->get_arena() == NULL && arena.get_n_nodes() == 1 && twice->get_n_owners() == 0 );
+	Tensor<float> *out = heap->eval();
+	sync(out);
+	assert( out->get(0) == 3.0f );
+	delete heap;	/* y goes with it, twice stays with the arena */
+	assert( arena.get_n_nodes() == 1 );
+
+	arena.release();
+	assert( arena.get_bytes_reserved() == 0 );
+	delete x;
+
+	show_success();
+}
+
 void test_matmul(memory_t mem_type, unsigned int size) {
 	unsigned int m = size;
 	unsigned int n = size;
@@ -150,6 +323,211 @@ void test_matmul(memory_t mem_type, unsigned int size) {
 	show_success();
 }
 
+void test_matmul_int(memory_t mem_type, unsigned int size) {
+	/* odd sizes, so that the edges of every block are covered, and K spans more than one block */
+	unsigned int m = size + 3;
+	unsigned int k = 6 * size + 1;
+	unsigned int n = size + 11;
+	int alpha = 3, beta = -2;
+
+	printf("Testing %s int matmul...  ", get_memory_type_name(mem_type));
+
+	Tensor<int> *a = new Tensor<int> ({m,k}, {ZERO, {}}, mem_type);
+	Tensor<int> *b = new Tensor<int> ({k,n}, {ZERO, {}}, mem_type);
+	Tensor<int> *c = new Tensor<int> ({m,n}, {ZERO, {}}, mem_type);
+	std::vector<int> expected (m*n);
+
+	for (int i = 0; i < (int) m; i++)
+		for (int j = 0; j < (int) k; j++)
+			a->set({i,j}, (i*7 + j*13) % 19 - 9);
+	for (int i = 0; i < (int) k; i++)
+		for (int j = 0; j < (int) n; j++)
+			b->set({i,j}, (i*5 + j*11) % 23 - 11);
+
+	Tensor<int> *a_t = new Tensor<int> ({k,m}, {ZERO, {}}, mem_type);
+	Tensor<int> *b_t = new Tensor<int> ({n,k}, {ZERO, {}}, mem_type);
+	for (int i = 0; i < (int) m; i++)
+		for (int j = 0; j < (int) k; j++)
+			a_t->set({j,i}, a->get({i,j}));
+	for (int i = 0; i < (int) k; i++)
+		for (int j = 0; j < (int) n; j++)
+			b_t->set({j,i}, b->get({i,j}));
+
+	for (int i = 0; i < (int) m; i++) {
+		for (int j = 0; j < (int) n; j++) {
+			int sum = 0;
+			for (int p = 0; p < (int) k; p++) sum += a->get({i,p}) * b->get({p,j});
+			expected[i*n + j] = alpha*sum + beta*(i - j);
+		}
+	}
+
+	/* every instruction set has to give the exact same result */
+	internal::vmath_isa_t isa = internal::vmath_get_isa();
+	for (int v = internal::VMATH_GENERIC; v <= internal::VMATH_AVX512; v++) {
+		if (!internal::vmath_set_isa((internal::vmath_isa_t) v)) continue;
+
+		for (int i = 0; i < (int) m; i++)
+			for (int j = 0; j < (int) n; j++)
+				c->set({i,j}, i - j);
+
+		internal::gemm_full(alpha, a, b, beta, c);
+
+		#if defined(_HAS_CUDA_)
+		if (mem_type == DEVICE || mem_type == CUDA_MANAGED) c->get_memory_manager()->sync();
+		if (mem_type == MANAGED) c->get_memory_manager()->sync(true);
+		#endif
+
+		for (int i = 0; i < (int) m; i++) {
+			for (int j = 0; j < (int) n; j++) {
+				assert( c->get({i,j}) == expected[i*n + j] );
+			}
+		}
+
+		/* the same product from the transposes of a and b */
+		for (int i = 0; i < (int) m; i++)
+			for (int j = 0; j < (int) n; j++)
+				c->set({i,j}, i - j);
+
+		internal::gemm_full(alpha, true, a_t, true, b_t, beta, c);
+
+		#if defined(_HAS_CUDA_)
+		if (mem_type == DEVICE || mem_type == CUDA_MANAGED) c->get_memory_manager()->sync();
+		if (mem_type == MANAGED) c->get_memory_manager()->sync(true);
+		#endif
+
+		for (int i = 0; i < (int) m; i++) {
+			for (int j = 0; j < (int) n; j++) {
+				assert( c->get({i,j}) == expected[i*n + j] );
+			}
+		}
+	}
+	internal::vmath_set_isa(isa);
+
+	delete a;
+	delete b;
+	delete c;
+	delete a_t;
+	delete b_t;
+
+	show_success();
+}
+
+template <typename T>
+void check_transpose(memory_t mem_type, unsigned int rows, unsigned int cols) {
+	Tensor<T> *x = new Tensor<T> ({rows, cols}, {NONE, {}}, mem_type);
+	for (unsigned int i = 0; i < x->get_size(); i++) x->set(i, (T) i);
+
+	op::Operation<T> *t = op::transpose(op::var("x", x));
+	Tensor<T> *out = t->eval();
+	sync(out);
+
+	assert( out->get_shape(0) == cols && out->get_shape(1) == rows );
+	for (int r = 0; r < (int) rows; r++) {
+		for (int c = 0; c < (int) cols; c++) {
+			assert( out->get({c,r}) == x->get({r,c}) );
+		}
+	}
+
+	delete x;
+}
+
+void test_transpose(memory_t mem_type, unsigned int size) {
+	printf("Testing %s transpose...  ", get_memory_type_name(mem_type));
+
+	/* the tile transpose for every instruction set. sizes that are not a multiple of any tile,
+	   and big enough to be split across threads. */
+	internal::vmath_isa_t isa = internal::vmath_get_isa();
+	for (int v = internal::VMATH_GENERIC; v <= internal::VMATH_AVX512; v++) {
+		if (!internal::vmath_set_isa((internal::vmath_isa_t) v)) continue;
+
+		check_transpose<int>(mem_type, size, size + 13);
+		check_transpose<float>(mem_type, size + 5, size);
+		check_transpose<double>(mem_type, size, size + 3);
+		check_transpose<float>(mem_type, 1, 7);
+	}
+	internal::vmath_set_isa(isa);
+
+	show_success();
+}
+
+void test_permute(memory_t mem_type, unsigned int size) {
+	std::vector<unsigned int> shape = {size-2, size, size+2, 2*size+1};
+	std::vector<std::vector<unsigned int> > perms = {{2,0,3,1}, {0,1,3,2}, {1,0,2,3}, {3,2,1,0}, {0,1,2,3}};
+
+	printf("Testing %s permute...  ", get_memory_type_name(mem_type));
+
+	Tensor<float> *x = new Tensor<float> (shape, {NONE, {}}, mem_type);
+	for (unsigned int i = 0; i < x->get_size(); i++) x->set(i, (float) i);
+	op::Variable<float> *x_var = op::var("x", x);
+
+	for (unsigned int p = 0; p < perms.size(); p++) {
+		std::vector<unsigned int> const& perm = perms[p];
+		std::vector<unsigned int> inverse (perm.size());
+		for (unsigned int i = 0; i < perm.size(); i++) inverse[perm[i]] = i;
+
+		op::Operation<float> *permuted = op::transpose(x_var, perm);
+		Tensor<float> *out = permuted->eval();
+		sync(out);
+
+		for (unsigned int i = 0; i < perm.size(); i++) assert( out->get_shape(i) == shape[perm[i]] );
+
+		for (int a = 0; a < (int) shape[0]; a++)
+			for (int b = 0; b < (int) shape[1]; b++)
+				for (int c = 0; c < (int) shape[2]; c++)
+					for (int d = 0; d < (int) shape[3]; d++) {
+						int idx[4] = {a, b, c, d};
+						assert( out->get({idx[perm[0]], idx[perm[1]], idx[perm[2]], idx[perm[3]]}) == x->get({a,b,c,d}) );
+					}
+
+		/* the inverse permutation gives back x */
+		Tensor<float> *back = op::transpose(permuted, inverse)->eval();
+		sync(back);
+		for (unsigned int i = 0; i < x->get_size(); i++) assert( back->get(i) == x->get(i) );
+	}
+
+	delete x;
+
+	show_success();
+}
+
+void test_lazy_transpose(memory_t mem_type, unsigned int size) {
+	printf("Testing %s lazy transpose...  ", get_memory_type_name(mem_type));
+
+	unsigned int m = size, k = size + 3, n = size + 7;
+
+	/* B is a slice of the rows of a bigger tensor, so it is a view as well */
+	Tensor<float> *big = new Tensor<float> ({n + 10, k}, {UNIFORM, {-1.0f, 1.0f}}, mem_type);
+	Tensor<float> *b_rows = big->slice(4, 4 + n);
+
+	op::Operation<float> *a = op::var<float> ("A", {m, k}, {UNIFORM, {-1.0f, 1.0f}}, mem_type);
+	op::Operation<float> *b = op::var<float> ("B", b_rows);
+	op::Operation<float> *c = op::var<float> ("C", {k, n}, {UNIFORM, {-1.0f, 1.0f}}, mem_type);
+
+	/* the view shares B's memory */
+	op::Operation<float> *b_t = op::transpose(b, false, false);
+	Tensor<float> *b_t_view = b_t->eval_view();
+	assert( b_t_view->is_view() && !b_t_view->is_contiguous() );
+	assert( b_t_view->get_memory_manager() == big->get_memory_manager() );
+
+	/* gemm takes the strided view */
+	Tensor<float> *lazy = op::matmul(a, b_t, false)->eval();
+	Tensor<float> *flagged = op::matmul<float>(a, false, b, true, false)->eval();
+	sync(lazy);
+	sync(flagged);
+	for (unsigned int i = 0; i < lazy->get_size(); i++) assert( fequal(lazy->get(i), flagged->get(i)) );
+
+	/* add can't, so it gets a contiguous copy */
+	Tensor<float> *sum = op::add(b_t, c, true, false)->eval();
+	sync(sum);
+	for (int i = 0; i < (int) k; i++) {
+		for (int j = 0; j < (int) n; j++) {
+			assert( fequal(sum->get({i,j}), b_rows->get({j,i}) + c->get_return_ptr()->get({i,j})) );
+		}
+	}
+
+	show_success();
+}
+
 void test_scalarproduct(memory_t mem_type, unsigned int size) {
 	float alpha = 1.5f;
 	float val = 50.0f;
@@ -216,6 +594,142 @@ void test_sumreduce(memory_t mem_type, unsigned int size) {
 	show_success();
 }
 
+template <typename T>
+void check_sumreduce_axes(memory_t mem_type, std::vector<unsigned int> const& shape, std::vector<unsigned int> const& axes, internal::reduce_sum_mode_t mode) {
+	Tensor<T> *x = new Tensor<T> (shape, {NONE, {}}, mem_type);
+	for (unsigned int i = 0; i < x->get_size(); i++) x->set(i, (T) ((int) (i * 7919 % 61) - 30));
+
+	op::Operation<T> *sum = op::reducesum(op::var("x", x), axes, mode);
+	Tensor<T> *out = sum->eval();
+	sync(out);
+
+	/* expected output shape */
+	std::vector<bool> reduced (shape.size(), false);
+	std::vector<unsigned int> out_shape;
+	for (unsigned int i = 0; i < axes.size(); i++) reduced[axes[i]] = true;
+	for (unsigned int i = 0; i < shape.size(); i++) if (!reduced[i]) out_shape.push_back(shape[i]);
+	if (out_shape.empty()) out_shape = {1};
+	assert( out->get_shape() == out_shape );
+
+	/* add every element of x to its output element */
+	std::vector<double> expected (out->get_size(), 0.0);
+	std::vector<unsigned int> idx (shape.size(), 0);
+	for (unsigned int i = 0; i < x->get_size(); i++) {
+		unsigned int out_idx = 0;
+		for (unsigned int a = 0; a < shape.size(); a++) if (!reduced[a]) out_idx = out_idx * shape[a] + idx[a];
+		expected[out_idx] += (double) x->get(i);
+
+		for (int a = (int) shape.size() - 1; a >= 0; a--) {
+			if (++idx[a] < shape[a]) break;
+			idx[a] = 0;
+		}
+	}
+
+	for (unsigned int i = 0; i < out->get_size(); i++) assert( out->get(i) == (T) expected[i] );
+
+	delete x;
+}
+
+void test_sumreduce_axes(memory_t mem_type, unsigned int size) {
+	std::vector<unsigned int> shape = {size, size+1, 1, size+2, size+3};
+	std::vector<std::vector<unsigned int> > axes_sets = {{0}, {1}, {4}, {0,3}, {1,4}, {0,2}, {1,2,3}, {0,1,2,3,4}, {}};
+	internal::reduce_sum_mode_t modes[] = {internal::REDUCE_SUM_PLAIN, internal::REDUCE_SUM_PAIRWISE, internal::REDUCE_SUM_KAHAN};
+
+	printf("Testing %s sumreduce over axes...  ", get_memory_type_name(mem_type));
+
+	for (unsigned int m = 0; m < 3; m++) {
+		for (unsigned int i = 0; i < axes_sets.size(); i++) {
+			check_sumreduce_axes<int>(mem_type, shape, axes_sets[i], modes[m]);
+			check_sumreduce_axes<float>(mem_type, shape, axes_sets[i], modes[m]);
+			check_sumreduce_axes<double>(mem_type, shape, axes_sets[i], modes[m]);
+		}
+	}
+
+	/* long axes that are split across threads */
+	parallel::set_num_threads(4);
+	check_sumreduce_axes<float>(mem_type, {3, 40000}, {1}, internal::REDUCE_SUM_PLAIN);
+	check_sumreduce_axes<float>(mem_type, {40000, 3}, {0}, internal::REDUCE_SUM_KAHAN);
+	check_sumreduce_axes<double>(mem_type, {100000}, {0}, internal::REDUCE_SUM_PAIRWISE);
+	check_sumreduce_axes<int>(mem_type, {2000, 40, 3}, {0, 2}, internal::REDUCE_SUM_PLAIN);
+	parallel::set_num_threads(0);
+
+	show_success();
+}
+
+void check_sumreduce_int(memory_t mem_type, unsigned int n_rows, unsigned int n_cols) {
+	Tensor<int> *x = new Tensor<int> ({n_rows, n_cols}, {NONE, {}}, mem_type);
+	std::vector<int> row_expected (n_rows, 0), col_expected (n_cols, 0);
+
+	for (int r = 0; r < (int) n_rows; r++) {
+		for (int c = 0; c < (int) n_cols; c++) {
+			int val = (r * 31 + c * 17) % 101 - 50;
+			x->set({r,c}, val);
+			row_expected[r] += val;
+			col_expected[c] += val;
+		}
+	}
+	op::Variable<int> *v = op::var("x", x);
+
+	op::Operation<int> *col_sums_o = op::reducesum(v, 0);
+	op::Operation<int> *row_sums_o = op::reducesum(v, 1);
+	Tensor<int> *col_sums = col_sums_o->eval();
+	Tensor<int> *row_sums = row_sums_o->eval();
+	sync(col_sums);
+	sync(row_sums);
+
+	assert( col_sums->get_size() == n_cols );
+	assert( row_sums->get_size() == n_rows );
+	for (unsigned int c = 0; c < n_cols; c++) assert( col_sums->get(c) == col_expected[c] );
+	for (unsigned int r = 0; r < n_rows; r++) assert( row_sums->get(r) == row_expected[r] );
+
+	delete x;
+}
+
+void test_sumreduce_int(memory_t mem_type, unsigned int size) {
+	printf("Testing %s int sumreduce...  ", get_memory_type_name(mem_type));
+
+	/* tall, wide and square, small and large enough to be split across threads */
+	parallel::set_num_threads(4);
+	check_sumreduce_int(mem_type, size, size);
+	check_sumreduce_int(mem_type, 3 * size + 1, size);
+	check_sumreduce_int(mem_type, size, 3 * size + 1);
+	check_sumreduce_int(mem_type, 1, 7);
+	check_sumreduce_int(mem_type, 7, 1);
+	check_sumreduce_int(mem_type, 200 * size, 9);
+	check_sumreduce_int(mem_type, 9, 200 * size);
+	parallel::set_num_threads(0);
+
+	show_success();
+}
+
+void test_sumreduce_accuracy(memory_t mem_type, unsigned int size) {
+	printf("Testing %s sumreduce accuracy...  ", get_memory_type_name(mem_type));
+
+	/* a long sum of values with no exact float representation */
+	Tensor<float> *x = new Tensor<float> ({size}, {NONE, {}}, mem_type);
+	double exact = 0.0;
+	for (unsigned int i = 0; i < size; i++) {
+		float val = 0.1f + (float) (i % 10) * 0.01f;
+		x->set(i, val);
+		exact += (double) val;
+	}
+	op::Variable<float> *v = op::var("x", x);
+	std::vector<unsigned int> axes = {0};
+
+	float plain = op::reducesum<float>(v, axes, internal::REDUCE_SUM_PLAIN)->eval()->get(0);
+	float pairwise = op::reducesum<float>(v, axes, internal::REDUCE_SUM_PAIRWISE)->eval()->get(0);
+	float kahan = op::reducesum<float>(v, axes, internal::REDUCE_SUM_KAHAN)->eval()->get(0);
+
+	/* the compensated modes are within a few rounding errors of the exact sum */
+	assert( std::fabs(pairwise - exact) / exact < 1E-6 );
+	assert( std::fabs(kahan - exact) / exact < 1E-6 );
+	assert( std::fabs(kahan - exact) <= std::fabs(plain - exact) );
+
+	delete x;
+
+	show_success();
+}
+
 void test_affine(memory_t mem_type, unsigned int size) {
 	unsigned int m = size;
 	unsigned int n = size;
@@ -312,3 +826,270 @@ void test_tanh(memory_t mem_type, unsigned int size) {
 	show_success();
 }
 
+
+
+void test_memory_plan(memory_t mem_type, unsigned int size) {
+	unsigned int n_layers = 8;
+
+	printf("Testing %s memory plan...  ", get_memory_type_name(mem_type));
+
+	op::Variable<float> *x = op::var<float>("x", {size, size}, {UNIFORM, {-1.0f, 1.0f}}, mem_type);
+	op::Variable<float> *c = op::var<float>("c", {size, size}, {CONSTANT, {0.5f}}, mem_type);
+
+	/* a long chain with a branch that is reused further down */
+	op::Operation<float> *out = x;
+	op::Operation<float> *branch = op::negative(x);
+	for (unsigned int i = 0; i < n_layers; i++) {
+		out = op::add(op::negative(out), c);
+	}
+	out = op::add(op::product(out, branch), branch);
+
+	Tensor<float> *expected = new Tensor<float> ({size, size}, mem_type);
+	expected->copy_from(*out->eval());
+
+	op::MemoryPlanner<float> planner ({out});
+
+	assert( planner.get_planned_bytes() <= planner.get_naive_bytes() );
+	if (mem_type == HOST) {
+		assert( planner.get_n_planned() == 2*n_layers + 3 );
+		assert( planner.get_planned_bytes() < planner.get_naive_bytes() / 2 );
+	}
+
+	assert( planner.apply() == 0 );
+
+	Tensor<float> *fin = out->eval();
+
+	sync(fin);
+	sync(expected);
+
+	for (unsigned int i = 0; i < fin->get_size(); i++) {
+		assert( fin->get(i) == expected->get(i) );
+	}
+
+	delete expected;
+
+	show_success();
+}
+
+void test_graph_executor(memory_t mem_type, unsigned int size) {
+	float x_val = 1.5f, c_val = 0.5f, new_c_val = 2.0f;
+
+	printf("Testing %s graph executor...  ", get_memory_type_name(mem_type));
+
+	op::Variable<float> *x = op::var<float>("x", {size, size}, {CONSTANT, {x_val}}, mem_type);
+	op::Variable<float> *c = op::var<float>("c", {size, size}, {CONSTANT, {c_val}}, mem_type);
+
+	/* branch is shared by both outputs */
+	op::Operation<float> *branch = op::negative(x);
+	op::Operation<float> *o1 = op::add(branch, c);
+	op::Operation<float> *o2 = op::product(branch, c);
+
+	op::GraphExecutor<float> executor ({o1, o2});
+
+	assert( executor.get_schedule().size() == 5 );
+
+	/* every node is evaluated exactly once */
+	assert( executor.run() == 0 );
+	assert( executor.get_n_evaluated() == 5 );
+
+	/* nothing has changed */
+	assert( executor.run() == 0 );
+	assert( executor.get_n_evaluated() == 0 );
+
+	/* only c and the outputs depend on c */
+	Tensor<float> *new_c = new Tensor<float> ({size, size}, {CONSTANT, {new_c_val}}, mem_type);
+	c->eval(false)->copy_from(*new_c);
+	executor.invalidate(c);
+	assert( executor.run() == 0 );
+	assert( executor.get_n_evaluated() == 3 );
+
+	Tensor<float> *o1_tensor = o1->eval(false);
+	Tensor<float> *o2_tensor = o2->eval(false);
+	sync(o1_tensor);
+	sync(o2_tensor);
+
+	for (unsigned int i = 0; i < o1_tensor->get_size(); i++) {
+		assert( fequal(o1_tensor->get(i), -x_val + new_c_val) );
+		assert( fequal(o2_tensor->get(i), -x_val * new_c_val) );
+	}
+
+	executor.invalidate(x);
+	assert( executor.run() == 0 );
+	assert( executor.get_n_evaluated() == 4 );
+
+	delete new_c;
+
+	show_success();
+}
+
+void test_parallel_executor(memory_t mem_type, unsigned int size) {
+	unsigned int n_trials = 10;
+
+	printf("Testing %s parallel executor...  ", get_memory_type_name(mem_type));
+
+	op::Variable<float> *x = op::var<float>("x", {size, size}, {UNIFORM, {-1.0f, 1.0f}}, mem_type);
+	op::Variable<float> *w1 = op::var<float>("w1", {size, size}, {UNIFORM, {-1.0f, 1.0f}}, mem_type);
+	op::Variable<float> *w2 = op::var<float>("w2", {size, size}, {UNIFORM, {-1.0f, 1.0f}}, mem_type);
+
+	/* two independent branches joined at the end */
+	op::Operation<float> *out = op::add(op::sigmoid(op::matmul(w1, x)), op::negative(op::matmul(w2, x)));
+
+	op::GradTable<float> table;
+	assert( op::get_grad_table({w1, w2, x}, out, table) == 0 );
+
+	std::vector<op::Operation<float> *> outputs = {out, table.get(w1), table.get(w2), table.get(x)};
+
+	op::GraphExecutor<float> serial (outputs);
+	serial.invalidate_all();
+	assert( serial.run() == 0 );
+
+	std::vector<Tensor<float> *> expected;
+	for (unsigned int i = 0; i < outputs.size(); i++) {
+		expected.push_back(new Tensor<float> (outputs[i]->get_output_shape(), mem_type));
+		expected[i]->copy_from(*outputs[i]->eval(false));
+		sync(expected[i]);
+	}
+
+	parallel::ThreadPool pool (4);
+	op::ParallelExecutor<float> par (outputs, &pool);
+
+	for (unsigned int t = 0; t < n_trials; t++) {
+		par.invalidate_all();
+		assert( par.run() == 0 );
+		assert( par.get_n_evaluated() == par.get_schedule().size() );
+
+		for (unsigned int i = 0; i < outputs.size(); i++) {
+			Tensor<float> *fin = outputs[i]->eval(false);
+			sync(fin);
+
+			for (unsigned int j = 0; j < fin->get_size(); j++) {
+				assert( fin->get(j) == expected[i]->get(j) );
+			}
+		}
+	}
+
+	for (unsigned int i = 0; i < expected.size(); i++) delete expected[i];
+
+	show_success();
+}
+
+void test_parallel_for(memory_t mem_type, unsigned int size) {
+	printf("Testing %s parallel for...  ", get_memory_type_name(mem_type));
+
+	/* every index is visited exactly once */
+	std::vector<int> visits (size*size, 0);
+	parallel::set_num_threads(4);
+	parallel::set_grain_size(1000);
+	parallel::parallel_for(0, size*size, [&visits](size_t begin, size_t end) {
+		for (unsigned int i = begin; i < end; i++) visits[i]++;
+	});
+	for (unsigned int i = 0; i < visits.size(); i++) assert( visits[i] == 1 );
+
+	/* the threaded kernels give the same values as the serial ones */
+	op::Variable<float> *x = op::var<float>("x", {size, size}, {UNIFORM, {-1.0f, 1.0f}}, mem_type);
+	op::Variable<float> *y = op::var<float>("y", {size, size}, {UNIFORM, {0.5f, 1.0f}}, mem_type);
+	op::Operation<float> *out = op::add(op::sigmoid(op::product(x, y)), op::log(op::div<float>(x, y, true, true)));
+	out = op::add(op::negative(op::tanh(out)), x);
+
+	Tensor<float> *threaded = new Tensor<float> ({size, size}, mem_type);
+	threaded->copy_from(*out->eval());
+	sync(threaded);
+
+	parallel::set_num_threads(1);
+	Tensor<float> *serial = out->eval();
+	sync(serial);
+
+	for (unsigned int i = 0; i < serial->get_size(); i++) {
+		float a = serial->get(i), b = threaded->get(i);
+		assert( a == b || (a != a && b != b) );
+	}
+
+	parallel::set_num_threads(0);
+	parallel::set_grain_size(0);
+	delete threaded;
+
+	show_success();
+}
+
+/* error of got in units of the last place of the correctly rounded result */
+template <typename T>
+double ulp_error(T got, long double expected) {
+	T rounded = (T) expected;
+	if (std::isinf(rounded)) return (got == rounded) ? 0.0 : 1E9;
+	if (std::fabs(rounded) < std::numeric_limits<T>::min()) return (std::fabs(got - rounded) <= std::numeric_limits<T>::min()) ? 0.0 : 1E9;
+
+	long double ulp = std::nextafter(std::fabs(rounded), std::numeric_limits<T>::infinity()) - std::fabs(rounded);
+	return (double) (std::fabs((long double) got - expected) / ulp);
+}
+
+template <typename T>
+double max_ulp_error(void (*f)(size_t, const T *, T *), long double (*ref)(long double), T lo, T hi, unsigned int n) {
+	std::vector<T> x (n), out (n);
+	double max_err = 0.0;
+
+	for (unsigned int i = 0; i < n; i++) x[i] = lo + (hi - lo) * ((T) i / (T) n);
+	f(n, x.data(), out.data());
+
+	for (unsigned int i = 0; i < n; i++) max_err = std::max(max_err, ulp_error(out[i], ref((long double) x[i])));
+	return max_err;
+}
+
+long double ref_sigmoid(long double x) { return 1.0L / (1.0L + std::exp(-x)); }
+
+void test_vmath(memory_t mem_type, unsigned int size) {
+	long double (*ref_exp)(long double) = std::exp;
+	long double (*ref_log)(long double) = std::log;
+	long double (*ref_tanh)(long double) = std::tanh;
+
+	printf("Testing %s vmath (%s)...  ", get_memory_type_name(mem_type), internal::vmath_isa_name(internal::vmath_get_isa()));
+
+	if (mem_type != HOST) { show_success(); return; }
+
+	internal::vmath_isa_t isa = internal::vmath_get_isa();
+
+	/* check the documented bounds for every instruction set this cpu has */
+	for (int i = internal::VMATH_GENERIC; i <= internal::VMATH_AVX512; i++) {
+		if (!internal::vmath_set_isa((internal::vmath_isa_t) i)) continue;
+
+		assert( max_ulp_error<float>(internal::vexp, ref_exp, -87.0f, 88.0f, size) <= 2.0 );
+		assert( max_ulp_error<double>(internal::vexp, ref_exp, -708.0, 709.0, size) <= 2.0 );
+		assert( max_ulp_error<float>(internal::vlog, ref_log, 1E-6f, 1E6f, size) <= 1.0 );
+		assert( max_ulp_error<double>(internal::vlog, ref_log, 1E-6, 1E6, size) <= 1.0 );
+		assert( max_ulp_error<float>(internal::vtanh, ref_tanh, -10.0f, 10.0f, size) <= 2.0 );
+		assert( max_ulp_error<double>(internal::vtanh, ref_tanh, -20.0, 20.0, size) <= 2.0 );
+		assert( max_ulp_error<float>(internal::vsigmoid, ref_sigmoid, -80.0f, 80.0f, size) <= 4.0 );
+		assert( max_ulp_error<double>(internal::vsigmoid, ref_sigmoid, -700.0, 700.0, size) <= 4.0 );
+
+		/* special values */
+		float special[5] = {0.0f, -1.0f, std::numeric_limits<float>::infinity(), 100.0f, -200.0f};
+		float out[5];
+		internal::vlog(3, special, out);
+		assert( out[0] == -std::numeric_limits<float>::infinity() && out[1] != out[1] && std::isinf(out[2]) );
+		internal::vexp(5, special, out);
+		assert( out[0] == 1.0f && std::isinf(out[2]) && std::isinf(out[3]) && out[4] == 0.0f );
+
+		/* the aligned and unaligned paths must agree bit for bit */
+		unsigned int n = 1000;
+		float *xa = (float *) get_default_host_allocator()->allocate((n + 16) * sizeof(float));
+		float *ref_out = (float *) get_default_host_allocator()->allocate((n + 16) * sizeof(float));
+		float *mis_out = (float *) get_default_host_allocator()->allocate((n + 16) * sizeof(float));
+		assert( is_aligned(xa, 64) && is_aligned(ref_out, 64) );
+
+		for (unsigned int j = 0; j < n + 16; j++) xa[j] = -20.0f + 40.0f * ((float) j / (float) n);
+		for (unsigned int xo = 0; xo < 4; xo++) {
+			internal::vtanh(n, xa + xo, ref_out);
+			for (unsigned int oo = 1; oo < 4; oo++) {
+				internal::vtanh(n, xa + xo, mis_out + oo);
+				assert( std::memcmp(ref_out, mis_out + oo, n * sizeof(float)) == 0 );
+			}
+		}
+
+		get_default_host_allocator()->deallocate(xa);
+		get_default_host_allocator()->deallocate(ref_out);
+		get_default_host_allocator()->deallocate(mis_out);
+	}
+
+	internal::vmath_set_isa(isa);
+
+	show_success();
+}
@@ -17,6 +17,12 @@ using namespace magmadnn;
 void test_simple_grad(memory_t mem, unsigned int size);
 void test_full_grad(memory_t mem, unsigned int size);
 void test_optimize(memory_t mem, unsigned int size);
+void test_cached_grad(memory_t mem, unsigned int size);
+void test_fullyconnected_regrad(memory_t mem, unsigned int size);
+void test_transposed_matmul_grad(memory_t mem, unsigned int size);
+void test_crossentropy_grad(memory_t mem, unsigned int size);
+void test_broadcast_grad(memory_t mem, unsigned int size);
+void test_adam(memory_t mem, unsigned int size);
 
 int main(int argc, char **argv) {
     magmadnn_init();
@@ -24,6 +30,15 @@ int main(int argc, char **argv) {
     test_for_all_mem_types(test_simple_grad, 20);
     test_for_all_mem_types(test_full_grad, 10);
     test_for_all_mem_types(test_optimize, 20);
+    test_for_all_mem_types(test_cached_grad, 10);
+    test_for_all_mem_types(test_fullyconnected_regrad, 10);
+    test_for_all_mem_types(test_transposed_matmul_grad, 10);
+    test_for_all_mem_types(test_broadcast_grad, 10);
+    test_for_all_mem_types(test_adam, 10);
+
+    parallel::set_num_threads(4);
+    test_for_all_mem_types(test_crossentropy_grad, 10);
+    parallel::set_num_threads(0);
 
     magmadnn_finalize();
     return 0;
@@ -117,4 +132,350 @@ void test_optimize(memory_t mem, unsigned int size) {
     
 
     show_success();
-}
\ No newline at end of file
+}
+
+void test_cached_grad(memory_t mem, unsigned int size) {
+    printf("Testing cached grad on %s...  ", get_memory_type_name(mem));
+
+    float learning_rate = 0.05f;
+
+    op::Variable<float> *x = op::var<float> ("X", {size, size}, {IDENTITY, {}}, mem);
+    op::Variable<float> *a = op::var<float> ("A", {size, size}, {CONSTANT, {5.0}}, mem);
+    op::Variable<float> *b = op::var<float> ("B", {size, size}, {CONSTANT, {-1.0}}, mem);
+
+    op::Operation<float> *affine = op::add(op::matmul(a, x), b);
+
+    /* a second call on a filled table should reuse the gradient graph */
+    op::GradTable<float> table;
+    assert( op::get_grad_table({x}, affine, table) == 0 );
+    op::Operation<float> *first_grad = table.get(x);
+    unsigned int first_size = table.get_size();
+
+    assert( op::get_grad_table({x}, affine, table) == 0 );
+    assert( table.get(x) == first_grad );
+    assert( table.get_size() == first_size );
+
+    /* each step should still use the current value of x */
+    optimizer::GradientDescent<float> optim (affine, learning_rate);
+    optim.minimize({x});
+    optim.minimize({x});
+
+    Tensor<float> *x_tensor = x->eval();
+    sync(x_tensor);
+
+    for (int i = 0; i < (int)size; i++) {
+        for (int j = 0; j < (int)size; j++) {
+            float expected = ((i == j) ? 1.0f : 0.0f) - 2.0f * learning_rate * 5.0f;
+            assert( std::fabs(x_tensor->get({i,j}) - expected) < 1E-6 );
+        }
+    }
+
+    show_success();
+}
+
+void test_fullyconnected_regrad(memory_t mem, unsigned int size) {
+    printf("Testing fullyconnected grad across minimize calls on %s...  ", get_memory_type_name(mem));
+
+    float learning_rate = 0.05f;
+
+    op::Variable<float> *x = op::var<float> ("X", {size, size}, {CONSTANT, {0.1f}}, mem);
+    op::Variable<float> *w = op::var<float> ("W", {size, size}, {CONSTANT, {0.2f}}, mem);
+    op::Variable<float> *b = op::var<float> ("b", {1, size}, {CONSTANT, {0.1f}}, mem);
+
+    op::Operation<float> *fc = op::fullyconnected(x, w, b, internal::FC_SIGMOID);
+    op::Operation<float> *loss = op::reducesum(op::reducesum(fc, 0), 0);
+
+    /* each new wrt rebuilds the gradient graph, which must not reuse the grads of the last one */
+    optimizer::GradientDescent<float> optim (loss, learning_rate);
+    optim.minimize({w, b});
+    optim.minimize({w});
+    optim.minimize({w, b});
+
+    /* every element of w and of b stays equal, so the steps can be followed on scalars:
+       dL/dw = n_batch * x * s(1-s),  dL/db = n_batch * s(1-s) */
+    double w_val = 0.2, b_val = 0.1;
+    bool update_b[] = {true, false, true};
+    for (unsigned int step = 0; step < 3; step++) {
+        double s = 1.0 / (1.0 + std::exp(-(size * 0.1 * w_val + b_val)));
+        double ds = s * (1.0 - s);
+
+        w_val -= learning_rate * size * 0.1 * ds;
+        if (update_b[step]) b_val -= learning_rate * size * ds;
+    }
+
+    Tensor<float> *w_tensor = w->eval(false);
+    Tensor<float> *b_tensor = b->eval(false);
+    sync(w_tensor);
+    sync(b_tensor);
+
+    for (int i = 0; i < (int) size; i++) {
+        assert( std::fabs(b_tensor->get({0,i}) - b_val) < 1E-5 );
+        for (int j = 0; j < (int) size; j++) {
+            assert( std::fabs(w_tensor->get({i,j}) - w_val) < 1E-5 );
+        }
+    }
+
+    show_success();
+}
+
+void test_transposed_matmul_grad(memory_t mem, unsigned int size) {
+    printf("Testing transposed matmul grad on %s...  ", get_memory_type_name(mem));
+
+    /* op(A): m x k  op(B): k x n */
+    unsigned int m = size, k = size + 2, n = size + 5;
+
+    for (int flags = 0; flags < 4; flags++) {
+        bool ta = flags & 1, tb = flags & 2;
+        unsigned int a_rows = (ta) ? k : m, a_cols = (ta) ? m : k;
+        unsigned int b_rows = (tb) ? n : k, b_cols = (tb) ? k : n;
+
+        op::Variable<float> *a = op::var<float> ("A", {a_rows, a_cols}, {ZERO, {}}, mem);
+        op::Variable<float> *b = op::var<float> ("B", {b_rows, b_cols}, {ZERO, {}}, mem);
+        Tensor<float> *a_t = a->get_return_ptr(), *b_t = b->get_return_ptr();
+
+        for (int i = 0; i < (int) a_rows; i++)
+            for (int j = 0; j < (int) a_cols; j++) a_t->set({i,j}, (float) ((3*i + j) % 7 - 3));
+        for (int i = 0; i < (int) b_rows; i++)
+            for (int j = 0; j < (int) b_cols; j++) b_t->set({i,j}, (float) ((i + 5*j) % 5 - 2));
+
+        auto op_a = [&](int i, int p) { return (ta) ? a_t->get({p,i}) : a_t->get({i,p}); };
+        auto op_b = [&](int p, int j) { return (tb) ? b_t->get({j,p}) : b_t->get({p,j}); };
+
+        op::Operation<float> *prod = op::matmul<float>(a, ta, b, tb);
+        Tensor<float> *res = prod->eval();
+        sync(res);
+
+        for (int i = 0; i < (int) m; i++) {
+            for (int j = 0; j < (int) n; j++) {
+                float sum = 0.0f;
+                for (int p = 0; p < (int) k; p++) sum += op_a(i,p) * op_b(p,j);
+                assert( fequal(res->get({i,j}), sum) );
+            }
+        }
+
+        /* the grads are plain matmuls, with no transpose in between */
+        op::Variable<float> *grad = op::var<float> ("G", {m, n}, {CONSTANT, {1.0f}}, mem);
+        op::Operation<float> *d_a = prod->grad(NULL, a, grad), *d_b = prod->grad(NULL, b, grad);
+        assert( dynamic_cast<op::MatmulOp<float> *>(d_a) != NULL );
+        assert( dynamic_cast<op::MatmulOp<float> *>(d_b) != NULL );
+        for (unsigned int i = 0; i < d_a->get_inputs().size(); i++) assert( dynamic_cast<op::TransposeOp<float> *>(d_a->get_inputs()[i]) == NULL );
+        for (unsigned int i = 0; i < d_b->get_inputs().size(); i++) assert( dynamic_cast<op::TransposeOp<float> *>(d_b->get_inputs()[i]) == NULL );
+
+        Tensor<float> *res_a = d_a->eval(), *res_b = d_b->eval();
+        sync(res_a);
+        sync(res_b);
+
+        /* with a grad of ones: d op(A)(i,p) = sum_j op(B)(p,j) and d op(B)(p,j) = sum_i op(A)(i,p) */
+        for (int i = 0; i < (int) m; i++) {
+            for (int p = 0; p < (int) k; p++) {
+                float sum = 0.0f;
+                for (int j = 0; j < (int) n; j++) sum += op_b(p,j);
+                assert( fequal((ta) ? res_a->get({p,i}) : res_a->get({i,p}), sum) );
+            }
+        }
+        for (int p = 0; p < (int) k; p++) {
+            for (int j = 0; j < (int) n; j++) {
+                float sum = 0.0f;
+                for (int i = 0; i < (int) m; i++) sum += op_a(i,p);
+                assert( fequal((tb) ? res_b->get({j,p}) : res_b->get({p,j}), sum) );
+            }
+        }
+
+        /* a scalar seed scales op(B)^T and op(A)^T, also without a transpose */
+        op::Variable<float> *seed = op::var<float> ("s", {1}, {CONSTANT, {2.0f}}, mem);
+        op::Operation<float> *s_a = prod->grad(NULL, a, seed), *s_b = prod->grad(NULL, b, seed);
+        for (unsigned int i = 0; i < s_a->get_inputs().size(); i++) assert( dynamic_cast<op::TransposeOp<float> *>(s_a->get_inputs()[i]) == NULL );
+        for (unsigned int i = 0; i < s_b->get_inputs().size(); i++) assert( dynamic_cast<op::TransposeOp<float> *>(s_b->get_inputs()[i]) == NULL );
+        assert( s_a->get_output_shape() == std::vector<unsigned int>({n, k}) );
+        assert( s_b->get_output_shape() == std::vector<unsigned int>({k, m}) );
+
+        Tensor<float> *res_sa = s_a->eval(), *res_sb = s_b->eval();
+        sync(res_sa);
+        sync(res_sb);
+        for (int j = 0; j < (int) n; j++)
+            for (int p = 0; p < (int) k; p++) assert( fequal(res_sa->get({j,p}), 2.0f * op_b(p,j)) );
+        for (int p = 0; p < (int) k; p++)
+            for (int i = 0; i < (int) m; i++) assert( fequal(res_sb->get({p,i}), 2.0f * op_a(i,p)) );
+    }
+
+    show_success();
+}
+
+void test_crossentropy_grad(memory_t mem, unsigned int size) {
+    printf("Testing crossentropy grad on %s...  ", get_memory_type_name(mem));
+
+    /* enough rows to be split across threads. each row is shifted by a different large offset,
+       which a softmax over the whole batch would underflow on. */
+    unsigned int n_rows = 5000, n_cols = size;
+
+    op::Variable<double> *x = op::var<double> ("X", {n_rows, n_cols}, {ZERO, {}}, mem);
+    op::Variable<double> *y = op::var<double> ("Y", {n_rows, n_cols}, {ZERO, {}}, mem);
+    Tensor<double> *x_t = x->get_return_ptr(), *y_t = y->get_return_ptr();
+
+    for (int i = 0; i < (int) n_rows; i++) {
+        for (int j = 0; j < (int) n_cols; j++) x_t->set({i,j}, 100.0 * (i % 13) + 0.5 * ((i + 3*j) % 7));
+        y_t->set({i, (int) (i % n_cols)}, 1.0);
+    }
+
+    op::Operation<double> *loss = op::crossentropy(x, y);
+    Tensor<double> *loss_t = loss->eval();
+    sync(loss_t);
+
+    op::GradTable<double> table;
+    assert( op::get_grad_table({x}, loss, table) == 0 );
+    Tensor<double> *grad_t = table.get(x)->eval();
+    sync(grad_t);
+
+    double expected_loss = 0.0;
+    for (int i = 0; i < (int) n_rows; i++) {
+        double x_max = x_t->get({i,0}), e_sum = 0.0;
+
+        for (int j = 1; j < (int) n_cols; j++) x_max = std::max(x_max, x_t->get({i,j}));
+        for (int j = 0; j < (int) n_cols; j++) e_sum += std::exp(x_t->get({i,j}) - x_max);
+
+        for (int j = 0; j < (int) n_cols; j++) {
+            double softmax = std::exp(x_t->get({i,j}) - x_max) / e_sum;
+
+            expected_loss -= y_t->get({i,j}) * std::log(softmax);
+            assert( std::fabs(grad_t->get({i,j}) - (softmax - y_t->get({i,j})) / n_rows) < 1E-12 );
+        }
+    }
+    expected_loss /= n_rows;
+
+    assert( std::fabs(loss_t->get(0) - expected_loss) < 1E-9 * std::fabs(expected_loss) );
+
+    show_success();
+}
+
+void check_grad_value(op::Operation<float> *grad, const std::vector<unsigned int>& shape, float val) {
+    Tensor<float> *res = grad->eval();
+
+    sync(res);
+
+    assert( grad->get_output_shape() == shape );
+    for (unsigned int i = 0; i < res->get_size(); i++) {
+        assert( fequal(res->get(i), val) );
+    }
+}
+
+void test_broadcast_grad(memory_t mem, unsigned int size) {
+    printf("Testing broadcast grad on %s...  ", get_memory_type_name(mem));
+
+    /* the grads of broadcast operands are summed over the axes they were repeated on */
+    unsigned int rows = size, cols = size+1;
+
+    op::Variable<float> *x = op::var<float> ("X", {rows, cols}, {CONSTANT, {2.0f}}, mem);
+    op::Variable<float> *bias = op::var<float> ("bias", {1, cols}, {CONSTANT, {3.0f}}, mem);
+    op::Variable<float> *col = op::var<float> ("col", {rows, 1}, {CONSTANT, {4.0f}}, mem);
+    op::Variable<float> *ones = op::var<float> ("ones", {rows, cols}, {ONE, {}}, mem);
+
+    op::Operation<float> *sum = op::add(x, bias);
+    check_grad_value(sum->grad(sum, x, ones), {rows, cols}, 1.0f);
+    check_grad_value(sum->grad(sum, bias, ones), {1, cols}, (float) rows);
+
+    op::Operation<float> *diff = op::sub(col, bias);
+    check_grad_value(diff->grad(diff, col, ones), {rows, 1}, (float) cols);
+    check_grad_value(diff->grad(diff, bias, ones), {1, cols}, -(float) rows);
+
+    op::Operation<float> *prod = op::product(col, bias);
+    check_grad_value(prod->grad(prod, col, ones), {rows, 1}, 3.0f * cols);
+    check_grad_value(prod->grad(prod, bias, ones), {1, cols}, 4.0f * rows);
+
+    op::Operation<float> *quot = op::div(x, col, true, true);
+    check_grad_value(quot->grad(quot, x, ones), {rows, cols}, 1.0f / 4.0f);
+    check_grad_value(quot->grad(quot, col, ones), {rows, 1}, -2.0f * cols / 16.0f);
+
+    /* both sides of x - x are x, and their grads must cancel */
+    op::Operation<float> *zero = op::sub(x, x);
+    check_grad_value(op::add(zero->grad(zero, x, ones), zero->grad(zero, x, ones)), {rows, cols}, 0.0f);
+
+    /* through a grad table the loss is seeded with a scalar. the graph is not pruned, so the
+       variables here must have no other consumers. */
+    op::Variable<float> *w = op::var<float> ("W", {rows, cols}, {CONSTANT, {1.0f}}, mem);
+    op::Variable<float> *b = op::var<float> ("b", {1, cols}, {CONSTANT, {3.0f}}, mem);
+    op::Operation<float> *affine = op::add(w, b);
+
+    op::GradTable<float> table;
+    magmadnn_error_t err = op::get_grad_table({b}, affine, table);
+
+    assert( err == 0 );
+
+    Tensor<float> *res_bias = table.get(b)->eval();
+    sync(res_bias);
+    for (unsigned int i = 0; i < res_bias->get_size(); i++) {
+        assert( fequal(res_bias->get(i), (float) rows) );
+    }
+
+    show_success();
+}
+
+void test_adam(memory_t mem, unsigned int size) {
+    printf("Testing adam on %s...  ", get_memory_type_name(mem));
+
+    /* sizes that are not a multiple of any vector width */
+    unsigned int rows = size, cols = size+3, steps = 3;
+    float learning_rate = 0.01f, beta1 = 0.9f, beta2 = 0.999f, epsilon = 1E-8f;
+
+    /* every instruction set has to follow the same steps */
+    internal::vmath_isa_t isa = internal::vmath_get_isa();
+    for (int v = internal::VMATH_GENERIC; v <= internal::VMATH_AVX512; v++) {
+        if (!internal::vmath_set_isa((internal::vmath_isa_t) v)) continue;
+
+        op::Variable<float> *x = op::var<float> ("X", {rows, cols}, {ZERO, {}}, mem);
+        op::Variable<float> *y = op::var<float> ("y", {1, cols}, {ZERO, {}}, mem);
+        Tensor<float> *x_tensor = x->eval(), *y_tensor = y->eval();
+
+        for (int i = 0; i < (int) rows; i++)
+            for (int j = 0; j < (int) cols; j++)
+                x_tensor->set({i,j}, 0.25f * (i - j));
+        for (int j = 0; j < (int) cols; j++) y_tensor->set({0,j}, 0.5f * j - 1.0f);
+
+        /* the grad of X is 2X and the grad of y, repeated over the rows, is 2 rows y */
+        op::Operation<float> *expr = op::add(op::product(x, x), op::product(y, y));
+
+        optimizer::Adam<float> optim (expr, learning_rate, beta1, beta2, epsilon);
+        for (unsigned int s = 0; s < steps; s++) optim.minimize({x, y});
+        assert( optim.get_n_steps() == steps );
+
+        sync(x_tensor);
+        sync(y_tensor);
+
+        /* the same steps one element at a time */
+        for (int i = 0; i <= (int) rows; i++) {
+            for (int j = 0; j < (int) cols; j++) {
+                bool is_y = (i == (int) rows);
+                double val = (is_y) ? (0.5 * j - 1.0) : (0.25 * (i - j));
+                double m = 0.0, v = 0.0;
+
+                for (unsigned int t = 1; t <= steps; t++) {
+                    double g = (is_y) ? (2.0 * rows * val) : (2.0 * val);
+                    m = beta1 * m + (1.0 - beta1) * g;
+                    v = beta2 * v + (1.0 - beta2) * g * g;
+                    double step = learning_rate * std::sqrt(1.0 - std::pow((double) beta2, t)) / (1.0 - std::pow((double) beta1, t));
+                    val -= step * m / (std::sqrt(v) + epsilon);
+                }
+
+                float actual = (is_y) ? y_tensor->get({0,j}) : x_tensor->get({i,j});
+                assert( std::fabs(actual - val) <= 1E-5 );
+            }
+        }
+    }
+    internal::vmath_set_isa(isa);
+
+    /* each half of the moments may run past the variables, and the second moments start halfway */
+    Tensor<float> var ({5}, {ZERO, {}}, mem), grad ({5}, {CONSTANT, {2.0f}}, mem);
+    Tensor<float> moments ({2, 2, 4}, {ZERO, {}}, mem), short_moments ({2, 2}, {ZERO, {}}, mem);
+    std::vector<Tensor<float> *> vars (1, &var), grads (1, &grad);
+
+    assert( internal::adam_update_internal(vars, grads, &moments, learning_rate, beta1, beta2, epsilon) == 0 );
+    assert( internal::adam_update_internal(vars, grads, &short_moments, learning_rate, beta1, beta2, epsilon) != 0 );
+
+    sync(&moments);
+    for (unsigned int i = 0; i < 8; i++) {
+        float m = (i < 5) ? (1.0f - beta1) * 2.0f : 0.0f;
+        float v = (i < 5) ? (1.0f - beta2) * 4.0f : 0.0f;
+        assert( std::fabs(moments.get(i) - m) <= 1E-6 && std::fabs(moments.get(8 + i) - v) <= 1E-6 );
+    }
+
+    show_success();
+}
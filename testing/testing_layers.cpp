@@ -14,6 +14,7 @@ using namespace magmadnn;
 
 void test_input(memory_t mem, unsigned int size);
 void test_fullyconnected(memory_t mem, unsigned int size);
+void test_fused_fullyconnected(memory_t mem, unsigned int size);
 void test_activation(memory_t mem, unsigned int size);
 void test_layers(memory_t mem, unsigned int size);
 
@@ -24,6 +25,8 @@ int main(int argc, char **argv) {
 
     test_for_all_mem_types(test_fullyconnected, 15);
 
+    test_for_all_mem_types(test_fused_fullyconnected, 15);
+
     test_for_all_mem_types(test_activation, 15);
 
     test_for_all_mem_types(test_layers, 15);
@@ -80,6 +83,78 @@ void test_fullyconnected(memory_t mem, unsigned int size) {
     show_success();
 }
 
+void test_fused_fullyconnected(memory_t mem, unsigned int size) {
+    unsigned int hidden_units = 25;
+    unsigned int n_features = size + 3;
+    layer::activation_t funcs[] = {layer::SIGMOID, layer::TANH, layer::RELU};
+
+    printf("testing %s fused fullyconnected...  ", get_memory_type_name(mem));
+
+    for (unsigned int f = 0; f < 3; f++) {
+        Tensor<float> *data_tensor = new Tensor<float> ({size, n_features}, {UNIFORM, {-1.0f, 1.0f}}, mem);
+        op::Variable<float> *data = op::var("data", data_tensor);
+
+        layer::FullyConnectedLayer<float> *fc = layer::fullyconnected(data, hidden_units, funcs[f]);
+        std::vector<op::Operation<float> *> weights = fc->get_weights();
+        assert( weights.size() == 2 );
+
+        Tensor<float> *w = weights[0]->eval();
+        Tensor<float> *b = weights[1]->eval();
+        Tensor<float> *y = fc->out()->eval();
+        sync(y);
+
+        /* act(xW + b) and its grads with a grad of ones */
+        std::vector<float> dz (size * hidden_units);
+        for (int i = 0; i < (int) size; i++) {
+            for (int j = 0; j < (int) hidden_units; j++) {
+                float z = b->get({0,j});
+                for (int k = 0; k < (int) n_features; k++) z += data_tensor->get({i,k}) * w->get({k,j});
+
+                float expected, d;
+                switch (funcs[f]) {
+                    case layer::SIGMOID: expected = 1.0f / (1.0f + expf(-z)); d = expected * (1.0f - expected); break;
+                    case layer::TANH: expected = tanhf(z); d = 1.0f - expected * expected; break;
+                    default: expected = (z < 0.0f) ? 0.0f : z; d = (z > 0.0f) ? 1.0f : 0.0f; break;
+                }
+                assert( fabs(y->get({i,j}) - expected) <= 1E-5 );
+                dz[i * hidden_units + j] = d;
+            }
+        }
+
+        op::Variable<float> *grad = op::var<float> ("grad", {size, hidden_units}, {CONSTANT, {1.0f}}, mem);
+        Tensor<float> *d_w = fc->out()->grad(NULL, weights[0], grad)->eval();
+        Tensor<float> *d_b = fc->out()->grad(NULL, weights[1], grad)->eval();
+        Tensor<float> *d_x = fc->out()->grad(NULL, data, grad)->eval();
+        sync(d_w);
+        sync(d_b);
+        sync(d_x);
+
+        for (int k = 0; k < (int) n_features; k++) {
+            for (int j = 0; j < (int) hidden_units; j++) {
+                float sum = 0.0f;
+                for (int i = 0; i < (int) size; i++) sum += data_tensor->get({i,k}) * dz[i * hidden_units + j];
+                assert( fabs(d_w->get({k,j}) - sum) <= 1E-4 );
+            }
+        }
+        for (int j = 0; j < (int) hidden_units; j++) {
+            float sum = 0.0f;
+            for (int i = 0; i < (int) size; i++) sum += dz[i * hidden_units + j];
+            assert( fabs(d_b->get({0,j}) - sum) <= 1E-4 );
+        }
+        for (int i = 0; i < (int) size; i++) {
+            for (int k = 0; k < (int) n_features; k++) {
+                float sum = 0.0f;
+                for (int j = 0; j < (int) hidden_units; j++) sum += dz[i * hidden_units + j] * w->get({k,j});
+                assert( fabs(d_x->get({i,k}) - sum) <= 1E-4 );
+            }
+        }
+
+        delete data_tensor;
+    }
+
+    show_success();
+}
+
 void test_activation(memory_t mem, unsigned int size) {
     float val = 2.3f;
 
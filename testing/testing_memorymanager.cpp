@@ -4,6 +4,9 @@
 
 #include <stdio.h>
 #include <assert.h>
+#include <stdint.h>
+#include <thread>
+#include <vector>
 #include "magmadnn.h"
 #include "utilities.h"
 
@@ -59,6 +62,155 @@ void test_copy(memory_t src_mem, memory_t dst_mem, int size, bool verbose) {
 }
 
 
+void test_host_allocator(bool verbose) {
+	if (verbose) printf("Testing host allocator...  ");
+
+	HostAllocator *alloc = new HostAllocator (1 << 30);
+	host_allocator_stats_t stats;
+
+	// size classes
+	assert( HostAllocator::get_block_size(1) == 64 );
+	assert( HostAllocator::get_block_size(65) == 80 );
+	assert( HostAllocator::get_block_size(129) == 160 );
+	assert( HostAllocator::get_block_size(1000) == 1024 );
+	assert( HostAllocator::get_block_size(1025) == 1280 );
+
+	// blocks are aligned and usable
+	std::vector<void *> blocks;
+	for (size_t bytes = 1; bytes < (8 << 20); bytes = bytes * 3 + 1) {
+		char *ptr = (char *) alloc->allocate(bytes);
+		assert( ((uintptr_t) ptr) % HOST_ALLOCATOR_ALIGNMENT == 0 );
+		for (size_t i = 0; i < bytes; i++) ptr[i] = (char) i;
+		blocks.push_back(ptr);
+	}
+	stats = alloc->get_stats();
+	assert( stats.n_cache_hits == 0 && stats.bytes_cached == 0 );
+	assert( stats.bytes_in_use == stats.peak_bytes_in_use );
+
+	// freed blocks are reused, small ones from the thread's lists and big ones from the shared pool
+	for (unsigned int i = 0; i < blocks.size(); i++) alloc->deallocate(blocks[i]);
+	stats = alloc->get_stats();
+	assert( stats.bytes_in_use == 0 && stats.bytes_cached == stats.peak_bytes_in_use );
+
+	void *small = alloc->allocate(380), *big = alloc->allocate(7 << 20);
+	assert( small == blocks[5] );	// the 364 byte block, which was rounded up to 384
+	assert( big == blocks.back() );	// the 7174453 byte block, rounded up to 7 MiB
+	stats = alloc->get_stats();
+	assert( stats.n_cache_hits == 2 );
+	alloc->deallocate(small);
+	alloc->deallocate(big);
+
+	// blocks freed by another thread are reused too
+	void *other = NULL;
+	std::thread t ([&]() { other = alloc->allocate(333); });
+	t.join();
+	alloc->deallocate(other);
+	assert( alloc->allocate(333) == other );
+	alloc->deallocate(other);
+
+	// threads allocating and freeing at once
+	std::vector<std::thread> threads;
+	for (unsigned int k = 0; k < 4; k++) {
+		threads.push_back(std::thread([alloc, k]() {
+			std::vector<int *> live;
+			for (unsigned int i = 0; i < 20000; i++) {
+				unsigned int n = 1 + (i * 7919 + k * 104729) % 5000;
+				int *p = (int *) alloc->allocate(n * sizeof(int));
+				p[0] = p[n-1] = (int) n;
+				live.push_back(p);
+				if (live.size() > 16) {
+					int *q = live[i % live.size()];
+					live.erase(live.begin() + (i % live.size()));
+					alloc->deallocate(q);
+				}
+			}
+			for (unsigned int i = 0; i < live.size(); i++) alloc->deallocate(live[i]);
+		}));
+	}
+	for (unsigned int k = 0; k < threads.size(); k++) threads[k].join();
+
+	stats = alloc->get_stats();
+	assert( stats.bytes_in_use == 0 );
+	assert( stats.hit_rate > 0.9 );
+
+	// release on demand
+	alloc->release();
+	assert( alloc->get_stats().bytes_cached == 0 );
+
+	// no caching
+	alloc->set_max_cached_bytes(0);
+	alloc->reset_stats();
+	alloc->deallocate(alloc->allocate(100));
+	alloc->deallocate(alloc->allocate(100));
+	stats = alloc->get_stats();
+	assert( stats.n_allocations == 2 && stats.n_cache_hits == 0 && stats.bytes_cached == 0 );
+
+	delete alloc;
+
+	// memory managers use the default allocator
+	MemoryManager<double> *mm = new MemoryManager<double> (1001, HOST, (device_t) 0);
+	assert( ((uintptr_t) mm->get_host_ptr()) % HOST_ALLOCATOR_ALIGNMENT == 0 );
+	assert( get_default_host_allocator()->get_stats().bytes_in_use >= 1001 * sizeof(double) );
+	delete mm;
+
+	if (verbose) show_success();
+}
+
+void test_huge_pages(bool verbose) {
+	if (verbose) printf("Testing huge page allocations...  ");
+
+	HostAllocator *alloc = new HostAllocator (1 << 30);
+	host_allocator_stats_t stats;
+	const size_t big = 3 << 20;
+
+	// small blocks are never mapped
+	alloc->set_huge_pages(HUGE_PAGES_TRANSPARENT, 1 << 20);
+	alloc->deallocate(alloc->allocate(1000));
+	assert( alloc->get_stats().bytes_huge_pages == 0 );
+
+	// explicit huge pages fall back to transparent ones when none are reserved
+	for (int mode = HUGE_PAGES_TRANSPARENT; mode <= HUGE_PAGES_EXPLICIT; mode++) {
+		alloc->set_huge_pages((host_huge_pages_t) mode, 1 << 20);
+
+		char *ptr = (char *) alloc->allocate(big);
+		assert( ptr != NULL && get_alignment(ptr) >= HOST_ALLOCATOR_ALIGNMENT );
+		#if defined(__linux__)
+		assert( is_aligned(ptr - HOST_ALLOCATOR_ALIGNMENT, HOST_ALLOCATOR_HUGE_PAGE_SIZE) );
+		assert( alloc->get_stats().bytes_huge_pages >= big );
+		#endif
+
+		for (size_t i = 0; i < big; i += 4096) ptr[i] = (char) i;
+		ptr[big - 1] = 1;
+
+		// cached like any other block
+		alloc->deallocate(ptr);
+		assert( alloc->allocate(big) == ptr );
+		alloc->deallocate(ptr);
+
+		alloc->release();
+		stats = alloc->get_stats();
+		assert( stats.bytes_cached == 0 && stats.bytes_huge_pages == 0 );
+	}
+
+	// a threshold of 0 turns them off
+	alloc->set_huge_pages(HUGE_PAGES_TRANSPARENT, 0);
+	alloc->deallocate(alloc->allocate(big));
+	assert( alloc->get_stats().bytes_huge_pages == 0 );
+
+	delete alloc;
+
+	// tensors report their alignment, slices may lose it
+	Tensor<float> *t = new Tensor<float> ({100, 100}, {NONE, {}}, HOST);
+	assert( t->get_alignment() >= HOST_ALLOCATOR_ALIGNMENT );
+	Tensor<float> *s = t->slice(1, 2);
+	assert( s->get_alignment() == 16 );    // 400 bytes in
+	delete s;
+	delete t;
+
+	if (verbose) show_success();
+}
+
+
 int main(int argc, char** argv) {
 	magmadnn_init();
 
@@ -102,6 +254,9 @@ int main(int argc, char** argv) {
 	test_copy(CUDA_MANAGED, CUDA_MANAGED, test_size, true);
 	#endif
 
+	test_host_allocator(true);
+	test_huge_pages(true);
+
 	magmadnn_finalize();
     return 0;
 }
@@ -7,7 +7,9 @@
  * @copyright Copyright (c) 2019
  */
 
+#include <cmath>
 #include <cstdio>
+#include <algorithm>
 #include <vector>
 #include "magmadnn.h"
 #include "utilities.h"
@@ -17,12 +19,24 @@ using namespace magmadnn;
 
 
 void test_model_MLP(memory_t mem, unsigned int size);
+void test_model_minibatch(memory_t mem, unsigned int size);
+void test_dataloader(memory_t mem, unsigned int size);
+void test_model_dataloader(memory_t mem, unsigned int size);
+void test_model_predict(memory_t mem, unsigned int size);
+void test_model_freeze(memory_t mem, unsigned int size);
+void test_model_adam(memory_t mem, unsigned int size);
 
 
 int main(int argc, char **argv) {
     magmadnn_init();
 
     test_for_all_mem_types(test_model_MLP, 50);
+    test_for_all_mem_types(test_model_minibatch, 10);
+    test_for_all_mem_types(test_dataloader, 8);
+    test_for_all_mem_types(test_model_dataloader, 10);
+    test_for_all_mem_types(test_model_predict, 10);
+    test_for_all_mem_types(test_model_freeze, 10);
+    test_for_all_mem_types(test_model_adam, 10);
 
     magmadnn_finalize();
     return 0;
@@ -59,4 +73,373 @@ void test_model_MLP(memory_t mem, unsigned int size) {
     printf("loss: %.5g\n", metrics.loss);
 
     show_success();
-}
\ No newline at end of file
+}
+
+void test_model_minibatch(memory_t mem, unsigned int size) {
+    unsigned int n_features = 6;
+    unsigned int n_classes = 3;
+    unsigned int n_samples = 5*size + 3;
+    model::metric_t metrics;
+
+    printf("testing %s mini-batch fit...  ", get_memory_type_name(mem));
+
+    /* the class of each sample is given by which feature is largest */
+    Tensor<float> x ({n_samples, n_features}, {ZERO, {}}, mem);
+    Tensor<float> y ({n_samples, n_classes}, {ZERO, {}}, mem);
+    for (int i = 0; i < (int) n_samples; i++) {
+        x.set({i, i % (int) n_classes}, 1.0f);
+        y.set({i, i % (int) n_classes}, 1.0f);
+    }
+
+    /* the network is built for one mini-batch; fit points it at slices of x */
+    auto var = op::var<float>("x", {size, n_features}, {ZERO, {}}, mem);
+    Tensor<float> *input_tensor = var->get_return_ptr();
+
+    auto input = layer::input<float>(var);
+    auto fc1 = layer::fullyconnected<float>(input->out(), n_classes, true);
+    auto act1 = layer::activation<float>(fc1->out(), layer::SIGMOID);
+    auto output = layer::output<float>(act1->out());
+
+    std::vector<layer::Layer<float> *> layers = {input, fc1, act1, output};
+
+    model::nn_params_t p;
+    p.n_epochs = 3;
+    p.batch_size = size;
+    p.shuffle = true;
+    model::NeuralNetwork<float> model (layers, optimizer::CROSS_ENTROPY, optimizer::SGD, p);
+
+    magmadnn_error_t err = model.fit(&x, &y, metrics);
+
+    assert( err == 0 );
+    assert( metrics.steps_per_epoch == 5 );
+    assert( metrics.samples_per_second > 0.0 );
+    assert( metrics.accuracy >= 0.0 && metrics.accuracy <= 1.0 );
+    assert( model.get_loss() == metrics.loss );
+
+    /* the input layer has its own tensor back and x is untouched */
+    assert( var->get_return_ptr() == input_tensor );
+    assert( input_tensor->get_shape(0) == size );
+    assert( !input_tensor->is_view() );
+    sync(&x);
+    for (int i = 0; i < (int) n_samples; i++) {
+        assert( x.get({i, i % (int) n_classes}) == 1.0f );
+    }
+
+    /* a batch size the input layer was not built for is refused */
+    p.batch_size = size + 1;
+    model::NeuralNetwork<float> bad_model (layers, optimizer::CROSS_ENTROPY, optimizer::SGD, p);
+    assert( bad_model.fit(&x, &y, metrics) != 0 );
+
+    show_success();
+}
+
+void test_dataloader(memory_t mem, unsigned int size) {
+    unsigned int n_features = 4;
+    unsigned int n_samples = 3*size + 2;
+    unsigned int n_epochs = 3;
+
+    printf("testing %s data loader...  ", get_memory_type_name(mem));
+
+    /* int samples are converted to float. feature j of sample i is i*n_features + j, and its label
+       is i, so every row can be traced back to the sample it came from. */
+    Tensor<int> x ({n_samples, n_features}, {NONE, {}}, HOST);
+    Tensor<int> y ({n_samples, 1}, {NONE, {}}, HOST);
+    for (int i = 0; i < (int) n_samples; i++) {
+        for (int j = 0; j < (int) n_features; j++) x.set({i,j}, i * (int) n_features + j);
+        y.set({i,0}, i);
+    }
+
+    data::dataloader_params_t params;
+    params.batch_size = size;
+    params.shuffle = true;
+    params.mean = {1.0};
+    params.stddev = {2.0};
+    data::DataLoader<float> loader (&x, &y, params, mem);
+
+    assert( loader.get_n_batches() == 3 );
+    assert( loader.get_x_shape() == std::vector<unsigned int>({size, n_features}) );
+
+    Tensor<float> *x_batch, *y_batch, *last_x_batch = NULL;
+    for (unsigned int epoch = 0; epoch < n_epochs; epoch++) {
+        std::vector<bool> seen (n_samples, false);
+
+        for (unsigned int b = 0; b < loader.get_n_batches(); b++) {
+            loader.next(x_batch, y_batch);
+            sync(x_batch);
+            sync(y_batch);
+
+            /* the two buffers take turns */
+            assert( x_batch != last_x_batch );
+            last_x_batch = x_batch;
+
+            for (int i = 0; i < (int) size; i++) {
+                int sample = (int) y_batch->get({i,0});
+                assert( sample >= 0 && sample < (int) n_samples && !seen[sample] );
+                seen[sample] = true;
+
+                for (int j = 0; j < (int) n_features; j++) {
+                    assert( fequal(x_batch->get({i,j}), (sample * (int) n_features + j - 1.0f) / 2.0f) );
+                }
+            }
+        }
+
+        /* each epoch sees 3*size different samples */
+        assert( std::count(seen.begin(), seen.end(), true) == (long) (3*size) );
+    }
+
+    show_success();
+}
+
+void test_model_dataloader(memory_t mem, unsigned int size) {
+    unsigned int n_features = 6;
+    unsigned int n_classes = 3;
+    unsigned int n_samples = 4*size;
+    model::metric_t metrics;
+
+    printf("testing %s fit with a data loader...  ", get_memory_type_name(mem));
+
+    Tensor<double> x ({n_samples, n_features}, {ZERO, {}}, HOST);
+    Tensor<double> y ({n_samples, n_classes}, {ZERO, {}}, HOST);
+    for (int i = 0; i < (int) n_samples; i++) {
+        x.set({i, i % (int) n_classes}, 1.0);
+        y.set({i, i % (int) n_classes}, 1.0);
+    }
+
+    data::dataloader_params_t params;
+    params.batch_size = size;
+    params.shuffle = true;
+    data::DataLoader<float> loader (&x, &y, params, mem);
+
+    auto var = op::var<float>("x", {size, n_features}, {ZERO, {}}, mem);
+    Tensor<float> *input_tensor = var->get_return_ptr();
+
+    auto input = layer::input<float>(var);
+    auto fc1 = layer::fullyconnected<float>(input->out(), n_classes, true);
+    auto act1 = layer::activation<float>(fc1->out(), layer::SIGMOID);
+    auto output = layer::output<float>(act1->out());
+
+    std::vector<layer::Layer<float> *> layers = {input, fc1, act1, output};
+
+    model::nn_params_t p;
+    p.n_epochs = 3;
+    p.batch_size = size;
+    model::NeuralNetwork<float> model (layers, optimizer::CROSS_ENTROPY, optimizer::SGD, p);
+
+    magmadnn_error_t err = model.fit(&loader, metrics);
+
+    assert( err == 0 );
+    assert( metrics.steps_per_epoch == 4 );
+    assert( metrics.samples_per_second > 0.0 );
+    assert( var->get_return_ptr() == input_tensor && !input_tensor->is_view() );
+
+    show_success();
+}
+
+void test_model_predict(memory_t mem, unsigned int size) {
+    unsigned int n_features = 5;
+    unsigned int n_classes = 4;
+    unsigned int n_samples = 3*size;
+    model::metric_t metrics;
+
+    printf("testing %s predict...  ", get_memory_type_name(mem));
+
+    Tensor<float> x ({n_samples, n_features}, {UNIFORM, {-1.0f, 1.0f}}, mem);
+    Tensor<float> y ({n_samples, n_classes}, {ZERO, {}}, mem);
+    for (int i = 0; i < (int) n_samples; i++) y.set({i, i % (int) n_classes}, 1.0f);
+
+    auto var = op::var<float>("x", {size, n_features}, {ZERO, {}}, mem);
+
+    auto input = layer::input<float>(var);
+    auto fc1 = layer::fullyconnected<float>(input->out(), 8, true);
+    auto act1 = layer::activation<float>(fc1->out(), layer::SIGMOID);
+    auto fc2 = layer::fullyconnected<float>(act1->out(), n_classes, layer::SIGMOID, true);
+    auto output = layer::output<float>(fc2->out());
+
+    std::vector<layer::Layer<float> *> layers = {input, fc1, act1, fc2, output};
+
+    model::nn_params_t p;
+    p.n_epochs = 2;
+    p.batch_size = size;
+    model::NeuralNetwork<float> model (layers, optimizer::CROSS_ENTROPY, optimizer::SGD, p);
+
+    assert( model.fit(&x, &y, metrics) == 0 );
+
+    /* the whole data set at once */
+    Tensor<float> *all = model.predict(&x);
+    assert( all != NULL );
+    assert( all->get_shape() == std::vector<unsigned int>({n_samples, n_classes}) );
+    sync(all);
+
+    std::vector<float> expected (all->get_size());
+    for (size_t i = 0; i < all->get_size(); i++) expected[i] = all->get(i);
+
+    /* the same samples a few rows at a time and one at a time. the kernels may block a different
+       number of rows differently, so the results can differ in the last bits. */
+    for (unsigned int begin = 0; begin < n_samples; begin += 7) {
+        unsigned int end = std::min(begin + 7, n_samples);
+        Tensor<float> *rows = x.slice(begin, end);
+        Tensor<float> *out = model.predict(rows);
+        sync(out);
+
+        assert( out->get_shape(0) == end - begin );
+        for (size_t i = 0; i < out->get_size(); i++) {
+            assert( fabs(out->get(i) - expected[begin * n_classes + i]) <= 1E-5 );
+        }
+        delete rows;
+    }
+
+    std::vector<unsigned int> classes;
+    assert( model.predict_classes(&x, classes) == 0 );
+    assert( classes.size() == n_samples );
+
+    for (unsigned int i = 0; i < n_samples; i++) {
+        Tensor<float> *row = x.slice(i, i+1);
+        Tensor<float> *sample = row->reshape({n_features});
+
+        Tensor<float> *out = model.predict(sample);
+        sync(out);
+        for (unsigned int j = 0; j < n_classes; j++) {
+            assert( fabs(out->get(j) - expected[i * n_classes + j]) <= 1E-5 );
+        }
+        assert( model.predict_class(sample) == classes[i] );
+
+        delete sample;
+        delete row;
+    }
+
+    /* samples of the wrong shape are refused */
+    Tensor<float> bad ({2, n_features+1}, {ZERO, {}}, mem);
+    assert( model.predict(&bad) == NULL );
+
+    /* inference adds nothing to the training graph */
+    std::vector<op::Operation<float> *> weights = fc1->get_weights();
+    assert( weights[0]->get_consumers().size() == 1 && weights[1]->get_consumers().size() == 1 );
+
+    show_success();
+}
+
+void test_model_freeze(memory_t mem, unsigned int size) {
+    unsigned int n_features = 5;
+    unsigned int n_classes = 4;
+    unsigned int n_samples = 3*size;
+    model::metric_t metrics;
+
+    printf("testing %s freeze...  ", get_memory_type_name(mem));
+
+    Tensor<float> x ({n_samples, n_features}, {UNIFORM, {-1.0f, 1.0f}}, mem);
+    Tensor<float> y ({n_samples, n_classes}, {ZERO, {}}, mem);
+    for (int i = 0; i < (int) n_samples; i++) y.set({i, i % (int) n_classes}, 1.0f);
+
+    auto var = op::var<float>("x", {size, n_features}, {ZERO, {}}, mem);
+
+    /* fc1 and fc2 fold into one stage, which takes act1; fc3 is already fused */
+    auto input = layer::input<float>(var);
+    auto fc1 = layer::fullyconnected<float>(input->out(), 8, true);
+    auto fc2 = layer::fullyconnected<float>(fc1->out(), 6, true);
+    auto act1 = layer::activation<float>(fc2->out(), layer::SIGMOID);
+    auto fc3 = layer::fullyconnected<float>(act1->out(), n_classes, layer::SIGMOID, true);
+    auto output = layer::output<float>(fc3->out());
+
+    std::vector<layer::Layer<float> *> layers = {input, fc1, fc2, act1, fc3, output};
+
+    model::nn_params_t p;
+    p.n_epochs = 2;
+    p.batch_size = size;
+    model::NeuralNetwork<float> model (layers, optimizer::CROSS_ENTROPY, optimizer::SGD, p);
+
+    assert( model.fit(&x, &y, metrics) == 0 );
+
+    model::FrozenNetwork<float> *frozen = model.freeze();
+    assert( frozen->get_n_stages() == 2 );
+
+    Tensor<float> *expected_out = model.predict(&x);
+    sync(expected_out);
+    std::vector<float> expected (expected_out->get_size());
+    for (size_t i = 0; i < expected_out->get_size(); i++) expected[i] = expected_out->get(i);
+
+    /* folding reorders the arithmetic, so the results can differ in the last bits */
+    Tensor<float> *out = frozen->predict(&x);
+    assert( out != NULL );
+    assert( out->get_shape() == std::vector<unsigned int>({n_samples, n_classes}) );
+    sync(out);
+    for (size_t i = 0; i < out->get_size(); i++) assert( fabs(out->get(i) - expected[i]) <= 1E-5 );
+
+    std::vector<unsigned int> model_classes, frozen_classes;
+    assert( model.predict_classes(&x, model_classes) == 0 );
+    assert( frozen->predict_classes(&x, frozen_classes) == 0 );
+    for (unsigned int i = 0; i < n_samples; i++) {
+        if (model_classes[i] != frozen_classes[i]) {
+            /* only a near tie may go either way */
+            assert( fabs(expected[i * n_classes + model_classes[i]] - expected[i * n_classes + frozen_classes[i]]) <= 1E-5 );
+        }
+    }
+
+    Tensor<float> *row = x.slice(0, 1);
+    Tensor<float> *sample = row->reshape({n_features});
+    assert( frozen->predict_class(sample) == frozen_classes[0] );
+    delete sample;
+    delete row;
+
+    /* the frozen network has its own weights */
+    Tensor<float> zeros (fc3->get_weights_tensor()->get_shape(), {ZERO, {}}, mem);
+    fc3->get_weights_tensor()->copy_from(zeros);
+    out = frozen->predict(&x);
+    sync(out);
+    for (size_t i = 0; i < out->get_size(); i++) assert( fabs(out->get(i) - expected[i]) <= 1E-5 );
+
+    Tensor<float> bad ({2, n_features+1}, {ZERO, {}}, mem);
+    assert( frozen->predict(&bad) == NULL );
+
+    delete frozen;
+
+    /* freezing adds nothing to the training graph */
+    std::vector<op::Operation<float> *> weights = fc1->get_weights();
+    assert( weights[0]->get_consumers().size() == 1 && weights[1]->get_consumers().size() == 1 );
+
+    show_success();
+}
+
+void test_model_adam(memory_t mem, unsigned int size) {
+    unsigned int n_features = 6;
+    unsigned int n_classes = 3;
+    unsigned int n_samples = 4*size;
+    model::metric_t metrics;
+
+    printf("testing %s adam fit...  ", get_memory_type_name(mem));
+
+    Tensor<float> x ({n_samples, n_features}, {ZERO, {}}, mem);
+    Tensor<float> y ({n_samples, n_classes}, {ZERO, {}}, mem);
+    for (int i = 0; i < (int) n_samples; i++) {
+        x.set({i, i % (int) n_classes}, 1.0f);
+        y.set({i, i % (int) n_classes}, 1.0f);
+    }
+
+    auto var = op::var<float>("x", {size, n_features}, {ZERO, {}}, mem);
+
+    auto input = layer::input<float>(var);
+    auto fc1 = layer::fullyconnected<float>(input->out(), 8, layer::SIGMOID, true);
+    auto fc2 = layer::fullyconnected<float>(fc1->out(), n_classes, layer::SIGMOID, true);
+    auto output = layer::output<float>(fc2->out());
+
+    std::vector<layer::Layer<float> *> layers = {input, fc1, fc2, output};
+
+    model::nn_params_t p;
+    p.n_epochs = 3;
+    p.batch_size = size;
+    model::NeuralNetwork<float> model (layers, optimizer::CROSS_ENTROPY, optimizer::ADAM, p);
+
+    Tensor<float> *bias = fc2->get_bias_tensor();
+    sync(bias);
+    std::vector<float> bias_before (bias->get_size());
+    for (size_t i = 0; i < bias->get_size(); i++) bias_before[i] = bias->get(i);
+
+    assert( model.fit(&x, &y, metrics) == 0 );
+    assert( metrics.steps_per_epoch == 4 );
+    assert( std::isfinite(metrics.loss) );
+
+    /* every parameter moves, including the broadcast bias */
+    sync(bias);
+    for (size_t i = 0; i < bias->get_size(); i++) assert( bias->get(i) != bias_before[i] );
+
+    show_success();
+}
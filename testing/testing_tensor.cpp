@@ -1,3 +1,4 @@
+#include <unistd.h>
 #include "magmadnn.h"
 #include "utilities.h"
 
@@ -5,6 +6,10 @@ using namespace magmadnn;
 
 void test_indexing(memory_t mem, bool verbose);
 void test_fill(tensor_filler_t<float> filler, memory_t mem, bool verbose);
+void test_views(memory_t mem, bool verbose);
+void test_move_and_share(memory_t mem, bool verbose);
+void test_large_tensor(memory_t mem, bool verbose);
+void test_recycled_identity(memory_t mem, bool verbose);
 
 int main(int argc, char **argv) {
 	magmadnn_init();
@@ -24,6 +29,29 @@ int main(int argc, char **argv) {
 	test_fill({CONSTANT, {0.5}}, CUDA_MANAGED, true);
 	#endif
 
+	test_views(HOST, true);
+	#if defined(_HAS_CUDA_)
+	test_views(DEVICE, true);
+	test_views(MANAGED, true);
+	test_views(CUDA_MANAGED, true);
+	#endif
+
+	test_move_and_share(HOST, true);
+	#if defined(_HAS_CUDA_)
+	test_move_and_share(DEVICE, true);
+	test_move_and_share(MANAGED, true);
+	test_move_and_share(CUDA_MANAGED, true);
+	#endif
+
+	test_recycled_identity(HOST, true);
+	#if defined(_HAS_CUDA_)
+	test_recycled_identity(DEVICE, true);
+	test_recycled_identity(MANAGED, true);
+	test_recycled_identity(CUDA_MANAGED, true);
+	#endif
+
+	test_large_tensor(HOST, true);
+
 	magmadnn_finalize();
     return 0;
 }
@@ -69,3 +97,195 @@ void test_fill(tensor_filler_t<float> filler, memory_t mem, bool verbose) {
 }
 
 
+void test_recycled_identity(memory_t mem, bool verbose) {
+	unsigned int size = 512;
+
+	if (verbose) printf("Testing IDENTITY on a recycled block on %s...  ", get_memory_type_name(mem));
+
+	/* the allocator hands this block straight back to the identity */
+	Tensor<float> *c = new Tensor<float> ({size, size}, {CONSTANT, {5.0f}}, mem);
+	delete c;
+
+	Tensor<float> *id = new Tensor<float> ({size, size}, {IDENTITY, {}}, mem);
+	sync(id);
+
+	for (int i = 0; i < (int) size; i++) {
+		for (int j = 0; j < (int) size; j++) {
+			assert( id->get({i,j}) == ((i == j) ? 1.0f : 0.0f) );
+		}
+	}
+	delete id;
+
+	Tensor<float> *d = new Tensor<float> ({size, size}, {DIAGONAL, {2.0f}}, mem);
+	sync(d);
+	assert( d->get({0,0}) == 2.0f && d->get({0,1}) == 0.0f && d->get({(int) size-1, (int) size-2}) == 0.0f );
+	delete d;
+
+	if (verbose) show_success();
+}
+
+void test_views(memory_t mem, bool verbose) {
+	unsigned int x_size = 6, y_size = 5, z_size = 4;
+
+	if (verbose) printf("Testing views on %s...  ", get_memory_type_name(mem));
+
+	Tensor<float> *t = new Tensor<float> ({x_size, y_size, z_size}, {NONE, {}}, mem);
+	for (unsigned int i = 0; i < t->get_size(); i++) t->set(i, (float) i);
+
+	/* a slice of axis 0 is contiguous and starts at its first row */
+	Tensor<float> *rows = t->slice(2, 5);
+	assert( rows->is_view() && rows->is_contiguous() );
+	assert( rows->get_shape(0) == 3 && rows->get_size() == 3 * y_size * z_size );
+	assert( rows->get_offset() == 2 * y_size * z_size );
+	for (unsigned int i = 0; i < rows->get_size(); i++) assert( rows->get(i) == (float) (2 * y_size * z_size + i) );
+
+	/* writes through a view show up in the tensor */
+	rows->set({0, 1, 2}, -1.0f);
+	assert( t->get({2, 1, 2}) == -1.0f );
+	rows->set({0, 1, 2}, (float) (2 * y_size * z_size + 1 * z_size + 2));
+
+	/* reshape of a contiguous view */
+	Tensor<float> *flat = rows->reshape({3 * y_size, z_size});
+	assert( flat->is_contiguous() && flat->get({4, 3}) == rows->get({0, 4, 3}) );
+
+	/* permute only changes the strides */
+	Tensor<float> *perm = t->permute({2, 0, 1});
+	assert( !perm->is_contiguous() );
+	assert( perm->get_shape(0) == z_size && perm->get_shape(1) == x_size && perm->get_shape(2) == y_size );
+	for (int i = 0; i < (int) z_size; i++)
+		for (int j = 0; j < (int) x_size; j++)
+			for (int k = 0; k < (int) y_size; k++)
+				assert( perm->get({i, j, k}) == t->get({j, k, i}) );
+
+	/* copying a view gathers it in row-major order */
+	Tensor<float> *gathered = new Tensor<float> (perm->get_shape(), {NONE, {}}, mem);
+	gathered->copy_from(*perm);
+	for (unsigned int i = 0; i < gathered->get_size(); i++) assert( gathered->get(i) == perm->get(i) );
+
+	/* a view of a view, and a transpose of a slice */
+	Tensor<float> *sub = perm->slice(1, 3);
+	assert( sub->get({1, 2, 3}) == t->get({2, 3, 2}) );
+
+	Tensor<float> *mat = t->reshape({x_size, y_size * z_size});
+	Tensor<float> *mat_rows = mat->slice(1, 4);
+	Tensor<float> *mat_t = mat_rows->transpose();
+	assert( mat_t->get_shape(0) == y_size * z_size && mat_t->get_shape(1) == 3 );
+	assert( mat_t->get({7, 2}) == mat->get({3, 7}) );
+
+	/* copy_from a range of a bigger tensor */
+	Tensor<float> *part = new Tensor<float> ({2, z_size}, {ZERO, {}}, mem);
+	part->copy_from(*t, 3 * z_size, 2 * z_size);
+	for (unsigned int i = 0; i < part->get_size(); i++) assert( part->get(i) == (float) (3 * z_size + i) );
+
+	delete part;
+	delete mat_t;
+	delete mat_rows;
+	delete mat;
+	delete sub;
+	delete gathered;
+	delete perm;
+	delete flat;
+	delete rows;
+	delete t;
+
+	if (verbose) show_success();
+}
+
+Tensor<float> make_iota(unsigned int n, memory_t mem) {
+	Tensor<float> t ({n}, {NONE, {}}, mem);
+	for (unsigned int i = 0; i < n; i++) t.set(i, (float) i);
+	return t;
+}
+
+void test_move_and_share(memory_t mem, bool verbose) {
+	unsigned int size = 100;
+
+	if (verbose) printf("Testing move and share on %s...  ", get_memory_type_name(mem));
+
+	/* returned by value, the memory moves with it */
+	Tensor<float> a = make_iota(size, mem);
+	MemoryManager<float> *a_mem = a.get_memory_manager();
+	assert( a.get_size() == size && a.get(size-1) == (float) (size-1) );
+	assert( a.get_use_count() == 1 );
+
+	Tensor<float> b (std::move(a));
+	assert( b.get_memory_manager() == a_mem && a.get_size() == 0 && a.get_memory_manager() == NULL );
+
+	/* move assignment drops the old memory */
+	Tensor<float> c ({3}, {ZERO, {}}, mem);
+	c = std::move(b);
+	assert( c.get_memory_manager() == a_mem && c.get(7) == 7.0f && b.get_size() == 0 );
+
+	/* containers hold tensors directly */
+	std::vector<Tensor<float> > tensors;
+	for (unsigned int i = 0; i < 10; i++) tensors.push_back(make_iota(size + i, mem));
+	for (unsigned int i = 0; i < 10; i++) assert( tensors[i].get_size() == size + i && tensors[i].get(i) == (float) i );
+
+	/* shares see the same memory and keep it alive */
+	Tensor<float> *d = new Tensor<float> (c.share());
+	assert( c.get_use_count() == 2 && d->get_memory_manager() == a_mem );
+	d->set(5, -1.0f);
+	assert( c.get(5) == -1.0f );
+
+	Tensor<float> *rows = d->slice(10, 20);
+	assert( c.get_use_count() == 3 );
+	delete d;
+	assert( rows->get(0) == 10.0f );
+
+	c = make_iota(4, mem);
+	assert( rows->get_use_count() == 1 && rows->get(9) == 19.0f );
+	delete rows;
+
+	/* memory managers move too */
+	MemoryManager<float> m1 (size, mem, (device_t) 0);
+	float *ptr = m1.get_ptr();
+	MemoryManager<float> m2 (std::move(m1));
+	assert( m2.get_ptr() == ptr && m2.get_size() == size && m1.get_size() == 0 );
+
+	if (verbose) show_success();
+}
+
+void test_large_tensor(memory_t mem, bool verbose) {
+	const unsigned int side = 65537;
+	const size_t n = (size_t) side * side;     /* just over 2^32 elements */
+	const size_t big_idx = ((size_t) 1 << 32) + 5;
+
+	if (verbose) printf("Testing tensors of more than 2^32 elements on %s...  ", get_memory_type_name(mem));
+
+	/* ranges past 2^32 are split without wrapping */
+	std::atomic<size_t> visited (0);
+	parallel::parallel_for(big_idx, big_idx + 1000, 10, [&visited, big_idx](size_t begin, size_t end) {
+		assert( begin >= big_idx && end <= big_idx + 1000 );
+		visited += end - begin;
+	});
+	assert( visited == 1000 );
+
+	/* the tensor itself needs 16 GiB, with room to spare */
+	size_t phys_bytes = (size_t) sysconf(_SC_PHYS_PAGES) * (size_t) sysconf(_SC_PAGE_SIZE);
+	if (phys_bytes < n * sizeof(float) + (n * sizeof(float)) / 4) {
+		if (verbose) printf("skipped (%zu MiB of memory)\n", phys_bytes >> 20);
+		return;
+	}
+
+	op::Variable<float> *x = op::var<float>("x", {side, side}, {CONSTANT, {1.0f}}, mem);
+	Tensor<float> *x_tensor = x->eval();
+	assert( x_tensor->get_size() == n && x->get_output_size() == n );
+
+	/* indices above 2^32 do not wrap onto the start */
+	x_tensor->set(big_idx, 3.0f);
+	assert( x_tensor->get(big_idx) == 3.0f && x_tensor->get(5) == 1.0f );
+	assert( x_tensor->get({side-1, side-1}) == 1.0f );
+
+	/* the last rows start past 2^32 */
+	Tensor<float> *last_rows = x_tensor->slice(side - 2, side);
+	assert( last_rows->get_size() == 2 * (size_t) side && last_rows->get(0) == 1.0f );
+	delete last_rows;
+
+	op::Operation<float> *sum = op::reducesum(x, {0, 1}, internal::REDUCE_SUM_KAHAN, true, false);
+	float total = sum->eval()->get(0);
+	assert( fabs(total - (float) (n + 2)) <= 1e-6 * n );
+
+	delete sum;
+
+	if (verbose) show_success();
+}
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <cstring>
 #include "magmadnn.h"
 
 #define ANSI_COLOR_RED     "\x1b[31m"